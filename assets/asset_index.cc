@@ -0,0 +1,226 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_index.h"
+
+#include <cstring>
+#include <limits>
+#include <regex>
+#include <unordered_set>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if !OS_WIN && !OS_FUCHSIA
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace flutter {
+
+namespace {
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t flags;
+  uint32_t reserved;
+};
+
+struct SerializedEntry {
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint32_t name_offset;
+  uint32_t name_size;
+  uint32_t flags;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 24, "The header must be packed.");
+static_assert(sizeof(SerializedEntry) == 32, "Entries must be packed.");
+
+bool IsInRange(uint64_t offset, uint64_t size, size_t mapping_size) {
+  return offset <= mapping_size && size <= mapping_size - offset;
+}
+
+void AppendBytes(std::vector<uint8_t>& bytes, const void* data, size_t size) {
+  const uint8_t* begin = static_cast<const uint8_t*>(data);
+  bytes.insert(bytes.end(), begin, begin + size);
+}
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> AssetIndex::Serialize(
+    const std::vector<Asset>& assets,
+    uint32_t index_flags) {
+  std::unordered_set<std::string_view> names;
+  uint64_t names_size = 0;
+  for (const Asset& asset : assets) {
+    if (!names.insert(asset.name).second) {
+      return nullptr;
+    }
+    names_size += asset.name.size();
+  }
+  const uint64_t names_offset =
+      sizeof(Header) + uint64_t{assets.size()} * sizeof(SerializedEntry);
+  if (names_offset + names_size > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+
+  std::vector<uint8_t> bytes;
+  Header header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entry_count = assets.size();
+  header.flags = index_flags;
+  AppendBytes(bytes, &header, sizeof(Header));
+
+  uint64_t name_offset = names_offset;
+  uint64_t data_offset = (names_offset + names_size + 7) & ~uint64_t{7};
+  for (const Asset& asset : assets) {
+    SerializedEntry entry = {};
+    entry.data_offset = data_offset;
+    entry.data_size = asset.data.size();
+    entry.name_offset = name_offset;
+    entry.name_size = asset.name.size();
+    entry.flags = asset.flags;
+    AppendBytes(bytes, &entry, sizeof(SerializedEntry));
+    name_offset += asset.name.size();
+    data_offset = (data_offset + asset.data.size() + 7) & ~uint64_t{7};
+  }
+  for (const Asset& asset : assets) {
+    AppendBytes(bytes, asset.name.data(), asset.name.size());
+  }
+  for (const Asset& asset : assets) {
+    bytes.resize((bytes.size() + 7) & ~size_t{7});
+    AppendBytes(bytes, asset.data.data(), asset.data.size());
+  }
+  return std::make_unique<fml::DataMapping>(std::move(bytes));
+}
+
+std::shared_ptr<AssetIndex> AssetIndex::Create(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", "AssetIndex::Create");
+  std::shared_ptr<AssetIndex> index(new AssetIndex(std::move(mapping)));
+  if (!index->ReadEntries()) {
+    FML_LOG(ERROR) << "The asset index is malformed and will be ignored.";
+    return nullptr;
+  }
+  return index;
+}
+
+AssetIndex::AssetIndex(std::unique_ptr<fml::Mapping> mapping)
+    : mapping_(std::move(mapping)) {}
+
+AssetIndex::~AssetIndex() = default;
+
+bool AssetIndex::ReadEntries() {
+  const uint8_t* base = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  if (size < sizeof(Header)) {
+    return false;
+  }
+  Header header;
+  memcpy(&header, base, sizeof(Header));
+  if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      !IsInRange(sizeof(Header),
+                 uint64_t{header.entry_count} * sizeof(SerializedEntry),
+                 size)) {
+    return false;
+  }
+  flags_ = header.flags;
+
+  entries_.reserve(header.entry_count);
+  entries_by_name_.reserve(header.entry_count);
+  for (size_t i = 0; i < header.entry_count; i++) {
+    SerializedEntry serialized;
+    memcpy(&serialized, base + sizeof(Header) + i * sizeof(SerializedEntry),
+           sizeof(SerializedEntry));
+    if (!IsInRange(serialized.data_offset, serialized.data_size, size) ||
+        !IsInRange(serialized.name_offset, serialized.name_size, size)) {
+      return false;
+    }
+    Entry entry;
+    entry.name = std::string_view(
+        reinterpret_cast<const char*>(base + serialized.name_offset),
+        serialized.name_size);
+    entry.data = base + serialized.data_offset;
+    entry.size = serialized.data_size;
+    entry.flags = serialized.flags;
+    if (!entries_by_name_.emplace(entry.name, entries_.size()).second) {
+      return false;
+    }
+    entries_.push_back(entry);
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> AssetIndex::GetAsMapping(
+    const std::string& asset_name) const {
+  auto found = entries_by_name_.find(asset_name);
+  if (found == entries_by_name_.end()) {
+    return nullptr;
+  }
+  return CreateMapping(entries_[found->second]);
+}
+
+std::vector<std::unique_ptr<fml::Mapping>> AssetIndex::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  std::regex asset_regex(asset_pattern);
+  for (const Entry& entry : entries_) {
+    size_t separator = entry.name.rfind('/');
+    std::string_view directory;
+    std::string_view filename = entry.name;
+    if (separator != std::string_view::npos) {
+      directory = entry.name.substr(0, separator);
+      filename = entry.name.substr(separator + 1);
+    }
+    // Like a directory walk, a subdirectory limits the search to the files
+    // directly inside it.
+    if (subdir && directory != subdir.value()) {
+      continue;
+    }
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(CreateMapping(entry));
+    }
+  }
+  return mappings;
+}
+
+void AssetIndex::PrefetchStartupCriticalAssets() const {
+#if !OS_WIN && !OS_FUCHSIA
+  TRACE_EVENT0("flutter", "AssetIndex::PrefetchStartupCriticalAssets");
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  for (const Entry& entry : entries_) {
+    if ((entry.flags & kStartupCritical) == 0 || entry.size == 0) {
+      continue;
+    }
+    // madvise needs a page aligned address.
+    uintptr_t start = reinterpret_cast<uintptr_t>(entry.data);
+    uintptr_t aligned_start = start & ~(page_size - 1);
+    if (madvise(reinterpret_cast<void*>(aligned_start),
+                start - aligned_start + entry.size, MADV_WILLNEED) != 0) {
+      FML_DLOG(WARNING) << "Could not prefetch asset " << entry.name;
+    }
+  }
+#endif  // !OS_WIN && !OS_FUCHSIA
+}
+
+std::unique_ptr<fml::Mapping> AssetIndex::CreateMapping(
+    const Entry& entry) const {
+  return std::make_unique<fml::NonOwnedMapping>(
+      entry.data, entry.size,
+      [index = shared_from_this()](const uint8_t* data, size_t size) {},
+      mapping_->IsFileBacked());
+}
+
+}  // namespace flutter
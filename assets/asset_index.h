@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_ASSET_INDEX_H_
+#define FLUTTER_ASSETS_ASSET_INDEX_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A prebuilt index of assets that are packed into a single file.
+///
+///             Looking an asset up in the index costs a hash table lookup
+///             instead of an open and a map of its own file, which adds up
+///             for apps with thousands of small assets. The returned mappings
+///             point into the mapping of the packed file and keep the index
+///             alive.
+///
+///             The file is laid out as follows, with all integers in the byte
+///             order of the host and all offsets relative to the start of the
+///             file:
+///
+///             - A header: the 8 bytes of `kMagic`, a `uint32_t` version that
+///               must be `kVersion`, a `uint32_t` entry count, a `uint32_t` of
+///               `IndexFlags` and 4 reserved bytes.
+///             - The entries, each holding a `uint64_t` data offset, a
+///               `uint64_t` data size, a `uint32_t` name offset, a `uint32_t`
+///               name size, a `uint32_t` of `Flags` and 4 reserved bytes.
+///             - The names of the assets as `/`-separated paths relative to
+///               the asset directory, and the asset data, anywhere after the
+///               entries.
+///
+class AssetIndex : public std::enable_shared_from_this<AssetIndex> {
+ public:
+  /// The name of the index file in an asset directory.
+  static constexpr char kFileName[] = "AssetIndex.bin";
+
+  static constexpr char kMagic[8] = {'F', 'L', 'T', 'A', 'S', 'S', 'E', 'T'};
+
+  static constexpr uint32_t kVersion = 2;
+
+  enum IndexFlags : uint32_t {
+    /// The index holds every asset of the directory, so there are no files
+    /// to look for next to it.
+    kComplete = 1 << 0,
+  };
+
+  enum Flags : uint32_t {
+    /// The asset is read while the app starts, so its pages are prefetched
+    /// as soon as the index is loaded.
+    kStartupCritical = 1 << 0,
+  };
+
+  /// An asset to pack into an index with `Serialize`.
+  struct Asset {
+    std::string name;
+    std::vector<uint8_t> data;
+    uint32_t flags = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs `assets` into the file layout read by `Create`, with
+  ///             the data of each asset aligned to 8 bytes.
+  ///
+  /// @param[in]  index_flags  The `IndexFlags` of the index.
+  ///
+  /// @return     The contents of the index file, or nullptr if two assets
+  ///             share a name or the names do not fit the 32-bit offsets.
+  ///
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const std::vector<Asset>& assets,
+      uint32_t index_flags = 0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the index at the start of `mapping`.
+  ///
+  /// @return     The index, or nullptr if `mapping` does not hold a valid
+  ///             index.
+  ///
+  static std::shared_ptr<AssetIndex> Create(
+      std::unique_ptr<fml::Mapping> mapping);
+
+  ~AssetIndex();
+
+  size_t GetAssetCount() const { return entries_.size(); }
+
+  bool IsComplete() const { return (flags_ & kComplete) != 0; }
+
+  bool Contains(std::string_view asset_name) const {
+    return entries_by_name_.find(asset_name) != entries_by_name_.end();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the data of the asset named `asset_name`, or nullptr
+  ///             if the index does not contain it.
+  ///
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the data of the assets whose file names match
+  ///             `asset_pattern`, with the same semantics as
+  ///             `AssetResolver::GetAsMappings`.
+  ///
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to start reading the pages of the startup
+  ///             critical assets in the background. Does nothing on platforms
+  ///             without `madvise`.
+  ///
+  void PrefetchStartupCriticalAssets() const;
+
+ private:
+  struct Entry {
+    std::string_view name;
+    const uint8_t* data;
+    size_t size;
+    uint32_t flags;
+  };
+
+  const std::unique_ptr<fml::Mapping> mapping_;
+  uint32_t flags_ = 0;
+  std::vector<Entry> entries_;
+  std::unordered_map<std::string_view, size_t> entries_by_name_;
+
+  explicit AssetIndex(std::unique_ptr<fml::Mapping> mapping);
+
+  bool ReadEntries();
+
+  std::unique_ptr<fml::Mapping> CreateMapping(const Entry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AssetIndex);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_ASSET_INDEX_H_
@@ -0,0 +1,230 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+struct TestAsset {
+  std::string name;
+  std::string data;
+  uint32_t flags = 0;
+};
+
+std::unique_ptr<fml::Mapping> SerializeIndex(
+    const std::vector<TestAsset>& assets,
+    uint32_t index_flags = 0) {
+  std::vector<AssetIndex::Asset> index_assets;
+  for (const TestAsset& asset : assets) {
+    index_assets.push_back(
+        {asset.name,
+         std::vector<uint8_t>(asset.data.begin(), asset.data.end()),
+         asset.flags});
+  }
+  return AssetIndex::Serialize(index_assets, index_flags);
+}
+
+std::shared_ptr<AssetIndex> CreateIndex(const std::vector<TestAsset>& assets) {
+  return AssetIndex::Create(SerializeIndex(assets));
+}
+
+std::vector<uint8_t> ToBytes(const fml::Mapping& mapping) {
+  return std::vector<uint8_t>(mapping.GetMapping(),
+                              mapping.GetMapping() + mapping.GetSize());
+}
+
+void WriteFile(const fml::UniqueFD& directory,
+               const char* path,
+               const std::string& data) {
+  ASSERT_TRUE(fml::WriteAtomically(directory, path, fml::DataMapping(data)));
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+}  // namespace
+
+TEST(AssetIndexTest, FindsAssetsByName) {
+  auto index = CreateIndex({{"AssetManifest.json", "{}"},
+                            {"fonts/Roboto.ttf", "roboto",
+                             AssetIndex::kStartupCritical},
+                            {"empty", ""}});
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->GetAssetCount(), 3u);
+  index->PrefetchStartupCriticalAssets();
+
+  auto manifest = index->GetAsMapping("AssetManifest.json");
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(ToString(*manifest), "{}");
+  auto font = index->GetAsMapping("fonts/Roboto.ttf");
+  ASSERT_TRUE(font);
+  EXPECT_EQ(ToString(*font), "roboto");
+  auto empty = index->GetAsMapping("empty");
+  ASSERT_TRUE(empty);
+  EXPECT_EQ(empty->GetSize(), 0u);
+  EXPECT_FALSE(index->GetAsMapping("Roboto.ttf"));
+  EXPECT_TRUE(index->Contains("fonts/Roboto.ttf"));
+  EXPECT_FALSE(index->Contains("fonts"));
+}
+
+TEST(AssetIndexTest, SerializeAlignsAssetData) {
+  auto index = CreateIndex({{"odd", "1"}, {"longer name", "22"}, {"x", ""}});
+  ASSERT_TRUE(index);
+  for (const char* name : {"odd", "longer name", "x"}) {
+    auto mapping = index->GetAsMapping(name);
+    ASSERT_TRUE(mapping);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapping->GetMapping()) % 8, 0u)
+        << name;
+  }
+  EXPECT_EQ(ToString(*index->GetAsMapping("longer name")), "22");
+}
+
+TEST(AssetIndexTest, SerializeRejectsDuplicateNames) {
+  EXPECT_FALSE(SerializeIndex({{"a", "1"}, {"a", "2"}}));
+}
+
+TEST(AssetIndexTest, MappingsKeepTheIndexAlive) {
+  auto index = CreateIndex({{"a", "data"}});
+  ASSERT_TRUE(index);
+  auto mapping = index->GetAsMapping("a");
+  std::weak_ptr<AssetIndex> weak_index = index;
+  index.reset();
+  EXPECT_FALSE(weak_index.expired());
+  EXPECT_EQ(ToString(*mapping), "data");
+  mapping.reset();
+  EXPECT_TRUE(weak_index.expired());
+}
+
+TEST(AssetIndexTest, MatchesFileNamesAgainstPatterns) {
+  auto index = CreateIndex({{"shaders/a.skp", "a"},
+                            {"shaders/nested/b.skp", "b"},
+                            {"c.skp", "c"},
+                            {"shaders/d.txt", "d"}});
+  ASSERT_TRUE(index);
+
+  auto all = index->GetAsMappings(".*\\.skp$", std::nullopt);
+  ASSERT_EQ(all.size(), 3u);
+  auto in_shaders = index->GetAsMappings(".*\\.skp$", "shaders");
+  ASSERT_EQ(in_shaders.size(), 1u);
+  EXPECT_EQ(ToString(*in_shaders[0]), "a");
+}
+
+TEST(AssetIndexTest, RejectsMalformedIndexes) {
+  EXPECT_FALSE(AssetIndex::Create(nullptr));
+  EXPECT_FALSE(AssetIndex::Create(
+      std::make_unique<fml::DataMapping>(std::string("FLTASSET"))));
+
+  std::vector<uint8_t> bytes = ToBytes(*SerializeIndex({{"a", "data"}}));
+  bytes[0] = 'X';
+  EXPECT_FALSE(AssetIndex::Create(std::make_unique<fml::DataMapping>(bytes)));
+
+  // The data of the only asset runs past the end of the file.
+  bytes = ToBytes(*SerializeIndex({{"a", "data"}}));
+  bytes.pop_back();
+  EXPECT_FALSE(AssetIndex::Create(std::make_unique<fml::DataMapping>(bytes)));
+
+  // Rename "b" to "a". The names follow the 24 byte header and two 32 byte
+  // entries.
+  bytes = ToBytes(*SerializeIndex({{"a", "1"}, {"b", "2"}}));
+  ASSERT_EQ(bytes[89], 'b');
+  bytes[89] = 'a';
+  EXPECT_FALSE(AssetIndex::Create(std::make_unique<fml::DataMapping>(bytes)));
+}
+
+TEST(AssetIndexTest, DirectoryAssetBundleReadsTheIndex) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(), AssetIndex::kFileName,
+                                   *SerializeIndex({{"packed",
+                                                     "from the index"}})));
+  WriteFile(asset_dir.fd(), "loose", "from a file");
+
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<DirectoryAssetBundle>(
+          fml::OpenDirectory(asset_dir.path().c_str(), false,
+                             fml::FilePermission::kRead),
+          false);
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto packed = bundle->GetAsMapping("packed");
+  ASSERT_TRUE(packed);
+  EXPECT_EQ(ToString(*packed), "from the index");
+  auto loose_mapping = bundle->GetAsMapping("loose");
+  ASSERT_TRUE(loose_mapping);
+  EXPECT_EQ(ToString(*loose_mapping), "from a file");
+  EXPECT_EQ(bundle->GetAsMappings("pack.*", std::nullopt).size(), 1u);
+}
+
+TEST(AssetIndexTest, DirectoryAssetBundleMergesIndexAndFiles) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  ASSERT_TRUE(fml::WriteAtomically(
+      asset_dir.fd(), AssetIndex::kFileName,
+      *SerializeIndex({{"a.skp", "packed a"},
+                       {"shaders/b.skp", "packed b"}})));
+  ASSERT_TRUE(fml::CreateDirectory(asset_dir.fd(), {"shaders"},
+                                   fml::FilePermission::kReadWrite)
+                  .is_valid());
+  // b.skp is in both and must only be returned once, from the index.
+  WriteFile(asset_dir.fd(), "shaders/b.skp", "loose b");
+  WriteFile(asset_dir.fd(), "shaders/c.skp", "loose c");
+  WriteFile(asset_dir.fd(), "d.skp", "loose d");
+
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<DirectoryAssetBundle>(
+          fml::OpenDirectory(asset_dir.path().c_str(), false,
+                             fml::FilePermission::kRead),
+          false);
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto ToSortedStrings =
+      [](const std::vector<std::unique_ptr<fml::Mapping>>& mappings) {
+        std::vector<std::string> strings;
+        for (const auto& mapping : mappings) {
+          strings.push_back(ToString(*mapping));
+        }
+        std::sort(strings.begin(), strings.end());
+        return strings;
+      };
+  EXPECT_EQ(ToSortedStrings(bundle->GetAsMappings(".*\\.skp$", std::nullopt)),
+            (std::vector<std::string>{"loose c", "loose d", "packed a",
+                                      "packed b"}));
+  EXPECT_EQ(ToSortedStrings(bundle->GetAsMappings(".*\\.skp$", "shaders")),
+            (std::vector<std::string>{"loose c", "packed b"}));
+  // The index file itself is not an asset.
+  EXPECT_TRUE(bundle->GetAsMappings(".*\\.bin$", std::nullopt).empty());
+}
+
+TEST(AssetIndexTest, CompleteIndexSkipsTheFiles) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  ASSERT_TRUE(fml::WriteAtomically(
+      asset_dir.fd(), AssetIndex::kFileName,
+      *SerializeIndex({{"a.skp", "packed a"}}, AssetIndex::kComplete)));
+  // Files that are not in a complete index are never looked at.
+  WriteFile(asset_dir.fd(), "b.skp", "loose b");
+
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<DirectoryAssetBundle>(
+          fml::OpenDirectory(asset_dir.path().c_str(), false,
+                             fml::FilePermission::kRead),
+          false);
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto mappings = bundle->GetAsMappings(".*\\.skp$", std::nullopt);
+  ASSERT_EQ(mappings.size(), 1u);
+  EXPECT_EQ(ToString(*mappings[0]), "packed a");
+  EXPECT_FALSE(bundle->GetAsMapping("b.skp"));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -23,6 +23,14 @@ DirectoryAssetBundle::DirectoryAssetBundle(
   }
   is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
   is_valid_ = true;
+
+  if (fml::FileExists(descriptor_, AssetIndex::kFileName)) {
+    index_ = AssetIndex::Create(
+        fml::FileMapping::CreateReadOnly(descriptor_, AssetIndex::kFileName));
+    if (index_) {
+      index_->PrefetchStartupCriticalAssets();
+    }
+  }
 }
 
 DirectoryAssetBundle::~DirectoryAssetBundle() = default;
@@ -50,6 +58,13 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
+  if (index_) {
+    auto mapping = index_->GetAsMapping(asset_name);
+    if (mapping || index_->IsComplete()) {
+      return mapping;
+    }
+  }
+
   auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
       descriptor_, asset_name.c_str(), false, fml::FilePermission::kRead));
 
@@ -69,21 +84,50 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     return mappings;
   }
 
+  // Assets packed into the index are returned from it, and the directory walk
+  // adds the ones that only exist as files, unless the index has them all.
+  if (index_) {
+    mappings = index_->GetAsMappings(asset_pattern, subdir);
+    if (index_->IsComplete()) {
+      return mappings;
+    }
+  }
+
   std::regex asset_regex(asset_pattern);
+  // The path of the visited directory relative to the asset directory, used
+  // to skip the files that are also in the index.
+  std::string prefix = subdir ? subdir.value() + "/" : "";
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     TRACE_EVENT0("flutter", "DirectoryAssetBundle::GetAsMappings FileVisitor");
 
+    const std::string path = prefix + filename;
+    if (fml::IsDirectory(directory, filename.c_str())) {
+      if (!subdir) {
+        fml::UniqueFD sub_dir =
+            fml::OpenDirectoryReadOnly(directory, filename.c_str());
+        if (!sub_dir.is_valid()) {
+          FML_LOG(ERROR) << "Can't open sub-directory: " << filename;
+          return true;
+        }
+        std::string parent_prefix = std::move(prefix);
+        prefix = path + "/";
+        fml::VisitFiles(sub_dir, visitor);
+        prefix = std::move(parent_prefix);
+      }
+      return true;
+    }
+
+    if (index_ && (path == AssetIndex::kFileName || index_->Contains(path))) {
+      return true;
+    }
+
     if (std::regex_match(filename, asset_regex)) {
       TRACE_EVENT0("flutter", "Matched File");
 
       fml::UniqueFD fd = fml::OpenFile(directory, filename.c_str(), false,
                                        fml::FilePermission::kRead);
 
-      if (fml::IsDirectory(fd)) {
-        return true;
-      }
-
       auto mapping = std::make_unique<fml::FileMapping>(fd);
 
       if (mapping && mapping->IsValid()) {
@@ -95,13 +139,15 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     return true;
   };
   if (!subdir) {
-    fml::VisitFilesRecursively(descriptor_, visitor);
+    fml::VisitFiles(descriptor_, visitor);
   } else {
     fml::UniqueFD subdir_fd =
         fml::OpenFileReadOnly(descriptor_, subdir.value().c_str());
     if (!fml::IsDirectory(subdir_fd)) {
-      FML_LOG(ERROR) << "Subdirectory path " << subdir.value()
-                     << " is not a directory";
+      if (mappings.empty()) {
+        FML_LOG(ERROR) << "Subdirectory path " << subdir.value()
+                       << " is not a directory";
+      }
       return mappings;
     }
     fml::VisitFiles(subdir_fd, visitor);
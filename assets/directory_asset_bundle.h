@@ -5,7 +5,10 @@
 #ifndef FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 #define FLUTTER_ASSETS_DIRECTORY_ASSET_BUNDLE_H_
 
+#include <memory>
 #include <optional>
+
+#include "flutter/assets/asset_index.h"
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
@@ -13,6 +16,15 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from the files in a directory.
+///
+///             If the directory contains an `AssetIndex::kFileName` file, it
+///             is mapped once and assets are looked up in it first. Assets
+///             missing from the index are still read from their own files, and
+///             `GetAsMappings` returns the matches from both, preferring the
+///             index for assets that are in both.
+///
 class DirectoryAssetBundle : public AssetResolver {
  public:
   DirectoryAssetBundle(fml::UniqueFD descriptor,
@@ -24,6 +36,7 @@ class DirectoryAssetBundle : public AssetResolver {
   const fml::UniqueFD descriptor_;
   bool is_valid_ = false;
   bool is_valid_after_asset_manager_change_ = false;
+  std::shared_ptr<AssetIndex> index_;
 
   // |AssetResolver|
   bool IsValid() const override;
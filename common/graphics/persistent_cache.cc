@@ -4,6 +4,10 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -15,9 +19,13 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/version/version.h"
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
@@ -51,6 +59,8 @@ bool PersistentCache::gIsReadOnly = false;
 
 std::atomic<bool> PersistentCache::cache_sksl_ = false;
 std::atomic<bool> PersistentCache::strategy_set_ = false;
+std::atomic<int64_t> PersistentCache::precompile_budget_micros_ =
+    fml::TimeDelta::Max().ToMicroseconds();
 
 void PersistentCache::SetCacheSkSL(bool value) {
   if (strategy_set_ && value != cache_sksl_) {
@@ -79,6 +89,10 @@ void PersistentCache::SetCacheDirectoryPath(std::string path) {
   cache_base_path_ = path;
 }
 
+void PersistentCache::SetPrecompileBudget(fml::TimeDelta budget) {
+  precompile_budget_micros_ = budget.ToMicroseconds();
+}
+
 bool PersistentCache::Purge() {
   // Make sure that this is called after the worker task runner setup so all the
   // file system modifications would happen on that single thread to avoid
@@ -192,19 +206,139 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return data;
 }
 
-size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
+namespace {
+
+// The number of entries read and decoded by each task posted to the
+// concurrent task runner.
+constexpr size_t kSkSLLoadBatchSize = 16;
+
+// A use count loses half of its weight for every week the entry goes unused.
+constexpr double kUsageHalfLifeMillis = 7.0 * 24 * 60 * 60 * 1000;
+
+int64_t NowEpochMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+double UsageScore(const PersistentCache::SkSLUsage& usage, int64_t now) {
+  double age = std::max<int64_t>(now - usage.last_used_millis, 0);
+  return usage.use_count * std::exp2(-age / kUsageHalfLifeMillis);
+}
+
+// Invokes |job| for every index in [0, count), spreading the calls over the
+// given task runner, and waits for all of them to finish. Without a task
+// runner, all the jobs run on the calling thread.
+void RunConcurrently(const std::shared_ptr<fml::BasicTaskRunner>& runner,
+                     size_t count,
+                     const std::function<void(size_t)>& job) {
+  if (!runner || count <= kSkSLLoadBatchSize) {
+    for (size_t i = 0; i < count; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  const size_t batch_count =
+      (count + kSkSLLoadBatchSize - 1) / kSkSLLoadBatchSize;
+  fml::CountDownLatch latch(batch_count);
+  for (size_t batch = 0; batch < batch_count; batch++) {
+    runner->PostTask([&job, &latch, batch, count]() {
+      const size_t end = std::min(count, (batch + 1) * kSkSLLoadBatchSize);
+      for (size_t i = batch * kSkSLLoadBatchSize; i < end; i++) {
+        job(i);
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+}
+
+}  // namespace
+
+size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) {
   auto known_sksls = LoadSkSLs();
   // A trace must be present even if no precompilations have been completed.
   FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
                   known_sksls.size());
 
+  {
+    std::scoped_lock lock(pending_mutex_);
+    pending_sksls_.clear();
+    pending_context_ = nullptr;
+  }
+
   if (context == nullptr) {
     return 0;
   }
 
+  PrioritizeSkSLs(known_sksls);
+  // Compile from the back so that deferred entries can be popped cheaply.
+  std::reverse(known_sksls.begin(), known_sksls.end());
+
+  size_t precompiled_count =
+      PrecompileWithinBudget(context, known_sksls, precompile_budget());
+
+  if (!known_sksls.empty()) {
+    FML_LOG(INFO) << "Deferring the precompilation of " << known_sksls.size()
+                  << " SkSLs that did not fit in the startup budget.";
+    std::scoped_lock lock(pending_mutex_);
+    pending_sksls_ = std::move(known_sksls);
+    pending_context_ = context;
+  }
+
+  return precompiled_count;
+}
+
+size_t PersistentCache::PrecompilePendingSkSLs(GrDirectContext* context,
+                                               fml::TimeDelta budget) {
+  std::vector<SkSLCache> pending;
+  {
+    std::scoped_lock lock(pending_mutex_);
+    if (pending_sksls_.empty()) {
+      return 0;
+    }
+    if (context == nullptr || context != pending_context_ ||
+        context->abandoned()) {
+      pending_sksls_.clear();
+      pending_context_ = nullptr;
+      return 0;
+    }
+    pending.swap(pending_sksls_);
+  }
+
+  FML_TRACE_EVENT("flutter", "PersistentCache::PrecompilePendingSkSLs",
+                  "count", pending.size());
+  size_t precompiled_count = PrecompileWithinBudget(context, pending, budget);
+
+  std::scoped_lock lock(pending_mutex_);
+  // |PrecompileKnownSkSLs| may have started over in the meantime.
+  if (pending_sksls_.empty() && pending_context_ == context) {
+    pending_sksls_ = std::move(pending);
+  }
+  if (pending_sksls_.empty()) {
+    pending_context_ = nullptr;
+  }
+  return precompiled_count;
+}
+
+bool PersistentCache::HasPendingSkSLs() const {
+  std::scoped_lock lock(pending_mutex_);
+  return !pending_sksls_.empty();
+}
+
+size_t PersistentCache::PrecompileWithinBudget(GrDirectContext* context,
+                                               std::vector<SkSLCache>& sksls,
+                                               fml::TimeDelta budget) {
+  const fml::TimePoint start = fml::TimePoint::Now();
   size_t precompiled_count = 0;
-  for (const auto& sksl : known_sksls) {
+  while (!sksls.empty()) {
+    if (fml::TimePoint::Now() - start >= budget) {
+      break;
+    }
     TRACE_EVENT0("flutter", "PrecompilingSkSL");
+    const SkSLCache sksl = std::move(sksls.back());
+    sksls.pop_back();
     if (context->precompileShader(*sksl.first, *sksl.second)) {
       precompiled_count++;
     }
@@ -212,33 +346,145 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
 
   FML_TRACE_COUNTER("flutter", "PersistentCache::PrecompiledSkSLs",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
-                    "Successful", precompiled_count);
+                    "Successful", precompiled_count,  //
+                    "Pending", sksls.size());
   return precompiled_count;
 }
 
+PersistentCache::SkSLUsage PersistentCache::GetSkSLUsage(
+    const SkData& key) const {
+  std::scoped_lock lock(usage_records_->mutex);
+  LoadUsageLocked();
+  const auto& entries = usage_records_->entries;
+  auto found = entries.find(SkKeyToFilePath(key));
+  return found == entries.end() ? SkSLUsage{} : found->second;
+}
+
+void PersistentCache::PrioritizeSkSLs(std::vector<SkSLCache>& sksls) const {
+  const int64_t now = NowEpochMillis();
+  std::vector<std::pair<double, SkSLCache>> scored;
+  scored.reserve(sksls.size());
+  {
+    std::scoped_lock lock(usage_records_->mutex);
+    LoadUsageLocked();
+    const auto& entries = usage_records_->entries;
+    for (auto& sksl : sksls) {
+      auto found = entries.find(SkKeyToFilePath(*sksl.first));
+      double score =
+          found == entries.end() ? 0.0 : UsageScore(found->second, now);
+      scored.emplace_back(score, std::move(sksl));
+    }
+  }
+
+  std::stable_sort(
+      scored.begin(), scored.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  for (size_t i = 0; i < sksls.size(); i++) {
+    sksls[i] = std::move(scored[i].second);
+  }
+}
+
+void PersistentCache::LoadUsageLocked() const {
+  if (usage_records_->loaded) {
+    return;
+  }
+  usage_records_->loaded = true;
+  if (!IsValid()) {
+    return;
+  }
+
+  auto file = fml::OpenFileReadOnly(*cache_directory_, kUsageFileName);
+  if (!file.is_valid()) {
+    return;
+  }
+  fml::FileMapping mapping(file);
+  if (mapping.GetSize() == 0) {
+    return;
+  }
+
+  rapidjson::Document json_doc;
+  json_doc.Parse(reinterpret_cast<const char*>(mapping.GetMapping()),
+                 mapping.GetSize());
+  if (json_doc.HasParseError() || !json_doc.IsObject()) {
+    FML_LOG(ERROR) << "Failed to parse json file: " << kUsageFileName;
+    return;
+  }
+  for (const auto& item : json_doc.GetObject()) {
+    const auto& value = item.value;
+    if (!value.IsArray() || value.Size() != 2 || !value[0].IsUint() ||
+        !value[1].IsInt64()) {
+      continue;
+    }
+    usage_records_->entries[item.name.GetString()] = {value[0].GetUint(),
+                                                      value[1].GetInt64()};
+  }
+}
+
+void PersistentCache::RecordUsage(const std::string& file_name) {
+  {
+    std::scoped_lock lock(usage_records_->mutex);
+    LoadUsageLocked();
+    SkSLUsage& usage = usage_records_->entries[file_name];
+    usage.use_count++;
+    usage.last_used_millis = NowEpochMillis();
+    if (is_read_only_ || !IsValid() || usage_records_->write_scheduled) {
+      return;
+    }
+    usage_records_->write_scheduled = true;
+  }
+
+  // Writes are coalesced: the task serializes whatever has been recorded by
+  // the time it runs.
+  auto task = [records = usage_records_, cache_directory = cache_directory_]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStoreUsage");
+    rapidjson::StringBuffer buffer;
+    {
+      std::scoped_lock lock(records->mutex);
+      records->write_scheduled = false;
+      rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+      writer.StartObject();
+      for (const auto& [name, usage] : records->entries) {
+        writer.Key(name.c_str());
+        writer.StartArray();
+        writer.Uint(usage.use_count);
+        writer.Int64(usage.last_used_millis);
+        writer.EndArray();
+      }
+      writer.EndObject();
+    }
+    fml::DataMapping mapping(
+        std::string{buffer.GetString(), buffer.GetSize()});
+    if (!fml::WriteAtomically(*cache_directory, kUsageFileName, mapping)) {
+      FML_LOG(WARNING) << "Could not write shader usage to persistent store.";
+    }
+  };
+
+  if (auto worker = GetWorkerTaskRunner()) {
+    worker->PostTask(task);
+  } else {
+    task();
+  }
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
-  std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
-    sk_sp<SkData> key = ParseBase32(filename);
-    sk_sp<SkData> data = LoadFile(directory, filename);
-    if (key != nullptr && data != nullptr) {
-      result.push_back({key, data});
-    } else {
-      FML_LOG(ERROR) << "Failed to load: " << filename;
-    }
+  // Entries are listed on this thread, then read and decoded concurrently.
+  std::vector<std::string> file_names;
+  fml::FileVisitor visitor = [&file_names](const fml::UniqueFD& directory,
+                                           const std::string& filename) {
+    file_names.push_back(filename);
     return true;
   };
 
   // Only visit sksl_cache_directory_ if this persistent cache is valid.
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
+  fml::UniqueFD fresh_dir;
   if (IsValid()) {
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
-    fml::UniqueFD fresh_dir =
-        fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
+    fresh_dir = fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
     if (fresh_dir.is_valid()) {
       fml::VisitFiles(fresh_dir, visitor);
     }
@@ -248,11 +494,12 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   if (asset_manager_ != nullptr) {
     mapping = asset_manager_->GetAsMapping(kAssetFileName);
   }
+  rapidjson::Document json_doc;
+  std::vector<std::pair<const char*, const char*>> asset_items;
   if (mapping == nullptr) {
     FML_LOG(INFO) << "No sksl asset found.";
   } else {
     FML_LOG(INFO) << "Found sksl asset. Loading SkSLs from it...";
-    rapidjson::Document json_doc;
     rapidjson::ParseResult parse_result =
         json_doc.Parse(reinterpret_cast<const char*>(mapping->GetMapping()),
                        mapping->GetSize());
@@ -260,17 +507,37 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
       FML_LOG(ERROR) << "Failed to parse json file: " << kAssetFileName;
     } else {
       for (auto& item : json_doc["data"].GetObject()) {
-        sk_sp<SkData> key = ParseBase32(item.name.GetString());
-        sk_sp<SkData> sksl = ParseBase64(item.value.GetString());
-        if (key != nullptr && sksl != nullptr) {
-          result.push_back({key, sksl});
-        } else {
-          FML_LOG(ERROR) << "Failed to load: " << item.name.GetString();
-        }
+        asset_items.emplace_back(item.name.GetString(),
+                                 item.value.GetString());
       }
     }
   }
 
+  std::vector<PersistentCache::SkSLCache> loaded(file_names.size() +
+                                                 asset_items.size());
+  RunConcurrently(GetConcurrentTaskRunner(), loaded.size(), [&](size_t i) {
+    if (i < file_names.size()) {
+      loaded[i] = {ParseBase32(file_names[i]),
+                   LoadFile(fresh_dir, file_names[i])};
+    } else {
+      const auto& item = asset_items[i - file_names.size()];
+      loaded[i] = {ParseBase32(item.first), ParseBase64(item.second)};
+    }
+  });
+
+  std::vector<PersistentCache::SkSLCache> result;
+  result.reserve(loaded.size());
+  for (size_t i = 0; i < loaded.size(); i++) {
+    if (loaded[i].first != nullptr && loaded[i].second != nullptr) {
+      result.push_back(std::move(loaded[i]));
+    } else if (i < file_names.size()) {
+      FML_LOG(ERROR) << "Failed to load: " << file_names[i];
+    } else {
+      FML_LOG(ERROR) << "Failed to load: "
+                     << asset_items[i - file_names.size()].first;
+    }
+  }
+
   return result;
 }
 
@@ -278,7 +545,8 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      usage_records_(std::make_shared<UsageRecords>()) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -317,6 +585,7 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   auto result = PersistentCache::LoadFile(*cache_directory_, file_name);
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    RecordUsage(file_name);
   }
   return result;
 }
@@ -374,6 +643,8 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
+  RecordUsage(file_name);
+
   PersistentCacheStore(GetWorkerTaskRunner(),
                        cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
                        std::move(file_name), std::move(mapping));
@@ -397,6 +668,26 @@ void PersistentCache::DumpSkp(const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+std::string PersistentCache::LoadFontFallbackHints() const {
+  if (!IsValid()) {
+    return "";
+  }
+  sk_sp<SkData> data = LoadFile(*cache_directory_, kFontFallbackHintsFileName);
+  if (!data) {
+    return "";
+  }
+  return std::string(static_cast<const char*>(data->data()), data->size());
+}
+
+void PersistentCache::StoreFontFallbackHints(std::string hints) {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kFontFallbackHintsFileName,
+                       std::make_unique<fml::DataMapping>(std::move(hints)));
+}
+
 void PersistentCache::AddWorkerTaskRunner(
     fml::RefPtr<fml::TaskRunner> task_runner) {
   std::scoped_lock lock(worker_task_runners_mutex_);
@@ -412,6 +703,18 @@ void PersistentCache::RemoveWorkerTaskRunner(
   }
 }
 
+void PersistentCache::SetConcurrentTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  std::scoped_lock lock(worker_task_runners_mutex_);
+  concurrent_task_runner_ = std::move(task_runner);
+}
+
+std::shared_ptr<fml::BasicTaskRunner>
+PersistentCache::GetConcurrentTaskRunner() const {
+  std::scoped_lock lock(worker_task_runners_mutex_);
+  return concurrent_task_runner_;
+}
+
 fml::RefPtr<fml::TaskRunner> PersistentCache::GetWorkerTaskRunner() const {
   fml::RefPtr<fml::TaskRunner> worker;
 
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -12,6 +13,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -53,6 +55,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   void RemoveWorkerTaskRunner(fml::RefPtr<fml::TaskRunner> task_runner);
 
+  /// Set the concurrent task runner on which shader entries are read and
+  /// decoded in parallel before precompilation. A nullptr can be provided to
+  /// load everything on the calling thread.
+  void SetConcurrentTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
   // Whether Skia tries to store any shader into this persistent cache after
   // |ResetStoredNewShaders| is called. This flag is usually reset before each
   // frame so we can know if Skia tries to compile new shaders in that frame.
@@ -71,13 +79,43 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   using SkSLCache = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
 
+  /// Usage information recorded alongside the cache entries. It is updated
+  /// whenever Skia stores or loads an entry and is used to decide in which
+  /// order known SkSLs are precompiled.
+  ///
+  /// Skia only goes to the persistent cache for programs missing from its
+  /// in-memory cache, so draws that reuse a compiled program are not counted.
+  /// In particular, once an entry is precompiled at startup its count stops
+  /// growing for the rest of the run. The count is how often the shader had
+  /// to be compiled or loaded, not how often it was drawn with.
+  struct SkSLUsage {
+    /// The number of times the entry has been stored or loaded.
+    uint32_t use_count = 0;
+    /// Milliseconds since the epoch at which the entry was last used.
+    int64_t last_used_millis = 0;
+  };
+
   /// Load all the SkSL shader caches in the right directory.
   std::vector<SkSLCache> LoadSkSLs() const;
 
+  /// The recorded usage of the shader with the given key. Entries that were
+  /// never seen by this cache have a zero use count.
+  SkSLUsage GetSkSLUsage(const SkData& key) const;
+
+  /// Reorders the given SkSLs so that the ones used most often and most
+  /// recently come first. Entries without usage information keep their
+  /// relative order at the end.
+  void PrioritizeSkSLs(std::vector<SkSLCache>& sksls) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Precompile SkSLs packaged with the application and gathered
   ///             during previous runs in the given context.
   ///
+  ///             Entries are precompiled in priority order (see
+  ///             |PrioritizeSkSLs|) until the precompile budget is used up.
+  ///             The remaining entries are kept and compiled in small slices
+  ///             by |PrecompilePendingSkSLs|.
+  ///
   /// @warning    The context must be the rendering context. This context may be
   ///             destroyed during application suspension and subsequently
   ///             recreated. The SkSLs must be precompiled again in the new
@@ -87,7 +125,33 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   /// @return     The number of SkSLs precompiled.
   ///
-  size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
+  size_t PrecompileKnownSkSLs(GrDirectContext* context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompile SkSLs that were deferred by the last call to
+  ///             |PrecompileKnownSkSLs| because they did not fit in the
+  ///             precompile budget. Surfaces call this once per frame.
+  ///
+  /// @param      context  The rendering context given to
+  ///                      |PrecompileKnownSkSLs|. Pending entries are dropped
+  ///                      if this is a different context.
+  /// @param      budget   The time that may be spent compiling in this call.
+  ///
+  /// @return     The number of SkSLs precompiled.
+  ///
+  size_t PrecompilePendingSkSLs(GrDirectContext* context,
+                                fml::TimeDelta budget);
+
+  /// Whether some known SkSLs are still waiting to be precompiled.
+  bool HasPendingSkSLs() const;
+
+  /// The fallback font hints stored by an earlier run, or an empty string if
+  /// there are none. See |txt::FontCollection::LoadFallbackFontHints|.
+  std::string LoadFontFallbackHints() const;
+
+  /// Replaces the stored fallback font hints. The file is written on a worker
+  /// task runner.
+  void StoreFontFallbackHints(std::string hints);
 
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
@@ -105,8 +169,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  /// Set the time that |PrecompileKnownSkSLs| may spend compiling before it
+  /// defers the remaining entries. |fml::TimeDelta::Max()| means no limit.
+  static void SetPrecompileBudget(fml::TimeDelta budget);
+  static fml::TimeDelta precompile_budget() {
+    return fml::TimeDelta::FromMicroseconds(precompile_budget_micros_);
+  }
+
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kUsageFileName[] = "io.flutter.shader_usage.json";
+  static constexpr char kFontFallbackHintsFileName[] =
+      "io.flutter.font_fallback_hints";
+
+  /// The time surfaces spend per frame on |PrecompilePendingSkSLs|.
+  static constexpr fml::TimeDelta kPendingSkSLsFrameBudget =
+      fml::TimeDelta::FromMilliseconds(2);
 
  private:
   static std::string cache_base_path_;
@@ -126,11 +204,33 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // strategy_set_ becomes true.
   static std::atomic<bool> strategy_set_;
 
+  // Set by every shell that is created and read on the raster thread, so it
+  // is kept in microseconds to be atomic like the flags above.
+  static std::atomic<int64_t> precompile_budget_micros_;
+
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_task_runner_;
+
+  // Usage of the entries keyed by their file name. It is read lazily from
+  // |kUsageFileName| and written back on the worker task runner, which may
+  // outlive this cache.
+  struct UsageRecords {
+    std::mutex mutex;
+    std::map<std::string, SkSLUsage> entries;
+    bool loaded = false;
+    bool write_scheduled = false;
+  };
+  const std::shared_ptr<UsageRecords> usage_records_;
+
+  // SkSLs that did not fit in the precompile budget of |pending_context_|,
+  // stored in reverse priority order so the next entry is at the back.
+  mutable std::mutex pending_mutex_;
+  std::vector<SkSLCache> pending_sksls_;
+  GrDirectContext* pending_context_ = nullptr;
 
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
@@ -147,6 +247,16 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  std::shared_ptr<fml::BasicTaskRunner> GetConcurrentTaskRunner() const;
+
+  void LoadUsageLocked() const;
+
+  void RecordUsage(const std::string& file_name);
+
+  size_t PrecompileWithinBudget(GrDirectContext* context,
+                                std::vector<SkSLCache>& sksls,
+                                fml::TimeDelta budget);
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
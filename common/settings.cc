@@ -38,9 +38,12 @@ std::string Settings::ToString() const {
   stream << "trace_skia: " << trace_skia << std::endl;
   stream << "trace_startup: " << trace_startup << std::endl;
   stream << "trace_systrace: " << trace_systrace << std::endl;
+  stream << "enable_trace_recorder: " << enable_trace_recorder << std::endl;
   stream << "dump_skp_on_shader_compilation: " << dump_skp_on_shader_compilation
          << std::endl;
   stream << "cache_sksl: " << cache_sksl << std::endl;
+  stream << "sksl_precompile_budget_ms: " << sksl_precompile_budget_ms
+         << std::endl;
   stream << "purge_persistent_cache: " << purge_persistent_cache << std::endl;
   stream << "endless_trace_buffer: " << endless_trace_buffer << std::endl;
   stream << "enable_dart_profiling: " << enable_dart_profiling << std::endl;
@@ -53,6 +56,20 @@ std::string Settings::ToString() const {
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
+  stream << "enable_parallel_preroll: " << enable_parallel_preroll
+         << std::endl;
+  stream << "backdrop_blur_max_downsampling: "
+         << backdrop_blur_max_downsampling << std::endl;
+  stream << "enable_layer_paint_times: " << enable_layer_paint_times
+         << std::endl;
+  stream << "enable_display_list_content_cache_keys: "
+         << enable_display_list_content_cache_keys << std::endl;
+  stream << "enable_pointer_resampling: " << enable_pointer_resampling
+         << std::endl;
+  stream << "pointer_resampling_prediction_window_ms: "
+         << pointer_resampling_prediction_window_ms << std::endl;
+  stream << "enable_semantics_update_diffing: "
+         << enable_semantics_update_diffing << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_initialization_required: " << icu_initialization_required
          << std::endl;
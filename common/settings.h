@@ -114,9 +114,16 @@ struct Settings {
   std::vector<std::string> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Whether trace events are also kept in in-memory per-thread ring buffers
+  // that can be snapshotted on demand. This works in release mode too.
+  bool enable_trace_recorder = false;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // The time in milliseconds that may be spent precompiling known SkSLs when
+  // the rendering context is created. The remaining shaders are precompiled a
+  // few at a time on subsequent frames. A negative value means no limit.
+  int64_t sksl_precompile_budget_ms = -1;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
@@ -168,6 +175,23 @@ struct Settings {
   // Selects the DisplayList for storage of rendering operations.
   bool enable_display_list = false;
 
+  // Whether the raster cache keys display lists on their content, so that
+  // display lists that were recorded again without changes keep their cached
+  // images.
+  bool enable_display_list_content_cache_keys = false;
+
+  // Whether the moves of each pointer are resampled once per frame, instead of
+  // being dispatched as the platform delivers them.
+  bool enable_pointer_resampling = false;
+
+  // How far past the newest sample of a pointer its resampled position may be
+  // extrapolated, in milliseconds.
+  int64_t pointer_resampling_prediction_window_ms = 8;
+
+  // Whether semantics updates leave out the nodes that are the same as when
+  // they were last sent to the platform.
+  bool enable_semantics_update_diffing = false;
+
   // All shells in the process share the same VM. The last shell to shutdown
   // should typically shut down the VM as well. However, applications depend on
   // the behavior of "warming-up" the VM by creating a shell that does not do
@@ -221,6 +245,17 @@ struct Settings {
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Whether large sibling subtrees of layer trees are prerolled in parallel on
+  // the concurrent worker threads of the VM.
+  bool enable_parallel_preroll = false;
+  // The largest factor by which backdrop blurs may be downsampled before they
+  // are run. Larger factors are faster but lose detail in small blurs. 1
+  // disables downsampling.
+  int backdrop_blur_max_downsampling = 1;
+  // Whether the paint time of every layer is measured, so that janky frames
+  // in the frame statistics list the layers that took the longest to paint.
+  // Timing every layer has a cost of its own, so this is off by default.
+  bool enable_layer_paint_times = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
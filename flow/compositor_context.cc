@@ -10,7 +10,9 @@
 namespace flutter {
 
 CompositorContext::CompositorContext(fml::Milliseconds frame_budget)
-    : raster_time_(frame_budget), ui_time_(frame_budget) {}
+    : raster_time_(frame_budget),
+      ui_time_(frame_budget),
+      frame_statistics_(std::make_shared<FrameStatistics>()) {}
 
 CompositorContext::~CompositorContext() = default;
 
@@ -25,6 +27,7 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
 void CompositorContext::EndFrame(ScopedFrame& frame,
                                  bool enable_instrumentation) {
   raster_cache_.SweepAfterFrame();
+  shadow_cache_.SweepAfterFrame();
   if (enable_instrumentation) {
     raster_time_.Stop();
   }
@@ -107,11 +110,13 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::OnGrContextCreated() {
   texture_registry_.OnGrContextCreated();
   raster_cache_.Clear();
+  shadow_cache_.Clear();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_.OnGrContextDestroyed();
   raster_cache_.Clear();
+  shadow_cache_.Clear();
 }
 
 }  // namespace flutter
@@ -10,10 +10,13 @@
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_statistics.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/flow/shadow_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -79,6 +82,14 @@ class CompositorContext {
 
     GrDirectContext* gr_context() const { return gr_context_; }
 
+    // The paint times of the layers of this frame, or null unless both
+    // instrumentation and layer paint times are enabled.
+    LayerPaintTimes* layer_paint_times() {
+      return instrumentation_enabled_ && context_.layer_paint_times_enabled()
+                 ? &layer_paint_times_
+                 : nullptr;
+    }
+
     virtual RasterStatus Raster(LayerTree& layer_tree,
                                 bool ignore_raster_cache);
 
@@ -91,6 +102,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    LayerPaintTimes layer_paint_times_;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -114,6 +126,8 @@ class CompositorContext {
 
   RasterCache& raster_cache() { return raster_cache_; }
 
+  ShadowCache& shadow_cache() { return shadow_cache_; }
+
   TextureRegistry& texture_registry() { return texture_registry_; }
 
   const Counter& frame_count() const { return frame_count_; }
@@ -122,12 +136,50 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // Shared so that the statistics can be read from other threads.
+  const std::shared_ptr<FrameStatistics>& frame_statistics() const {
+    return frame_statistics_;
+  }
+
+  // The task runner on which large sibling subtrees of layer trees are
+  // prerolled in parallel. Layer trees are prerolled serially if this is null.
+  void SetConcurrentPrerollTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    concurrent_preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* concurrent_preroll_task_runner() const {
+    return concurrent_preroll_task_runner_.get();
+  }
+
+  // The largest factor by which backdrop blurs may be downsampled.
+  void SetBackdropBlurMaxDownsampling(int max_downsampling) {
+    backdrop_blur_max_downsampling_ = max_downsampling;
+  }
+
+  int backdrop_blur_max_downsampling() const {
+    return backdrop_blur_max_downsampling_;
+  }
+
+  // Whether the paint time of every layer is measured in instrumented frames.
+  // Off by default, as timing every layer slows down painting.
+  void SetLayerPaintTimesEnabled(bool enabled) {
+    layer_paint_times_enabled_ = enabled;
+  }
+
+  bool layer_paint_times_enabled() const { return layer_paint_times_enabled_; }
+
  private:
   RasterCache raster_cache_;
+  ShadowCache shadow_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  std::shared_ptr<FrameStatistics> frame_statistics_;
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_preroll_task_runner_;
+  int backdrop_blur_max_downsampling_ = 1;
+  bool layer_paint_times_enabled_ = false;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
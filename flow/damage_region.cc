@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_region.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace flutter {
+
+namespace {
+
+int64_t Area(const SkIRect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+// The area that is repainted needlessly when two non-overlapping rects are
+// replaced by their bounds.
+int64_t MergeCost(const SkIRect& a, const SkIRect& b) {
+  SkIRect bounds = a;
+  bounds.join(b);
+  return Area(bounds) - Area(a) - Area(b);
+}
+
+// Overlapping rects must be merged to keep the region free of overlaps. Others
+// are merged if that repaints at most a quarter more than the rects
+// themselves.
+bool ShouldMerge(const SkIRect& a, const SkIRect& b) {
+  if (SkIRect::Intersects(a, b)) {
+    return true;
+  }
+  return MergeCost(a, b) * 4 <= Area(a) + Area(b);
+}
+
+}  // namespace
+
+DamageRegion::DamageRegion(size_t max_rects)
+    : max_rects_(std::max<size_t>(max_rects, 1)) {}
+
+void DamageRegion::AddRect(const SkIRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  InsertMerged(rect);
+
+  while (rects_.size() > max_rects_) {
+    size_t first = 0;
+    size_t second = 1;
+    int64_t min_cost = std::numeric_limits<int64_t>::max();
+    for (size_t i = 0; i < rects_.size(); i++) {
+      for (size_t j = i + 1; j < rects_.size(); j++) {
+        const int64_t cost = MergeCost(rects_[i], rects_[j]);
+        if (cost < min_cost) {
+          min_cost = cost;
+          first = i;
+          second = j;
+        }
+      }
+    }
+    SkIRect merged = rects_[first];
+    merged.join(rects_[second]);
+    rects_.erase(rects_.begin() + second);
+    rects_.erase(rects_.begin() + first);
+    InsertMerged(merged);
+  }
+}
+
+void DamageRegion::AddRegion(const DamageRegion& region) {
+  for (const auto& rect : region.rects_) {
+    AddRect(rect);
+  }
+}
+
+void DamageRegion::InsertMerged(SkIRect rect) {
+  // Merging grows the rect, which may make it overlap rects it was previously
+  // kept apart from.
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto i = rects_.begin(); i != rects_.end();) {
+      if (ShouldMerge(rect, *i)) {
+        rect.join(*i);
+        i = rects_.erase(i);
+        merged = true;
+      } else {
+        ++i;
+      }
+    }
+  }
+  rects_.push_back(rect);
+}
+
+void DamageRegion::Intersect(const SkIRect& clip) {
+  for (auto i = rects_.begin(); i != rects_.end();) {
+    if (i->intersect(clip)) {
+      ++i;
+    } else {
+      i = rects_.erase(i);
+    }
+  }
+}
+
+bool DamageRegion::Intersects(const SkIRect& rect) const {
+  return std::any_of(rects_.begin(), rects_.end(), [&rect](const SkIRect& r) {
+    return SkIRect::Intersects(r, rect);
+  });
+}
+
+SkIRect DamageRegion::GetBounds() const {
+  SkIRect bounds = SkIRect::MakeEmpty();
+  for (const auto& rect : rects_) {
+    bounds.join(rect);
+  }
+  return bounds;
+}
+
+}  // namespace flutter
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DAMAGE_REGION_H_
+#define FLUTTER_FLOW_DAMAGE_REGION_H_
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+// A region of the screen that needs to be repainted, represented as a bounded
+// list of non-overlapping rects.
+//
+// Rects that overlap are merged into their bounds. So are rects that are close
+// enough that repainting the gap between them is cheaper than tracking them
+// separately. When there are more rects than allowed, the pair whose bounds
+// add the least area is merged until the region fits.
+class DamageRegion {
+ public:
+  static constexpr size_t kDefaultMaxRects = 8;
+
+  explicit DamageRegion(size_t max_rects = kDefaultMaxRects);
+
+  void AddRect(const SkIRect& rect);
+
+  void AddRegion(const DamageRegion& region);
+
+  // Clips every rect of the region to the given rect.
+  void Intersect(const SkIRect& clip);
+
+  bool Intersects(const SkIRect& rect) const;
+
+  bool IsEmpty() const { return rects_.empty(); }
+
+  SkIRect GetBounds() const;
+
+  const std::vector<SkIRect>& rects() const { return rects_; }
+
+ private:
+  size_t max_rects_;
+  std::vector<SkIRect> rects_;
+
+  // Adds the rect after merging it with every rect it should be merged with.
+  void InsertMerged(SkIRect rect);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DAMAGE_REGION_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/damage_region.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DamageRegionTest, IgnoresEmptyRects) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeEmpty());
+  region.AddRect(SkIRect::MakeLTRB(10, 10, 10, 20));
+  ASSERT_TRUE(region.IsEmpty());
+  ASSERT_TRUE(region.GetBounds().isEmpty());
+}
+
+TEST(DamageRegionTest, KeepsDistantRectsApart) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeLTRB(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeLTRB(990, 990, 1000, 1000));
+
+  ASSERT_EQ(region.rects().size(), 2u);
+  ASSERT_EQ(region.rects()[0], SkIRect::MakeLTRB(0, 0, 10, 10));
+  ASSERT_EQ(region.rects()[1], SkIRect::MakeLTRB(990, 990, 1000, 1000));
+  ASSERT_EQ(region.GetBounds(), SkIRect::MakeLTRB(0, 0, 1000, 1000));
+  ASSERT_TRUE(region.Intersects(SkIRect::MakeLTRB(5, 5, 15, 15)));
+  ASSERT_FALSE(region.Intersects(SkIRect::MakeLTRB(10, 10, 990, 990)));
+}
+
+TEST(DamageRegionTest, MergesOverlappingRects) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeLTRB(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeLTRB(100, 0, 110, 10));
+  // Overlaps both rects, which end up merged into one.
+  region.AddRect(SkIRect::MakeLTRB(5, 5, 105, 100));
+
+  ASSERT_EQ(region.rects().size(), 1u);
+  ASSERT_EQ(region.rects()[0], SkIRect::MakeLTRB(0, 0, 110, 100));
+}
+
+TEST(DamageRegionTest, MergesRectsWhenTheGapIsCheapToRepaint) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeLTRB(0, 0, 100, 100));
+  // Adjacent.
+  region.AddRect(SkIRect::MakeLTRB(100, 0, 200, 100));
+  ASSERT_EQ(region.rects().size(), 1u);
+
+  // A small gap.
+  region.AddRect(SkIRect::MakeLTRB(0, 110, 200, 200));
+  ASSERT_EQ(region.rects().size(), 1u);
+  ASSERT_EQ(region.rects()[0], SkIRect::MakeLTRB(0, 0, 200, 200));
+
+  // A large gap.
+  region.AddRect(SkIRect::MakeLTRB(0, 400, 200, 500));
+  ASSERT_EQ(region.rects().size(), 2u);
+}
+
+TEST(DamageRegionTest, MergesCheapestPairWhenFull) {
+  DamageRegion region(2);
+  region.AddRect(SkIRect::MakeLTRB(0, 0, 10, 10));
+  region.AddRect(SkIRect::MakeLTRB(500, 500, 510, 510));
+  region.AddRect(SkIRect::MakeLTRB(30, 0, 40, 10));
+
+  ASSERT_EQ(region.rects().size(), 2u);
+  ASSERT_EQ(region.rects()[0], SkIRect::MakeLTRB(500, 500, 510, 510));
+  ASSERT_EQ(region.rects()[1], SkIRect::MakeLTRB(0, 0, 40, 10));
+}
+
+TEST(DamageRegionTest, IntersectDropsRectsOutsideTheClip) {
+  DamageRegion region;
+  region.AddRect(SkIRect::MakeLTRB(-50, -50, 10, 10));
+  region.AddRect(SkIRect::MakeLTRB(500, 500, 600, 600));
+  region.AddRect(SkIRect::MakeLTRB(2000, 0, 2010, 10));
+
+  region.Intersect(SkIRect::MakeWH(550, 1000));
+  ASSERT_EQ(region.rects().size(), 2u);
+  ASSERT_EQ(region.rects()[0], SkIRect::MakeLTRB(0, 0, 10, 10));
+  ASSERT_EQ(region.rects()[1], SkIRect::MakeLTRB(500, 500, 550, 600));
+}
+
+TEST(DamageRegionTest, AddRegion) {
+  DamageRegion a;
+  a.AddRect(SkIRect::MakeLTRB(0, 0, 10, 10));
+  DamageRegion b;
+  b.AddRect(SkIRect::MakeLTRB(100, 100, 110, 110));
+  b.AddRect(SkIRect::MakeLTRB(5, 5, 15, 15));
+
+  a.AddRegion(b);
+  ASSERT_EQ(a.rects().size(), 2u);
+  ASSERT_EQ(a.GetBounds(), SkIRect::MakeLTRB(0, 0, 110, 110));
+}
+
+}  // namespace testing
+}  // namespace flutter
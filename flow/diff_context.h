@@ -7,6 +7,7 @@
 
 #include <map>
 #include <vector>
+#include "flutter/flow/damage_region.h"
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
@@ -21,6 +22,9 @@ class Layer;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
 // area that is going to be painted to in back buffer (buffer_damage).
+//
+// Both areas are available as a list of non-overlapping rects and as the
+// bounds of these rects, for consumers that can only handle a single rect.
 struct Damage {
   // This is the damage between current and previous frame;
   // If embedder supports partial update, this is the region that needs to be
@@ -34,6 +38,12 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // The rects that make up frame_damage.
+  std::vector<SkIRect> frame_damage_rects;
+
+  // The rects that make up buffer_damage.
+  std::vector<SkIRect> buffer_damage_rects;
 };
 
 // Layer Unique Id to PaintRegion
@@ -119,6 +129,11 @@ class DiffContext {
   // current framebuffer
   Damage ComputeDamage(const SkIRect& additional_damage) const;
 
+  // Whether anything painted so far in this frame changed within the rect,
+  // which is in screen coordinates. Layers can use this to tell whether the
+  // backdrop underneath them is the same as in the previous frame.
+  bool HasDamage(const SkIRect& rect) const { return damage_.Intersects(rect); }
+
   double frame_device_pixel_ratio() const { return frame_device_pixel_ratio_; };
 
   // Adds the region to current damage. Used for removed layers, where instead
@@ -185,7 +200,7 @@ class DiffContext {
   double frame_device_pixel_ratio_;
   std::vector<State> state_stack_;
 
-  SkRect damage_ = SkRect::MakeEmpty();
+  DamageRegion damage_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
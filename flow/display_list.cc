@@ -2,11 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string_view>
 #include <type_traits>
 
 #include "flutter/flow/display_list.h"
 #include "flutter/flow/display_list_canvas.h"
 #include "flutter/flow/display_list_utils.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 
 #include "third_party/skia/include/core/SkImageFilter.h"
@@ -36,6 +38,10 @@ const SkSamplingOptions DisplayList::CubicSampling =
 //
 // Only a DLOp that wants to do a deep compare needs to override the
 // DLOp::equals() method and return a value of kEqual or kNotEqual.
+//
+// The content hash of a DisplayList follows the same rules. Ops are hashed
+// by their bytes, so that the sk_sp<> references they hold are hashed by
+// identity, unless they override DLOp::hash() to match a deep compare.
 enum class DisplayListCompare {
   // The Op is deferring comparisons to a bulk memcmp performed lazily
   // across all bulk-comparable ops.
@@ -67,8 +73,19 @@ struct DLOp {
   DisplayListCompare equals(const DLOp* other) const {
     return DisplayListCompare::kUseBulkCompare;
   }
+
+  // Returns false if the Op should be hashed by its bytes.
+  bool hash(size_t* result) const { return false; }
 };
 
+// Paths that are equal have the same points, verbs and fill type.
+static size_t HashPath(const SkPath& path) {
+  const SkRect& bounds = path.getBounds();
+  return fml::HashCombine(path.countPoints(), path.countVerbs(),
+                          static_cast<int>(path.getFillType()), bounds.fLeft,
+                          bounds.fTop, bounds.fRight, bounds.fBottom);
+}
+
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
 #define DEFINE_SET_BOOL_OP(name)                             \
   struct Set##name##Op final : DLOp {                        \
@@ -406,6 +423,11 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
       return is_aa == other->is_aa && path == other->path                \
                  ? DisplayListCompare::kEqual                            \
                  : DisplayListCompare::kNotEqual;                        \
+    }                                                                    \
+                                                                         \
+    bool hash(size_t* result) const {                                    \
+      *result = fml::HashCombine(is_aa, HashPath(path));                 \
+      return true;                                                       \
     }                                                                    \
   };
 DEFINE_CLIP_PATH_OP(Intersect)
@@ -472,6 +494,11 @@ struct DrawPathOp final : DLOp {
     return path == other->path ? DisplayListCompare::kEqual
                                : DisplayListCompare::kNotEqual;
   }
+
+  bool hash(size_t* result) const {
+    *result = HashPath(path);
+    return true;
+  }
 };
 
 // The common data is a 4 byte header with an unused 4 bytes
@@ -777,6 +804,19 @@ struct DrawDisplayListOp final : DLOp {
   void dispatch(Dispatcher& dispatcher) const {
     dispatcher.drawDisplayList(display_list);
   }
+
+  // Nested display lists are re-recorded along with the one that draws them,
+  // so they are compared by content.
+  DisplayListCompare equals(const DrawDisplayListOp* other) const {
+    return display_list->Equals(*other->display_list)
+               ? DisplayListCompare::kEqual
+               : DisplayListCompare::kNotEqual;
+  }
+
+  bool hash(size_t* result) const {
+    *result = display_list->content_hash();
+    return true;
+  }
 };
 
 // 4 byte header + 8 payload bytes + an aligned pointer take 24 bytes
@@ -942,8 +982,40 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
-void DisplayList::RenderTo(SkCanvas* canvas) const {
-  DisplayListCanvasDispatcher dispatcher(canvas);
+static size_t HashOps(uint8_t* ptr, uint8_t* end) {
+  size_t hash = fml::HashCombine();
+  while (ptr < end) {
+    auto op = (const DLOp*)ptr;
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    size_t op_hash;
+    bool has_op_hash;
+    switch (op->type) {
+#define DL_OP_HASH(name)                                            \
+  case DisplayListOpType::k##name:                                  \
+    has_op_hash = static_cast<const name##Op*>(op)->hash(&op_hash); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASH)
+
+#undef DL_OP_HASH
+
+      default:
+        FML_DCHECK(false);
+        return hash;
+    }
+    if (!has_op_hash) {
+      op_hash = std::hash<std::string_view>{}(std::string_view(
+          reinterpret_cast<const char*>(op), ptr - (const uint8_t*)op));
+    }
+    hash = fml::HashCombine(hash, op_hash);
+  }
+  return hash;
+}
+
+void DisplayList::RenderTo(SkCanvas* canvas,
+                           ShadowCache* shadow_cache) const {
+  DisplayListCanvasDispatcher dispatcher(canvas, shadow_cache);
   Dispatch(dispatcher);
 }
 
@@ -965,7 +1037,8 @@ DisplayList::DisplayList(uint8_t* ptr,
       used_(used),
       op_count_(op_count),
       bounds_({0, 0, -1, -1}),
-      bounds_cull_(cull) {
+      bounds_cull_(cull),
+      content_hash_(0) {
   static std::atomic<uint32_t> nextID{1};
   do {
     unique_id_ = nextID.fetch_add(+1, std::memory_order_relaxed);
@@ -976,6 +1049,10 @@ DisplayList::~DisplayList() {
   DisposeOps(ptr_, ptr_ + used_);
 }
 
+void DisplayList::ComputeContentHash() const {
+  content_hash_ = HashOps(ptr_, ptr_ + used_);
+}
+
 #define DL_BUILDER_PAGE 4096
 
 // CopyV(dst, src,n, src,n, ...) copies any number of typed srcs into dst.
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
 #define FLUTTER_FLOW_DISPLAY_LIST_H_
 
+#include <mutex>
+
 #include "third_party/skia/include/core/SkBlender.h"
 #include "third_party/skia/include/core/SkBlurTypes.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -156,6 +158,7 @@ enum class DisplayListOpType { FOR_EACH_DISPLAY_LIST_OP(DL_OP_TO_ENUM_VALUE) };
 
 class Dispatcher;
 class DisplayListBuilder;
+class ShadowCache;
 
 // The base class that contains a sequence of rendering operations
 // for dispatch to a Dispatcher. These objects must be instantiated
@@ -173,24 +176,37 @@ class DisplayList : public SkRefCnt {
         op_count_(0),
         unique_id_(0),
         bounds_({0, 0, 0, 0}),
-        bounds_cull_({0, 0, 0, 0}) {}
+        bounds_cull_({0, 0, 0, 0}),
+        content_hash_(0) {}
 
   ~DisplayList();
 
   void Dispatch(Dispatcher& ctx) const { Dispatch(ctx, ptr_, ptr_ + used_); }
 
-  void RenderTo(SkCanvas* canvas) const;
+  void RenderTo(SkCanvas* canvas, ShadowCache* shadow_cache = nullptr) const;
 
   size_t bytes() const { return used_; }
   int op_count() const { return op_count_; }
   uint32_t unique_id() const { return unique_id_; }
 
+  // A hash of the operations of the display list, which is the same for
+  // display lists that are |Equals| even if they were recorded separately.
+  // Different display lists may have the same hash. It is computed on first
+  // use, since it walks all the operations.
+  size_t content_hash() const {
+    std::call_once(content_hash_once_, [this] { ComputeContentHash(); });
+    return content_hash_;
+  }
+
   const SkRect& bounds() {
-    if (bounds_.width() < 0.0) {
-      // ComputeBounds() will leave the variable with a
-      // non-negative width and height
-      ComputeBounds();
-    }
+    // Layers sharing a display list may be prerolled on different threads.
+    std::call_once(bounds_once_, [this] {
+      if (bounds_.width() < 0.0) {
+        // ComputeBounds() will leave the variable with a
+        // non-negative width and height
+        ComputeBounds();
+      }
+    });
     return bounds_;
   }
 
@@ -205,11 +221,16 @@ class DisplayList : public SkRefCnt {
 
   uint32_t unique_id_;
   SkRect bounds_;
+  std::once_flag bounds_once_;
 
   // Only used for drawPaint() and drawColor()
   SkRect bounds_cull_;
 
+  mutable size_t content_hash_;
+  mutable std::once_flag content_hash_once_;
+
   void ComputeBounds();
+  void ComputeContentHash() const;
   void Dispatch(Dispatcher& ctx, uint8_t* ptr, uint8_t* end) const;
 
   friend class DisplayListBuilder;
@@ -163,7 +163,7 @@ void DisplayListCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
   int save_count = canvas_->save();
   {
-    DisplayListCanvasDispatcher dispatcher(canvas_);
+    DisplayListCanvasDispatcher dispatcher(canvas_, shadow_cache_);
     display_list->Dispatch(dispatcher);
   }
   canvas_->restoreToCount(save_count);
@@ -179,7 +179,7 @@ void DisplayListCanvasDispatcher::drawShadow(const SkPath& path,
                                              bool occludes,
                                              SkScalar dpr) {
   flutter::PhysicalShapeLayer::DrawShadow(canvas_, path, color, elevation,
-                                          occludes, dpr);
+                                          occludes, dpr, shadow_cache_);
 }
 
 DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
@@ -192,7 +192,7 @@ sk_sp<DisplayList> DisplayListCanvasRecorder::Build() {
   return display_list;
 }
 
-void DisplayListCanvasRecorder::didConcat44(const SkM44& m44) {
+void DisplayListCanvasRecorder::RecordTransform(const SkM44& m44) {
   SkMatrix m = m44.asM33();
   if (m.hasPerspective()) {
     builder_->transform3x3(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7],
@@ -201,11 +201,28 @@ void DisplayListCanvasRecorder::didConcat44(const SkM44& m44) {
     builder_->transform2x3(m[0], m[1], m[2], m[3], m[4], m[5]);
   }
 }
+void DisplayListCanvasRecorder::didConcat44(const SkM44& m44) {
+  RecordTransform(m44);
+  UpdateMatrix();
+}
+void DisplayListCanvasRecorder::didSetM44(const SkM44& m44) {
+  // The display list may be drawn under another transform, such as when it is
+  // nested in another display list, so the new matrix is recorded relative to
+  // the one it replaces. Nothing is drawn under a singular matrix, and there
+  // is no relative transform out of one.
+  SkM44 inverse;
+  if (matrix_.invert(&inverse)) {
+    RecordTransform(inverse * m44);
+  }
+  UpdateMatrix();
+}
 void DisplayListCanvasRecorder::didTranslate(SkScalar tx, SkScalar ty) {
   builder_->translate(tx, ty);
+  UpdateMatrix();
 }
 void DisplayListCanvasRecorder::didScale(SkScalar sx, SkScalar sy) {
   builder_->scale(sx, sy);
+  UpdateMatrix();
 }
 
 void DisplayListCanvasRecorder::onClipRect(const SkRect& rect,
@@ -242,6 +259,7 @@ SkCanvas::SaveLayerStrategy DisplayListCanvasRecorder::getSaveLayerStrategy(
 }
 void DisplayListCanvasRecorder::didRestore() {
   builder_->restore();
+  UpdateMatrix();
 }
 
 void DisplayListCanvasRecorder::onDrawPaint(const SkPaint& paint) {
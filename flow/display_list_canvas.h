@@ -27,7 +27,9 @@ namespace flutter {
 class DisplayListCanvasDispatcher : public virtual Dispatcher,
                                     public SkPaintDispatchHelper {
  public:
-  DisplayListCanvasDispatcher(SkCanvas* canvas) : canvas_(canvas) {}
+  DisplayListCanvasDispatcher(SkCanvas* canvas,
+                              ShadowCache* shadow_cache = nullptr)
+      : canvas_(canvas), shadow_cache_(shadow_cache) {}
 
   void save() override;
   void restore() override;
@@ -115,6 +117,7 @@ class DisplayListCanvasDispatcher : public virtual Dispatcher,
 
  private:
   SkCanvas* canvas_;
+  ShadowCache* shadow_cache_;
 };
 
 // Receives all methods on SkCanvas and sends them to a DisplayListBuilder
@@ -129,7 +132,7 @@ class DisplayListCanvasRecorder
   sk_sp<DisplayList> Build();
 
   void didConcat44(const SkM44&) override;
-  void didSetM44(const SkM44&) override { FML_DCHECK(false); }
+  void didSetM44(const SkM44&) override;
   void didTranslate(SkScalar, SkScalar) override;
   void didScale(SkScalar, SkScalar) override;
 
@@ -252,6 +255,11 @@ class DisplayListCanvasRecorder
 
  private:
   sk_sp<DisplayListBuilder> builder_;
+  // The matrix of the canvas as of the last recorded transform.
+  SkM44 matrix_;
+
+  void RecordTransform(const SkM44& m44);
+  void UpdateMatrix() { matrix_ = getLocalToDevice(); }
 
   // Mask bits for the various attributes that might be needed for a given
   // operation.
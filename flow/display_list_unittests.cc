@@ -4,6 +4,7 @@
 
 #include "flutter/flow/display_list_canvas.h"
 
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPath.h"
@@ -732,6 +733,35 @@ TEST(DisplayList, SingleOpDisplayListsRecapturedAreEqual) {
   }
 }
 
+TEST(DisplayList, SingleOpDisplayListsRecapturedHaveSameContentHash) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = group.variants[i].Build();
+      DisplayListBuilder builder;
+      dl->Dispatch(builder);
+      sk_sp<DisplayList> copy = builder.Build();
+      auto desc =
+          group.op_name + "(variant " + std::to_string(i + 1) + " == copy)";
+      ASSERT_EQ(copy->content_hash(), dl->content_hash()) << desc;
+    }
+  }
+}
+
+TEST(DisplayList, NestedDisplayListsAreComparedByContent) {
+  auto build = [](sk_sp<DisplayList> nested) {
+    DisplayListBuilder builder;
+    builder.drawDisplayList(nested);
+    return builder.Build();
+  };
+  sk_sp<DisplayList> dl1 = build(MakeTestDisplayList(20, 20, SK_ColorGREEN));
+  sk_sp<DisplayList> dl2 = build(MakeTestDisplayList(20, 20, SK_ColorGREEN));
+  sk_sp<DisplayList> dl3 = build(MakeTestDisplayList(20, 20, SK_ColorBLUE));
+  ASSERT_TRUE(dl1->Equals(*dl2));
+  ASSERT_EQ(dl1->content_hash(), dl2->content_hash());
+  ASSERT_FALSE(dl1->Equals(*dl3));
+  ASSERT_NE(dl1->content_hash(), dl3->content_hash());
+}
+
 TEST(DisplayList, SingleOpDisplayListsRecapturedViaSkCanvasAreEqual) {
   for (auto& group : allGroups) {
     for (size_t i = 0; i < group.variants.size(); i++) {
@@ -863,5 +893,28 @@ TEST(DisplayList, DisplayListsWithVaryingOpComparisons) {
   }
 }
 
+TEST(DisplayList, SetMatrixIsRecordedRelativeToTheMatrixItReplaces) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(50, 50));
+  recorder.translate(10.5f, 5.25f);
+  recorder.setMatrix(SkMatrix::Translate(11, 5));
+  recorder.drawRect(SkRect::MakeWH(4, 4), SkPaint());
+  sk_sp<DisplayList> display_list = recorder.Build();
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(50, 50);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorTRANSPARENT);
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(bitmap.getColor(11, 5), SK_ColorBLACK);
+  EXPECT_EQ(bitmap.getColor(10, 5), SK_ColorTRANSPARENT);
+
+  // Drawn under another transform, the rect moves with it.
+  canvas.clear(SK_ColorTRANSPARENT);
+  canvas.translate(20, 30);
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(bitmap.getColor(31, 35), SK_ColorBLACK);
+  EXPECT_EQ(bitmap.getColor(11, 5), SK_ColorTRANSPARENT);
+}
+
 }  // namespace testing
 }  // namespace flutter
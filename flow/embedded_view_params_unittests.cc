@@ -94,5 +94,20 @@ TEST(EmbeddedViewParams,
   ASSERT_TRUE(SkScalarNearlyEqual(rect.height(), 3));
 }
 
+TEST(EmbeddedViewParams, ComparesMutatorsStacks) {
+  MutatorsStack stack;
+  SkMatrix matrix = SkMatrix::Translate(1, 1);
+  stack.PushTransform(matrix);
+  stack.PushOpacity(100);
+
+  EmbeddedViewParams params(matrix, SkSize::Make(1, 1), stack);
+  EmbeddedViewParams copy(params);
+  ASSERT_TRUE(params == copy);
+
+  stack.PushClipRect(SkRect::MakeWH(1, 1));
+  EmbeddedViewParams clipped(matrix, SkSize::Make(1, 1), stack);
+  ASSERT_FALSE(params == clipped);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,8 +4,34 @@
 
 #include "flutter/flow/embedded_views.h"
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+
 namespace flutter {
 
+namespace {
+
+// The hash of a mutators stack is a polynomial of the hashes of its mutators.
+// The multiplier is odd, so it has a multiplicative inverse that undoes a push
+// when the mutator is popped.
+constexpr size_t kHashMultiplier = static_cast<size_t>(0x9e3779b97f4a7c15ull);
+
+constexpr size_t InverseOf(size_t odd) {
+  // Each Newton iteration doubles the number of correct low bits, starting
+  // from the three bits of an odd number, which is its own inverse modulo 8.
+  size_t inverse = odd;
+  for (int i = 0; i < 5; i++) {
+    inverse *= 2 - odd * inverse;
+  }
+  return inverse;
+}
+
+constexpr size_t kHashMultiplierInverse = InverseOf(kHashMultiplier);
+
+static_assert(kHashMultiplier * kHashMultiplierInverse == 1);
+
+}  // namespace
+
 void ExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame,
@@ -13,53 +39,173 @@ void ExternalViewEmbedder::SubmitFrame(
   frame->Submit();
 };
 
+size_t Mutator::Hash() const {
+  switch (type_) {
+    case clip_rect:
+      return fml::HashCombine(type_, rect_.fLeft, rect_.fTop, rect_.fRight,
+                              rect_.fBottom);
+    case clip_rrect: {
+      const SkRect& rect = rrect_.rect();
+      const SkVector& upper_left = rrect_.radii(SkRRect::kUpperLeft_Corner);
+      const SkVector& upper_right = rrect_.radii(SkRRect::kUpperRight_Corner);
+      const SkVector& lower_right = rrect_.radii(SkRRect::kLowerRight_Corner);
+      const SkVector& lower_left = rrect_.radii(SkRRect::kLowerLeft_Corner);
+      return fml::HashCombine(
+          type_, rect.fLeft, rect.fTop, rect.fRight, rect.fBottom,
+          upper_left.fX, upper_left.fY, upper_right.fX, upper_right.fY,
+          lower_right.fX, lower_right.fY, lower_left.fX, lower_left.fY);
+    }
+    case clip_path: {
+      const SkRect& bounds = path_.getBounds();
+      return fml::HashCombine(type_, path_.getFillType(), path_.countPoints(),
+                              path_.countVerbs(), bounds.fLeft, bounds.fTop,
+                              bounds.fRight, bounds.fBottom);
+    }
+    case transform: {
+      size_t hash = fml::HashCombine(type_);
+      for (int i = 0; i < 9; i++) {
+        fml::HashCombineSeed(hash, matrix_[i]);
+      }
+      return hash;
+    }
+    case opacity:
+      return fml::HashCombine(type_, alpha_);
+  }
+  return fml::HashCombine(type_);
+}
+
+MutatorsStack::MutatorsStack()
+    : data_(reinterpret_cast<Mutator*>(inline_storage_)) {}
+
+MutatorsStack::MutatorsStack(const MutatorsStack& other) : MutatorsStack() {
+  *this = other;
+}
+
+MutatorsStack::MutatorsStack(MutatorsStack&& other) noexcept
+    : MutatorsStack() {
+  *this = std::move(other);
+}
+
+MutatorsStack::~MutatorsStack() {
+  Clear();
+  if (!IsInline()) {
+    ::operator delete(data_);
+  }
+}
+
+MutatorsStack& MutatorsStack::operator=(const MutatorsStack& other) {
+  if (this == &other) {
+    return *this;
+  }
+  Clear();
+  Reserve(other.size_);
+  for (size_t i = 0; i < other.size_; i++) {
+    new (data_ + i) Mutator(other.data_[i]);
+  }
+  size_ = other.size_;
+  hash_ = other.hash_;
+  return *this;
+}
+
+MutatorsStack& MutatorsStack::operator=(MutatorsStack&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  Clear();
+  if (!other.IsInline()) {
+    // Take over the heap storage of the other stack.
+    if (!IsInline()) {
+      ::operator delete(data_);
+    }
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    hash_ = other.hash_;
+    other.data_ = reinterpret_cast<Mutator*>(other.inline_storage_);
+    other.size_ = 0;
+    other.capacity_ = kInlineCapacity;
+    other.hash_ = 0;
+    return *this;
+  }
+  for (size_t i = 0; i < other.size_; i++) {
+    new (data_ + i) Mutator(std::move(other.data_[i]));
+  }
+  size_ = other.size_;
+  hash_ = other.hash_;
+  other.Clear();
+  return *this;
+}
+
+void MutatorsStack::Reserve(size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+  Mutator* data =
+      static_cast<Mutator*>(::operator new(capacity * sizeof(Mutator)));
+  for (size_t i = 0; i < size_; i++) {
+    new (data + i) Mutator(std::move(data_[i]));
+    data_[i].~Mutator();
+  }
+  if (!IsInline()) {
+    ::operator delete(data_);
+  }
+  data_ = data;
+  capacity_ = capacity;
+}
+
+void MutatorsStack::Clear() {
+  for (size_t i = 0; i < size_; i++) {
+    data_[i].~Mutator();
+  }
+  size_ = 0;
+  hash_ = 0;
+}
+
+void MutatorsStack::AddToHash(const Mutator& mutator) {
+  hash_ = hash_ * kHashMultiplier + mutator.Hash();
+}
+
 void MutatorsStack::PushClipRect(const SkRect& rect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rect);
-  vector_.push_back(element);
+  Push(rect);
 };
 
 void MutatorsStack::PushClipRRect(const SkRRect& rrect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rrect);
-  vector_.push_back(element);
+  Push(rrect);
 };
 
 void MutatorsStack::PushClipPath(const SkPath& path) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(path);
-  vector_.push_back(element);
+  Push(path);
 };
 
 void MutatorsStack::PushTransform(const SkMatrix& matrix) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(matrix);
-  vector_.push_back(element);
+  Push(matrix);
 };
 
 void MutatorsStack::PushOpacity(const int& alpha) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(alpha);
-  vector_.push_back(element);
+  Push(alpha);
 };
 
 void MutatorsStack::Pop() {
-  vector_.pop_back();
+  FML_DCHECK(size_ > 0);
+  size_--;
+  hash_ = (hash_ - data_[size_].Hash()) * kHashMultiplierInverse;
+  data_[size_].~Mutator();
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Top() const {
-  return vector_.rend();
+MutatorsStack::const_reverse_iterator MutatorsStack::Top() const {
+  return const_reverse_iterator(Begin());
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Bottom() const {
-  return vector_.rbegin();
+MutatorsStack::const_reverse_iterator MutatorsStack::Bottom() const {
+  return const_reverse_iterator(End());
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator
-MutatorsStack::Begin() const {
-  return vector_.begin();
+MutatorsStack::const_iterator MutatorsStack::Begin() const {
+  return data_;
 };
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
-    const {
-  return vector_.end();
+MutatorsStack::const_iterator MutatorsStack::End() const {
+  return data_ + size_;
 };
 
 bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <iterator>
+#include <new>
+#include <utility>
 #include <vector>
 
 #include "flutter/flow/surface_frame.h"
@@ -30,43 +33,46 @@ enum MutatorType { clip_rect, clip_rrect, clip_path, transform, opacity };
 // Each `type` is paired with an object that supports the mutation. For example,
 // if the `type` is clip_rect, `rect()` is used the represent the rect to be
 // clipped. One mutation object must only contain one type of mutation.
+//
+// Mutators are values. Copying one never allocates: the path of a clip_path
+// mutator shares its storage with the path it was copied from.
 class Mutator {
  public:
-  Mutator(const Mutator& other) {
-    type_ = other.type_;
-    switch (other.type_) {
-      case clip_rect:
-        rect_ = other.rect_;
-        break;
-      case clip_rrect:
-        rrect_ = other.rrect_;
-        break;
-      case clip_path:
-        path_ = new SkPath(*other.path_);
-        break;
-      case transform:
-        matrix_ = other.matrix_;
-        break;
-      case opacity:
-        alpha_ = other.alpha_;
-        break;
-      default:
-        break;
-    }
+  Mutator(const Mutator& other) : type_(other.type_) { CopyValue(other); }
+
+  Mutator(Mutator&& other) noexcept : type_(other.type_) {
+    MoveValue(other);
   }
 
   explicit Mutator(const SkRect& rect) : type_(clip_rect), rect_(rect) {}
   explicit Mutator(const SkRRect& rrect) : type_(clip_rrect), rrect_(rrect) {}
-  explicit Mutator(const SkPath& path)
-      : type_(clip_path), path_(new SkPath(path)) {}
+  explicit Mutator(const SkPath& path) : type_(clip_path), path_(path) {}
   explicit Mutator(const SkMatrix& matrix)
       : type_(transform), matrix_(matrix) {}
   explicit Mutator(const int& alpha) : type_(opacity), alpha_(alpha) {}
 
+  Mutator& operator=(const Mutator& other) {
+    if (this != &other) {
+      DestroyValue();
+      type_ = other.type_;
+      CopyValue(other);
+    }
+    return *this;
+  }
+
+  Mutator& operator=(Mutator&& other) noexcept {
+    if (this != &other) {
+      DestroyValue();
+      type_ = other.type_;
+      MoveValue(other);
+    }
+    return *this;
+  }
+
   const MutatorType& GetType() const { return type_; }
   const SkRect& GetRect() const { return rect_; }
   const SkRRect& GetRRect() const { return rrect_; }
-  const SkPath& GetPath() const { return *path_; }
+  const SkPath& GetPath() const { return path_; }
   const SkMatrix& GetMatrix() const { return matrix_; }
   const int& GetAlpha() const { return alpha_; }
   float GetAlphaFloat() const { return (alpha_ / 255.0); }
@@ -81,7 +87,7 @@ class Mutator {
       case clip_rrect:
         return rrect_ == other.rrect_;
       case clip_path:
-        return *path_ == *other.path_;
+        return path_ == other.path_;
       case transform:
         return matrix_ == other.matrix_;
       case opacity:
@@ -93,24 +99,62 @@ class Mutator {
 
   bool operator!=(const Mutator& other) const { return !operator==(other); }
 
-  bool IsClipType() {
+  // Returns a hash of the mutation that is consistent with `operator==`.
+  //
+  // The hash of a clip_path mutator only accounts for the size and bounds of
+  // the path so that it doesn't have to walk its points.
+  size_t Hash() const;
+
+  bool IsClipType() const {
     return type_ == clip_rect || type_ == clip_rrect || type_ == clip_path;
   }
 
-  ~Mutator() {
+  ~Mutator() { DestroyValue(); }
+
+ private:
+  void CopyValue(const Mutator& other) {
+    switch (other.type_) {
+      case clip_rect:
+        rect_ = other.rect_;
+        break;
+      case clip_rrect:
+        rrect_ = other.rrect_;
+        break;
+      case clip_path:
+        new (&path_) SkPath(other.path_);
+        break;
+      case transform:
+        matrix_ = other.matrix_;
+        break;
+      case opacity:
+        alpha_ = other.alpha_;
+        break;
+      default:
+        break;
+    }
+  }
+
+  void MoveValue(Mutator& other) {
+    if (other.type_ == clip_path) {
+      new (&path_) SkPath(std::move(other.path_));
+    } else {
+      CopyValue(other);
+    }
+  }
+
+  void DestroyValue() {
     if (type_ == clip_path) {
-      delete path_;
+      path_.~SkPath();
     }
-  };
+  }
 
- private:
   MutatorType type_;
 
   union {
     SkRect rect_;
     SkRRect rrect_;
     SkMatrix matrix_;
-    SkPath* path_;
+    SkPath path_;
     int alpha_;
   };
 
@@ -125,9 +169,28 @@ class Mutator {
 // For example consider the following stack: [T1, T2, T3], where T1 is the top
 // of the stack and T3 is the bottom of the stack. Applying this mutators stack
 // to a platform view P1 will result in T1(T2(T3(P1))).
+//
+// The mutators are stored by value. Up to `kInlineCapacity` of them live
+// within the stack itself, so that pushing, copying and comparing the stacks
+// of typical platform views doesn't allocate.
 class MutatorsStack {
  public:
-  MutatorsStack() = default;
+  using const_iterator = const Mutator*;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_t kInlineCapacity = 8;
+
+  MutatorsStack();
+
+  MutatorsStack(const MutatorsStack& other);
+
+  MutatorsStack(MutatorsStack&& other) noexcept;
+
+  ~MutatorsStack();
+
+  MutatorsStack& operator=(const MutatorsStack& other);
+
+  MutatorsStack& operator=(MutatorsStack&& other) noexcept;
 
   void PushClipRect(const SkRect& rect);
   void PushClipRRect(const SkRRect& rrect);
@@ -141,29 +204,37 @@ class MutatorsStack {
 
   // Returns a reverse iterator pointing to the top of the stack, which is the
   // mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Top()
-      const;
+  const_reverse_iterator Top() const;
   // Returns a reverse iterator pointing to the bottom of the stack, which is
   // the mutator that is closeset from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Bottom()
-      const;
+  const_reverse_iterator Bottom() const;
 
   // Returns an iterator pointing to the beginning of the mutator vector, which
   // is the mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator Begin() const;
+  const_iterator Begin() const;
 
   // Returns an iterator pointing to the end of the mutator vector, which is the
   // mutator that is closest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator End() const;
+  const_iterator End() const;
+
+  bool is_empty() const { return size_ == 0; }
 
-  bool is_empty() const { return vector_.empty(); }
+  size_t size() const { return size_; }
+
+  // Returns a hash of the mutators in the stack that is consistent with
+  // `operator==`. It is updated as mutators are pushed and popped, so reading
+  // it is free.
+  size_t Hash() const { return hash_; }
 
   bool operator==(const MutatorsStack& other) const {
-    if (vector_.size() != other.vector_.size()) {
+    // Stacks that differ usually differ in their hashes, so comparing the
+    // stacks of a platform view from one frame to the next only walks them
+    // when they are likely equal.
+    if (size_ != other.size_ || hash_ != other.hash_) {
       return false;
     }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
+    for (size_t i = 0; i < size_; i++) {
+      if (data_[i] != other.data_[i]) {
         return false;
       }
     }
@@ -171,11 +242,11 @@ class MutatorsStack {
   }
 
   bool operator==(const std::vector<Mutator>& other) const {
-    if (vector_.size() != other.size()) {
+    if (size_ != other.size()) {
       return false;
     }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != other[i]) {
+    for (size_t i = 0; i < size_; i++) {
+      if (data_[i] != other[i]) {
         return false;
       }
     }
@@ -191,7 +262,35 @@ class MutatorsStack {
   }
 
  private:
-  std::vector<std::shared_ptr<Mutator>> vector_;
+  bool IsInline() const {
+    return data_ == reinterpret_cast<const Mutator*>(inline_storage_);
+  }
+
+  // Makes room for at least |capacity| mutators, moving the existing ones to
+  // the heap if they no longer fit in the inline storage.
+  void Reserve(size_t capacity);
+
+  // Destroys all the mutators but keeps the storage.
+  void Clear();
+
+  template <typename Value>
+  void Push(const Value& value) {
+    if (size_ == capacity_) {
+      Reserve(capacity_ * 2);
+    }
+    new (data_ + size_) Mutator(value);
+    AddToHash(data_[size_]);
+    size_++;
+  }
+
+  void AddToHash(const Mutator& mutator);
+
+  Mutator* data_;
+  size_t size_ = 0;
+  size_t hash_ = 0;
+  size_t capacity_ = kInlineCapacity;
+  alignas(Mutator) unsigned char inline_storage_[kInlineCapacity *
+                                                 sizeof(Mutator)];
 };  // MutatorsStack
 
 class EmbeddedViewParams {
@@ -203,7 +302,7 @@ class EmbeddedViewParams {
                      MutatorsStack mutators_stack)
       : matrix_(matrix),
         size_points_(size_points),
-        mutators_stack_(mutators_stack) {
+        mutators_stack_(std::move(mutators_stack)) {
     SkPath path;
     SkRect starting_rect = SkRect::MakeSize(size_points);
     path.addRect(starting_rect);
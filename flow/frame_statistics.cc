@@ -0,0 +1,245 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace flutter {
+
+DurationHistogram::DurationHistogram() {
+  Reset();
+}
+
+DurationHistogram::~DurationHistogram() = default;
+
+size_t DurationHistogram::BucketForMicros(int64_t micros) {
+  constexpr int64_t kMaxMicros = (int64_t{1} << (kMaxExponent + 1)) - 1;
+  micros = std::clamp<int64_t>(micros, 0, kMaxMicros);
+  if (micros < kSubBucketCount) {
+    return micros;
+  }
+  int exponent = kSubBucketBits;
+  while ((micros >> (exponent + 1)) != 0) {
+    exponent++;
+  }
+  const int shift = exponent - kSubBucketBits;
+  return (shift + 1) * kSubBucketCount + ((micros >> shift) - kSubBucketCount);
+}
+
+int64_t DurationHistogram::BucketUpperBoundMicros(size_t bucket) {
+  if (bucket < kSubBucketCount) {
+    return bucket;
+  }
+  const int shift = bucket / kSubBucketCount - 1;
+  const int64_t lower = (bucket % kSubBucketCount + kSubBucketCount) << shift;
+  return lower + (int64_t{1} << shift) - 1;
+}
+
+void DurationHistogram::Record(fml::TimeDelta duration) {
+  buckets_[BucketForMicros(duration.ToMicroseconds())]++;
+  count_++;
+  total_ = total_ + duration;
+  max_ = std::max(max_, duration);
+}
+
+void DurationHistogram::Reset() {
+  buckets_.fill(0);
+  count_ = 0;
+  total_ = fml::TimeDelta::Zero();
+  max_ = fml::TimeDelta::Zero();
+}
+
+fml::TimeDelta DurationHistogram::Mean() const {
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  return fml::TimeDelta::FromNanoseconds(total_.ToNanoseconds() / count_);
+}
+
+fml::TimeDelta DurationHistogram::Percentile(double percentile) const {
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  const double clamped = std::clamp(percentile, 0.0, 100.0);
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count_)));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kBucketCount; bucket++) {
+    seen += buckets_[bucket];
+    if (seen >= rank) {
+      // Durations beyond the range of the histogram all land in the last
+      // bucket, whose bound is then meaningless.
+      if (bucket == kBucketCount - 1) {
+        return max_;
+      }
+      const auto upper_bound =
+          fml::TimeDelta::FromMicroseconds(BucketUpperBoundMicros(bucket));
+      return std::min(max_, upper_bound);
+    }
+  }
+  return max_;
+}
+
+const char* FramePhaseToString(FramePhase phase) {
+  switch (phase) {
+    case FramePhase::kVsyncLatency:
+      return "vsyncLatency";
+    case FramePhase::kBuild:
+      return "build";
+    case FramePhase::kRaster:
+      return "raster";
+    case FramePhase::kRasterCache:
+      return "rasterCache";
+  }
+  return "unknown";
+}
+
+LayerPaintTimes::LayerPaintTimes() = default;
+
+LayerPaintTimes::~LayerPaintTimes() = default;
+
+LayerPaintTimes::ScopedLayer::ScopedLayer(LayerPaintTimes* times,
+                                          uint64_t layer_id)
+    : times_(times), layer_id_(layer_id) {
+  if (!times_) {
+    return;
+  }
+  parent_children_time_ = times_->children_time_;
+  times_->children_time_ = fml::TimeDelta::Zero();
+  start_ = fml::TimePoint::Now();
+}
+
+LayerPaintTimes::ScopedLayer::~ScopedLayer() {
+  if (!times_) {
+    return;
+  }
+  const fml::TimeDelta total = fml::TimePoint::Now() - start_;
+  times_->times_.push_back({layer_id_, total - times_->children_time_});
+  times_->children_time_ = parent_children_time_ + total;
+}
+
+std::vector<LayerPaintTime> LayerPaintTimes::GetSlowestLayers(
+    size_t count) const {
+  std::vector<LayerPaintTime> slowest(times_);
+  const auto slower = [](const LayerPaintTime& a, const LayerPaintTime& b) {
+    return a.duration > b.duration;
+  };
+  if (slowest.size() > count) {
+    std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(),
+                      slower);
+    slowest.resize(count);
+  } else {
+    std::sort(slowest.begin(), slowest.end(), slower);
+  }
+  return slowest;
+}
+
+FrameStatistics::FrameStatistics(size_t max_janky_frames)
+    : max_janky_frames_(max_janky_frames) {}
+
+FrameStatistics::~FrameStatistics() = default;
+
+void FrameStatistics::RecordFrame(const FrameTimingsRecorder& recorder,
+                                  fml::TimeDelta raster_cache_time,
+                                  const LayerPaintTimes* layer_paint_times,
+                                  fml::TimeDelta frame_budget) {
+  const fml::TimePoint vsync_start = recorder.GetVsyncStartTime();
+  const fml::TimePoint raster_end = recorder.GetRasterEndTime();
+
+  std::array<fml::TimeDelta, kFramePhaseCount> durations;
+  durations[static_cast<size_t>(FramePhase::kVsyncLatency)] =
+      recorder.GetBuildStartTime() - vsync_start;
+  durations[static_cast<size_t>(FramePhase::kBuild)] =
+      recorder.GetBuildDuration();
+  durations[static_cast<size_t>(FramePhase::kRaster)] =
+      raster_end - recorder.GetRasterStartTime();
+  durations[static_cast<size_t>(FramePhase::kRasterCache)] = raster_cache_time;
+
+  const fml::TimeDelta total = raster_end - vsync_start;
+  const bool janky = total > frame_budget;
+
+  std::scoped_lock lock(mutex_);
+  frame_count_++;
+  for (size_t i = 0; i < kFramePhaseCount; i++) {
+    histograms_[i].Record(durations[i]);
+  }
+  if (!janky) {
+    return;
+  }
+
+  // The raster cache is populated during the raster phase. Don't count that
+  // time twice when looking for the dominant phase.
+  auto attributed = durations;
+  attributed[static_cast<size_t>(FramePhase::kRaster)] =
+      attributed[static_cast<size_t>(FramePhase::kRaster)] - raster_cache_time;
+  const size_t dominant =
+      std::max_element(attributed.begin(), attributed.end()) -
+      attributed.begin();
+
+  janky_frame_count_++;
+  janky_frames_by_phase_[dominant]++;
+  if (max_janky_frames_ == 0) {
+    return;
+  }
+  if (janky_frames_.size() == max_janky_frames_) {
+    janky_frames_.pop_front();
+  }
+  JankyFrame frame;
+  frame.frame_number = recorder.GetFrameNumber();
+  frame.total = total;
+  frame.phase = static_cast<FramePhase>(dominant);
+  if (layer_paint_times) {
+    frame.slowest_layers =
+        layer_paint_times->GetSlowestLayers(kSlowestLayersPerFrame);
+  }
+  janky_frames_.push_back(std::move(frame));
+}
+
+void FrameStatistics::Reset() {
+  std::scoped_lock lock(mutex_);
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+  janky_frames_by_phase_.fill(0);
+  frame_count_ = 0;
+  janky_frame_count_ = 0;
+  janky_frames_.clear();
+}
+
+uint64_t FrameStatistics::GetFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return frame_count_;
+}
+
+uint64_t FrameStatistics::GetJankyFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return janky_frame_count_;
+}
+
+FrameStatistics::PhaseSummary FrameStatistics::GetPhaseSummary(
+    FramePhase phase) const {
+  std::scoped_lock lock(mutex_);
+  const size_t index = static_cast<size_t>(phase);
+  const DurationHistogram& histogram = histograms_[index];
+  PhaseSummary summary;
+  summary.count = histogram.count();
+  summary.p50 = histogram.Percentile(50);
+  summary.p90 = histogram.Percentile(90);
+  summary.p99 = histogram.Percentile(99);
+  summary.max = histogram.max();
+  summary.mean = histogram.Mean();
+  summary.janky_frames = janky_frames_by_phase_[index];
+  return summary;
+}
+
+std::vector<FrameStatistics::JankyFrame> FrameStatistics::GetJankyFrames()
+    const {
+  std::scoped_lock lock(mutex_);
+  return {janky_frames_.begin(), janky_frames_.end()};
+}
+
+}  // namespace flutter
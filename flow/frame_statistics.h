@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_STATISTICS_H_
+#define FLUTTER_FLOW_FRAME_STATISTICS_H_
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "flutter/flow/frame_timings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// A histogram of durations with logarithmic buckets, in the spirit of HDR
+/// histograms. Durations between 1 microsecond and about a minute are recorded
+/// with a relative error of at most 1/32 in constant time and memory.
+class DurationHistogram {
+ public:
+  DurationHistogram();
+
+  ~DurationHistogram();
+
+  void Record(fml::TimeDelta duration);
+
+  void Reset();
+
+  uint64_t count() const { return count_; }
+
+  fml::TimeDelta max() const { return max_; }
+
+  fml::TimeDelta Mean() const;
+
+  /// The smallest recorded duration that is greater than or equal to the given
+  /// percentage, in [0, 100], of all recorded durations. Returns zero when
+  /// nothing was recorded.
+  fml::TimeDelta Percentile(double percentile) const;
+
+ private:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr int64_t kSubBucketCount = 1 << kSubBucketBits;
+  static constexpr int kMaxExponent = 26;
+  static constexpr size_t kBucketCount =
+      (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+  static size_t BucketForMicros(int64_t micros);
+  static int64_t BucketUpperBoundMicros(size_t bucket);
+
+  std::array<uint64_t, kBucketCount> buckets_;
+  uint64_t count_ = 0;
+  fml::TimeDelta total_;
+  fml::TimeDelta max_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DurationHistogram);
+};
+
+/// The phases a frame goes through, as far as the statistics are concerned.
+enum class FramePhase {
+  /// From the vsync signal to the start of the frame build on the UI thread.
+  kVsyncLatency,
+  /// The frame build on the UI thread.
+  kBuild,
+  /// The rasterization of the frame, including the raster cache preparation.
+  kRaster,
+  /// The time spent populating the raster cache while rasterizing the frame.
+  kRasterCache,
+};
+
+static constexpr size_t kFramePhaseCount = 4;
+
+const char* FramePhaseToString(FramePhase phase);
+
+/// The time a layer spent painting itself during a frame, excluding the time
+/// spent painting its children.
+struct LayerPaintTime {
+  uint64_t layer_id;
+  fml::TimeDelta duration;
+};
+
+/// Collects the paint time of every layer during one frame.
+class LayerPaintTimes {
+ public:
+  /// Measures the paint time of a layer for the duration of its scope. Scopes
+  /// of child layers must be nested within the scope of their parent.
+  class ScopedLayer {
+   public:
+    ScopedLayer(LayerPaintTimes* times, uint64_t layer_id);
+
+    ~ScopedLayer();
+
+   private:
+    LayerPaintTimes* times_;
+    const uint64_t layer_id_;
+    fml::TimeDelta parent_children_time_;
+    fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedLayer);
+  };
+
+  LayerPaintTimes();
+
+  ~LayerPaintTimes();
+
+  /// The layers that took the longest to paint, slowest first.
+  std::vector<LayerPaintTime> GetSlowestLayers(size_t count) const;
+
+ private:
+  std::vector<LayerPaintTime> times_;
+  fml::TimeDelta children_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerPaintTimes);
+};
+
+//------------------------------------------------------------------------------
+/// Aggregates the timings of rasterized frames into per-phase histograms and
+/// keeps the most recent janky frames along with what they are attributed to.
+///
+/// A frame is janky if it took longer than the frame budget from the vsync
+/// signal to the end of its rasterization. It is attributed to the phase it
+/// spent the most time in, with the raster cache time counted separately from
+/// the rest of the raster phase.
+///
+/// This is thread-safe. Frames are usually recorded on the raster thread
+/// while the statistics are read from elsewhere.
+class FrameStatistics {
+ public:
+  static constexpr size_t kDefaultMaxJankyFrames = 32;
+
+  static constexpr size_t kSlowestLayersPerFrame = 5;
+
+  struct JankyFrame {
+    uint64_t frame_number;
+    fml::TimeDelta total;
+    FramePhase phase;
+    std::vector<LayerPaintTime> slowest_layers;
+  };
+
+  struct PhaseSummary {
+    uint64_t count = 0;
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+    fml::TimeDelta max;
+    fml::TimeDelta mean;
+    /// The number of janky frames attributed to this phase.
+    uint64_t janky_frames = 0;
+  };
+
+  explicit FrameStatistics(size_t max_janky_frames = kDefaultMaxJankyFrames);
+
+  ~FrameStatistics();
+
+  /// Records a frame whose rasterization has ended.
+  void RecordFrame(const FrameTimingsRecorder& recorder,
+                   fml::TimeDelta raster_cache_time,
+                   const LayerPaintTimes* layer_paint_times,
+                   fml::TimeDelta frame_budget);
+
+  void Reset();
+
+  uint64_t GetFrameCount() const;
+
+  uint64_t GetJankyFrameCount() const;
+
+  PhaseSummary GetPhaseSummary(FramePhase phase) const;
+
+  /// The most recent janky frames, oldest first.
+  std::vector<JankyFrame> GetJankyFrames() const;
+
+ private:
+  const size_t max_janky_frames_;
+  mutable std::mutex mutex_;
+  std::array<DurationHistogram, kFramePhaseCount> histograms_;
+  std::array<uint64_t, kFramePhaseCount> janky_frames_by_phase_ = {};
+  uint64_t frame_count_ = 0;
+  uint64_t janky_frame_count_ = 0;
+  std::deque<JankyFrame> janky_frames_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_STATISTICS_H_
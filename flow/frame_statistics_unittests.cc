@@ -0,0 +1,173 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_statistics.h"
+
+#include <cmath>
+#include <thread>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Records a frame that spent the given durations in the vsync latency, build
+// and pipeline phases, and that finishes rasterizing now.
+std::unique_ptr<FrameTimingsRecorder> RecordFrame(
+    fml::TimeDelta vsync_latency,
+    fml::TimeDelta build,
+    fml::TimeDelta raster) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+  const auto raster_start = fml::TimePoint::Now() - raster;
+  const auto build_end = raster_start;
+  const auto build_start = build_end - build;
+  const auto vsync_start = build_start - vsync_latency;
+  recorder->RecordVsync(vsync_start,
+                        vsync_start + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(build_start);
+  recorder->RecordBuildEnd(build_end);
+  recorder->RecordRasterStart(raster_start);
+  recorder->RecordRasterEnd();
+  return recorder;
+}
+
+}  // namespace
+
+TEST(DurationHistogramTest, ReportsPercentilesWithBoundedError) {
+  DurationHistogram histogram;
+  ASSERT_EQ(histogram.Percentile(50), fml::TimeDelta::Zero());
+
+  for (int64_t i = 1; i <= 1000; i++) {
+    histogram.Record(fml::TimeDelta::FromMicroseconds(i * 100));
+  }
+
+  ASSERT_EQ(histogram.count(), 1000u);
+  ASSERT_EQ(histogram.max(), fml::TimeDelta::FromMicroseconds(100000));
+  ASSERT_EQ(histogram.Mean(), fml::TimeDelta::FromMicroseconds(50050));
+
+  const auto expect_near = [](fml::TimeDelta actual, int64_t expected_micros) {
+    const double error =
+        std::abs(actual.ToMicroseconds() - expected_micros) /
+        static_cast<double>(expected_micros);
+    EXPECT_LE(error, 1.0 / 32) << actual.ToMicroseconds();
+    EXPECT_GE(actual.ToMicroseconds(), expected_micros);
+  };
+  expect_near(histogram.Percentile(50), 50000);
+  expect_near(histogram.Percentile(90), 90000);
+  expect_near(histogram.Percentile(99), 99000);
+  ASSERT_EQ(histogram.Percentile(100), histogram.max());
+
+  histogram.Reset();
+  ASSERT_EQ(histogram.count(), 0u);
+  ASSERT_EQ(histogram.max(), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogramTest, ClampsOutOfRangeDurations) {
+  DurationHistogram histogram;
+  histogram.Record(fml::TimeDelta::FromSeconds(3600));
+  histogram.Record(fml::TimeDelta::FromMicroseconds(-5));
+  ASSERT_EQ(histogram.count(), 2u);
+  ASSERT_EQ(histogram.Percentile(50), fml::TimeDelta::Zero());
+  ASSERT_EQ(histogram.Percentile(100), fml::TimeDelta::FromSeconds(3600));
+}
+
+TEST(LayerPaintTimesTest, ExcludesTimeSpentPaintingChildren) {
+  using namespace std::chrono_literals;
+
+  LayerPaintTimes times;
+  {
+    LayerPaintTimes::ScopedLayer parent(&times, 1);
+    {
+      LayerPaintTimes::ScopedLayer child(&times, 2);
+      std::this_thread::sleep_for(20ms);
+    }
+    {
+      LayerPaintTimes::ScopedLayer child(&times, 3);
+      std::this_thread::sleep_for(5ms);
+    }
+  }
+  // Scopes without a collector are ignored.
+  { LayerPaintTimes::ScopedLayer ignored(nullptr, 4); }
+
+  const auto slowest = times.GetSlowestLayers(2);
+  ASSERT_EQ(slowest.size(), 2u);
+  ASSERT_EQ(slowest[0].layer_id, 2u);
+  ASSERT_EQ(slowest[1].layer_id, 3u);
+  ASSERT_GE(slowest[0].duration, fml::TimeDelta::FromMilliseconds(20));
+
+  const auto all = times.GetSlowestLayers(10);
+  ASSERT_EQ(all.size(), 3u);
+  ASSERT_EQ(all[2].layer_id, 1u);
+  ASSERT_LT(all[2].duration, fml::TimeDelta::FromMilliseconds(5));
+}
+
+TEST(FrameStatisticsTest, AttributesJankyFramesToTheirDominantPhase) {
+  FrameStatistics statistics(2);
+  const auto budget = fml::TimeDelta::FromMilliseconds(16);
+  const auto ms = [](int64_t value) {
+    return fml::TimeDelta::FromMilliseconds(value);
+  };
+
+  // Not janky.
+  statistics.RecordFrame(*RecordFrame(ms(1), ms(2), ms(0)), ms(0), nullptr,
+                         fml::TimeDelta::FromSeconds(10));
+  // Janky because of the build.
+  statistics.RecordFrame(*RecordFrame(ms(1), ms(40), ms(0)), ms(0), nullptr,
+                         budget);
+  // Janky because of the vsync latency.
+  statistics.RecordFrame(*RecordFrame(ms(50), ms(1), ms(0)), ms(0), nullptr,
+                         budget);
+  // Janky because of the raster cache.
+  LayerPaintTimes times;
+  { LayerPaintTimes::ScopedLayer layer(&times, 7); }
+  statistics.RecordFrame(*RecordFrame(ms(1), ms(1), ms(60)), ms(45), &times,
+                         budget);
+
+  ASSERT_EQ(statistics.GetFrameCount(), 4u);
+  ASSERT_EQ(statistics.GetJankyFrameCount(), 3u);
+  ASSERT_EQ(statistics.GetPhaseSummary(FramePhase::kBuild).count, 4u);
+  ASSERT_EQ(statistics.GetPhaseSummary(FramePhase::kBuild).janky_frames, 1u);
+  ASSERT_EQ(statistics.GetPhaseSummary(FramePhase::kVsyncLatency).janky_frames,
+            1u);
+  ASSERT_EQ(statistics.GetPhaseSummary(FramePhase::kRasterCache).janky_frames,
+            1u);
+  ASSERT_EQ(statistics.GetPhaseSummary(FramePhase::kRaster).janky_frames, 0u);
+  ASSERT_GE(statistics.GetPhaseSummary(FramePhase::kBuild).max, ms(40));
+
+  // Only the two most recent janky frames are kept.
+  const auto janky_frames = statistics.GetJankyFrames();
+  ASSERT_EQ(janky_frames.size(), 2u);
+  ASSERT_EQ(janky_frames[0].phase, FramePhase::kVsyncLatency);
+  ASSERT_TRUE(janky_frames[0].slowest_layers.empty());
+  ASSERT_EQ(janky_frames[1].phase, FramePhase::kRasterCache);
+  ASSERT_EQ(janky_frames[1].slowest_layers.size(), 1u);
+  ASSERT_EQ(janky_frames[1].slowest_layers[0].layer_id, 7u);
+  ASSERT_GT(janky_frames[1].frame_number, janky_frames[0].frame_number);
+
+  statistics.Reset();
+  ASSERT_EQ(statistics.GetFrameCount(), 0u);
+  ASSERT_TRUE(statistics.GetJankyFrames().empty());
+}
+
+TEST(FrameStatisticsTest, LayerPaintTimesAreOnlyCollectedWhenEnabled) {
+  CompositorContext context;
+  auto acquire_frame = [&](bool instrumentation_enabled) {
+    return context.AcquireFrame(nullptr, nullptr, nullptr, SkMatrix::I(),
+                                instrumentation_enabled, false, nullptr);
+  };
+  EXPECT_EQ(acquire_frame(true)->layer_paint_times(), nullptr);
+
+  context.SetLayerPaintTimesEnabled(true);
+  EXPECT_NE(acquire_frame(true)->layer_paint_times(), nullptr);
+  EXPECT_EQ(acquire_frame(false)->layer_paint_times(), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,11 +4,21 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
-                                         SkBlendMode blend_mode)
-    : filter_(std::move(filter)), blend_mode_(blend_mode) {}
+                                         SkBlendMode blend_mode,
+                                         std::optional<Blur> blur)
+    : filter_(std::move(filter)),
+      blend_mode_(blend_mode),
+      blur_(blur),
+      filtered_backdrop_(std::make_shared<FilteredBackdrop>()) {}
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -17,7 +27,10 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto* prev = static_cast<const BackdropFilterLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
-    if (filter_ != prev->filter_) {
+    // Blurs are rebuilt by the framework with every frame, so compare their
+    // parameters rather than the filters.
+    bool same_blur = blur_ && blur_ == prev->blur_;
+    if (filter_ != prev->filter_ && !same_blur) {
       context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
     }
   }
@@ -35,6 +48,15 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
       filter->filterBounds(input_filter_bounds, SkMatrix::I(),
                            SkImageFilter::kReverse_MapDirection);
 
+  // The filtered backdrop of the previous frame can be drawn again if nothing
+  // that was painted before this layer changed underneath it.
+  if (prev) {
+    filtered_backdrop_ = prev->filtered_backdrop_;
+  }
+  filtered_backdrop_->diffed = true;
+  filtered_backdrop_->backdrop_unchanged =
+      prev && !context->IsSubtreeDirty() && !context->HasDamage(filter_bounds);
+
   context->AddReadbackRegion(filter_bounds);
 
   DiffChildren(context, prev);
@@ -52,18 +74,133 @@ void BackdropFilterLayer::Preroll(PrerollContext* context,
   PrerollChildren(context, matrix, &child_paint_bounds);
   child_paint_bounds.join(context->cull_rect);
   set_paint_bounds(child_paint_bounds);
+  if (blur_ && blend_mode_ == SkBlendMode::kSrcOver) {
+    context->has_reusable_backdrop = true;
+  }
 }
 
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  sk_sp<SkImageFilter> filter = GetFilter(context);
+  if (DrawFilteredBackdrop(context, filter)) {
+    PaintChildren(context);
+    return;
+  }
+
   SkPaint paint;
   paint.setBlendMode(blend_mode_);
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
       context,
-      SkCanvas::SaveLayerRec{&paint_bounds(), &paint, filter_.get(), 0});
+      SkCanvas::SaveLayerRec{&paint_bounds(), &paint, filter.get(), 0});
   PaintChildren(context);
 }
 
+sk_sp<SkImageFilter> BackdropFilterLayer::GetFilter(
+    const PaintContext& context) const {
+  if (!blur_ || context.backdrop_blur_max_downsampling <= 1) {
+    return filter_;
+  }
+  const SkMatrix& matrix = context.leaf_nodes_canvas->getTotalMatrix();
+  if (!matrix.isScaleTranslate()) {
+    return filter_;
+  }
+
+  // Downsample as far as allowed while keeping the smaller sigma above
+  // kMinDownsampledBlurSigma device pixels, so that small blurs keep their
+  // detail.
+  const SkScalar device_sigma =
+      std::min(std::abs(blur_->sigma_x * matrix.getScaleX()),
+               std::abs(blur_->sigma_y * matrix.getScaleY()));
+  const int factor =
+      std::min(context.backdrop_blur_max_downsampling,
+               static_cast<int>(device_sigma / kMinDownsampledBlurSigma));
+  if (factor <= 1) {
+    return filter_;
+  }
+
+  const SkScalar scale = 1.0f / factor;
+  const SkSamplingOptions sampling(SkFilterMode::kLinear);
+  auto downsampled = SkImageFilters::MatrixTransform(
+      SkMatrix::Scale(scale, scale), sampling, nullptr);
+  auto blurred =
+      SkImageFilters::Blur(blur_->sigma_x * scale, blur_->sigma_y * scale,
+                           blur_->tile_mode, std::move(downsampled));
+  return SkImageFilters::MatrixTransform(SkMatrix::Scale(factor, factor),
+                                         sampling, std::move(blurred));
+}
+
+bool BackdropFilterLayer::DrawFilteredBackdrop(
+    PaintContext& context,
+    const sk_sp<SkImageFilter>& filter) const {
+  FilteredBackdrop& backdrop = *filtered_backdrop_;
+  const bool diffed = backdrop.diffed;
+  const bool backdrop_unchanged = backdrop.backdrop_unchanged;
+  backdrop.diffed = false;
+  backdrop.backdrop_unchanged = false;
+
+  // Only blurs are filtered manually, as they don't depend on where the
+  // backdrop is. The backdrop is read back from the surface directly, which
+  // is only possible when nothing is painted into overlays.
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  const SkMatrix& matrix = canvas->getTotalMatrix();
+  if (!diffed || !blur_ || !filter || !surface || context.view_embedder ||
+      blend_mode_ != SkBlendMode::kSrcOver || !matrix.isScaleTranslate()) {
+    backdrop.image = nullptr;
+    return false;
+  }
+
+  const SkIRect surface_bounds =
+      SkIRect::MakeWH(surface->width(), surface->height());
+  SkIRect device_bounds = matrix.mapRect(paint_bounds()).roundOut();
+  if (!device_bounds.intersect(surface_bounds)) {
+    backdrop.image = nullptr;
+    return false;
+  }
+
+  if (!backdrop_unchanged || !backdrop.image ||
+      backdrop.device_bounds != device_bounds || backdrop.matrix != matrix) {
+    TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+    const SkMatrix scale =
+        SkMatrix::Scale(matrix.getScaleX(), matrix.getScaleY());
+    SkIRect input_bounds = filter->filterBounds(
+        device_bounds, scale, SkImageFilter::kReverse_MapDirection);
+    if (!input_bounds.intersect(surface_bounds)) {
+      backdrop.image = nullptr;
+      return false;
+    }
+    sk_sp<SkImage> snapshot = surface->makeImageSnapshot(input_bounds);
+    if (!snapshot) {
+      backdrop.image = nullptr;
+      return false;
+    }
+    SkIRect subset;
+    SkIPoint offset;
+    backdrop.image = snapshot->makeWithFilter(
+        context.gr_context, filter->makeWithLocalMatrix(scale).get(),
+        SkIRect::MakeWH(snapshot->width(), snapshot->height()),
+        device_bounds.makeOffset(-input_bounds.left(), -input_bounds.top()),
+        &subset, &offset);
+    if (!backdrop.image) {
+      return false;
+    }
+    backdrop.src = subset;
+    backdrop.dst = SkIRect::MakeXYWH(input_bounds.left() + offset.x(),
+                                     input_bounds.top() + offset.y(),
+                                     subset.width(), subset.height());
+    backdrop.device_bounds = device_bounds;
+    backdrop.matrix = matrix;
+  }
+
+  // The image is in device space and aligned to its pixels.
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->resetMatrix();
+  canvas->drawImageRect(backdrop.image, SkRect::Make(backdrop.src),
+                        SkRect::Make(backdrop.dst), SkSamplingOptions(),
+                        nullptr, SkCanvas::kStrict_SrcRectConstraint);
+  return true;
+}
+
 }  // namespace flutter
@@ -5,14 +5,37 @@
 #ifndef FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
+#include <memory>
+#include <optional>
+
 #include "flutter/flow/layers/container_layer.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flutter {
 
 class BackdropFilterLayer : public ContainerLayer {
  public:
-  BackdropFilterLayer(sk_sp<SkImageFilter> filter, SkBlendMode blend_mode);
+  // The parameters of a filter that is a plain blur, which can be run at a
+  // reduced resolution.
+  struct Blur {
+    SkScalar sigma_x;
+    SkScalar sigma_y;
+    SkTileMode tile_mode;
+
+    bool operator==(const Blur& other) const {
+      return sigma_x == other.sigma_x && sigma_y == other.sigma_y &&
+             tile_mode == other.tile_mode;
+    }
+  };
+
+  // Blurs whose sigma is smaller than this many device pixels once
+  // downsampled are not downsampled any further.
+  static constexpr SkScalar kMinDownsampledBlurSigma = 2.0f;
+
+  BackdropFilterLayer(sk_sp<SkImageFilter> filter,
+                      SkBlendMode blend_mode,
+                      std::optional<Blur> blur = std::nullopt);
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
@@ -25,8 +48,36 @@ class BackdropFilterLayer : public ContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // The filtered backdrop of the previous frame, which is passed on to the
+  // layer that replaces this one.
+  struct FilteredBackdrop {
+    sk_sp<SkImage> image;
+    // The part of the image to draw and where it goes, in device space.
+    SkIRect src;
+    SkIRect dst;
+    // The bounds of the layer in device space and the transform it was
+    // painted with.
+    SkIRect device_bounds;
+    SkMatrix matrix;
+    // Set by Diff for the frame being painted.
+    bool diffed = false;
+    bool backdrop_unchanged = false;
+  };
+
+  // Returns the filter to apply, which runs blurs at a reduced resolution if
+  // allowed.
+  sk_sp<SkImageFilter> GetFilter(const PaintContext& context) const;
+
+  // Draws the filtered backdrop as an image, reusing the one from the
+  // previous frame if nothing underneath changed. Returns false if the
+  // backdrop must be filtered with a saveLayer instead.
+  bool DrawFilteredBackdrop(PaintContext& context,
+                            const sk_sp<SkImageFilter>& filter) const;
+
   sk_sp<SkImageFilter> filter_;
   SkBlendMode blend_mode_;
+  std::optional<Blur> blur_;
+  std::shared_ptr<FilteredBackdrop> filtered_backdrop_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
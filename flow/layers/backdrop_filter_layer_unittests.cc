@@ -5,6 +5,8 @@
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include <cstdlib>
+
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
@@ -12,7 +14,9 @@
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
@@ -269,6 +273,58 @@ TEST_F(BackdropFilterLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+TEST_F(BackdropFilterLayerTest, BlursAreNotDownsampledByDefault) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer_filter =
+      SkImageFilters::Blur(20.0f, 20.0f, SkTileMode::kClamp, nullptr);
+  auto layer = std::make_shared<BackdropFilterLayer>(
+      layer_filter, SkBlendMode::kSrcOver,
+      BackdropFilterLayer::Blur{20.0f, 20.0f, SkTileMode::kClamp});
+  layer->Add(std::make_shared<MockLayer>(SkPath().addRect(child_bounds)));
+  auto parent = std::make_shared<ClipRectLayer>(child_bounds, Clip::hardEdge);
+  parent->Add(layer);
+
+  parent->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  auto save_layer = std::get<MockCanvas::SaveLayerData>(
+      mock_canvas().draw_calls().front().data);
+  EXPECT_EQ(save_layer.backdrop_filter, layer_filter);
+}
+
+TEST_F(BackdropFilterLayerTest, DownsamplesLargeBlurs) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto large_filter =
+      SkImageFilters::Blur(20.0f, 20.0f, SkTileMode::kClamp, nullptr);
+  auto large_blur = std::make_shared<BackdropFilterLayer>(
+      large_filter, SkBlendMode::kSrcOver,
+      BackdropFilterLayer::Blur{20.0f, 20.0f, SkTileMode::kClamp});
+  // Downsampling this one would bring its sigma under
+  // kMinDownsampledBlurSigma.
+  auto small_filter =
+      SkImageFilters::Blur(3.0f, 3.0f, SkTileMode::kClamp, nullptr);
+  auto small_blur = std::make_shared<BackdropFilterLayer>(
+      small_filter, SkBlendMode::kSrcOver,
+      BackdropFilterLayer::Blur{3.0f, 3.0f, SkTileMode::kClamp});
+  auto parent = std::make_shared<ClipRectLayer>(child_bounds, Clip::hardEdge);
+  parent->Add(large_blur);
+  parent->Add(small_blur);
+
+  paint_context().backdrop_blur_max_downsampling = 4;
+  parent->Preroll(preroll_context(), SkMatrix());
+  parent->Paint(paint_context());
+
+  std::vector<sk_sp<SkImageFilter>> backdrop_filters;
+  for (const auto& call : mock_canvas().draw_calls()) {
+    if (auto* save_layer = std::get_if<MockCanvas::SaveLayerData>(&call.data)) {
+      backdrop_filters.push_back(save_layer->backdrop_filter);
+    }
+  }
+  ASSERT_EQ(backdrop_filters.size(), 2u);
+  EXPECT_NE(backdrop_filters[0], nullptr);
+  EXPECT_NE(backdrop_filters[0], large_filter);
+  EXPECT_EQ(backdrop_filters[1], small_filter);
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 using BackdropLayerDiffTest = DiffContextTest;
@@ -329,6 +385,175 @@ TEST_F(BackdropLayerDiffTest, BackdropLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 190, 190));
 }
 
+TEST_F(BackdropLayerDiffTest, RebuiltBlurDoesNotDamage) {
+  auto filter1 = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  auto filter2 = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  const BackdropFilterLayer::Blur blur{10, 10, SkTileMode::kClamp};
+
+  MockLayerTree l1(SkISize::Make(100, 100));
+  auto layer1 = std::make_shared<BackdropFilterLayer>(
+      filter1, SkBlendMode::kSrcOver, blur);
+  l1.root()->Add(layer1);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(100, 100)));
+
+  MockLayerTree l2(SkISize::Make(100, 100));
+  auto layer2 = std::make_shared<BackdropFilterLayer>(
+      filter2, SkBlendMode::kSrcOver, blur);
+  layer2->AssignOldLayer(layer1.get());
+  l2.root()->Add(layer2);
+  auto damage = DiffLayerTree(l2, l1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+}
+
+class BackdropLayerReuseTest : public BackdropLayerDiffTest {
+ public:
+  BackdropLayerReuseTest()
+      : surface_(SkSurface::MakeRasterN32Premul(100, 100)) {}
+
+  // Prerolls and paints the layer tree over the whole surface filled with the
+  // backdrop color, like a frame that isn't partially repainted. Returns
+  // whether the tree has a reusable backdrop.
+  bool Paint(MockLayerTree& layer_tree,
+             SkColor backdrop,
+             int backdrop_blur_max_downsampling = 1) {
+    PrerollContext preroll_context{
+        nullptr, /* raster_cache */
+        nullptr, /* gr_context */
+        nullptr, /* external_view_embedder */
+        mutators_stack_,
+        nullptr,    /* dst_color_space */
+        kGiantRect, /* cull_rect */
+        false,      /* surface_needs_readback */
+        raster_time_,
+        ui_time_,
+        texture_registry_,
+        false, /* checkerboard_offscreen_layers */
+        1.0f,  /* frame_device_pixel_ratio */
+    };
+    layer_tree.root()->Preroll(&preroll_context, SkMatrix());
+
+    SkCanvas* canvas = surface_->getCanvas();
+    Layer::PaintContext paint_context{
+        canvas,  /* internal_nodes_canvas */
+        canvas,  /* leaf_nodes_canvas */
+        nullptr, /* gr_context */
+        nullptr, /* external_view_embedder */
+        raster_time_,
+        ui_time_,
+        texture_registry_,
+        nullptr, /* raster_cache */
+        false,   /* checkerboard_offscreen_layers */
+        1.0f,    /* frame_device_pixel_ratio */
+    };
+    paint_context.backdrop_blur_max_downsampling =
+        backdrop_blur_max_downsampling;
+    canvas->clear(backdrop);
+    layer_tree.root()->Paint(paint_context);
+    return preroll_context.has_reusable_backdrop;
+  }
+
+  // Filtering may round the channels of a uniform backdrop off a little.
+  bool IsMostly(SkColor color, SkColor expected) {
+    return std::abs(static_cast<int>(SkColorGetR(color)) -
+                    static_cast<int>(SkColorGetR(expected))) < 8 &&
+           std::abs(static_cast<int>(SkColorGetG(color)) -
+                    static_cast<int>(SkColorGetG(expected))) < 8 &&
+           std::abs(static_cast<int>(SkColorGetB(color)) -
+                    static_cast<int>(SkColorGetB(expected))) < 8;
+  }
+
+  SkColor GetColor(int x, int y) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(surface_->width(), surface_->height());
+    EXPECT_TRUE(surface_->readPixels(bitmap, 0, 0));
+    return bitmap.getColor(x, y);
+  }
+
+ private:
+  sk_sp<SkSurface> surface_;
+  Stopwatch raster_time_;
+  Stopwatch ui_time_;
+  MutatorsStack mutators_stack_;
+  TextureRegistry texture_registry_;
+};
+
+TEST_F(BackdropLayerReuseTest, ReusesFilteredBackdropWhileBackdropIsUnchanged) {
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(std::make_shared<BackdropFilterLayer>(
+      filter, SkBlendMode::kSrcOver,
+      BackdropFilterLayer::Blur{10, 10, SkTileMode::kClamp}));
+
+  MockLayerTree l1(SkISize::Make(100, 100));
+  l1.root()->Add(clip);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(100, 100)));
+  EXPECT_TRUE(Paint(l1, SK_ColorRED));
+  EXPECT_TRUE(IsMostly(GetColor(40, 40), SK_ColorRED));
+
+  // Nothing underneath changed according to the diff, so the red backdrop
+  // filtered for the previous frame is drawn again.
+  MockLayerTree l2(SkISize::Make(100, 100));
+  l2.root()->Add(clip);
+  DiffLayerTree(l2, l1);
+  Paint(l2, SK_ColorBLUE);
+  EXPECT_TRUE(IsMostly(GetColor(40, 40), SK_ColorRED));
+  EXPECT_EQ(GetColor(80, 80), SK_ColorBLUE);
+
+  // A layer painted within the area the blur reads from changes the backdrop.
+  MockLayerTree l3(SkISize::Make(100, 100));
+  l3.root()->Add(
+      std::make_shared<MockLayer>(SkPath().addRect(SkRect::MakeWH(5, 5))));
+  l3.root()->Add(clip);
+  DiffLayerTree(l3, l2);
+  Paint(l3, SK_ColorBLUE);
+  EXPECT_TRUE(IsMostly(GetColor(40, 40), SK_ColorBLUE));
+
+  // Trees that weren't diffed filter their backdrop again.
+  Paint(l3, SK_ColorRED);
+  EXPECT_TRUE(IsMostly(GetColor(40, 40), SK_ColorRED));
+}
+
+TEST_F(BackdropLayerReuseTest, DownsampledBlurMatchesFullResolutionBlur) {
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(std::make_shared<BackdropFilterLayer>(
+      filter, SkBlendMode::kSrcOver,
+      BackdropFilterLayer::Blur{10, 10, SkTileMode::kClamp}));
+  // The left half of the backdrop is red and the right half blue.
+  auto red_half = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(40, 100)), SkPaint(SkColors::kRed));
+
+  auto paint_blur = [&](int backdrop_blur_max_downsampling) {
+    MockLayerTree layer_tree(SkISize::Make(100, 100));
+    layer_tree.root()->Add(red_half);
+    layer_tree.root()->Add(clip);
+    DiffLayerTree(layer_tree, MockLayerTree(SkISize::Make(100, 100)));
+    Paint(layer_tree, SK_ColorBLUE, backdrop_blur_max_downsampling);
+    std::vector<SkColor> colors;
+    for (int x = 22; x < 60; x += 6) {
+      colors.push_back(GetColor(x, 40));
+    }
+    return colors;
+  };
+
+  const std::vector<SkColor> full_resolution = paint_blur(1);
+  const std::vector<SkColor> downsampled = paint_blur(4);
+  ASSERT_EQ(full_resolution.size(), downsampled.size());
+  // The edge between the halves is blurred.
+  EXPECT_NE(full_resolution[3], SK_ColorRED);
+  EXPECT_NE(full_resolution[3], SK_ColorBLUE);
+  for (size_t i = 0; i < full_resolution.size(); i++) {
+    EXPECT_NEAR(SkColorGetR(full_resolution[i]), SkColorGetR(downsampled[i]),
+                24)
+        << i;
+    EXPECT_NEAR(SkColorGetB(full_resolution[i]), SkColorGetB(downsampled[i]),
+                24)
+        << i;
+  }
+}
+
 #endif
 
 }  // namespace testing
@@ -4,10 +4,69 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <atomic>
 #include <optional>
 
+#include "flutter/flow/frame_statistics.h"
+#include "flutter/flow/layers/layer_record_cache.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
 namespace flutter {
 
+namespace {
+
+// A child layer that is prerolled in parallel with its siblings. It gets its
+// own copy of the parts of the context that layers modify during Preroll.
+struct ChildPreroll {
+  ChildPreroll(const PrerollContext& parent,
+               Layer* layer,
+               const SkMatrix& matrix)
+      : layer(layer),
+        matrix(matrix),
+        mutators_stack(parent.mutators_stack),
+        context{
+            parent.raster_cache,
+            parent.gr_context,
+            parent.view_embedder,
+            mutators_stack,
+            parent.dst_color_space,
+            parent.cull_rect,
+            parent.surface_needs_readback,
+            parent.raster_time,
+            parent.ui_time,
+            parent.texture_registry,
+            parent.checkerboard_offscreen_layers,
+            parent.frame_device_pixel_ratio,
+            false,                     // has_platform_view
+            parent.has_texture_layer,  // has_texture_layer
+            nullptr,                   // concurrent_task_runner
+            &deferred_tasks,           // deferred_tasks
+            false,                     // has_reusable_backdrop
+        } {}
+
+  // Prerolls the layer unless another thread already started doing so.
+  void TryPreroll() {
+    if (claimed.exchange(true)) {
+      return;
+    }
+    layer->set_preroll_cull_rect(context.cull_rect);
+    layer->Preroll(&context, matrix);
+    done.Signal();
+  }
+
+  Layer* const layer;
+  const SkMatrix matrix;
+  MutatorsStack mutators_stack;
+  std::vector<fml::closure> deferred_tasks;
+  PrerollContext context;
+  std::atomic_bool claimed{false};
+  fml::ManualResetWaitableEvent done;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ChildPreroll);
+};
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() {}
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
@@ -108,6 +167,18 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  subtree_layer_count_ = 0;
+}
+
+size_t ContainerLayer::subtree_layer_count() const {
+  if (subtree_layer_count_ == 0) {
+    size_t count = 1;
+    for (auto& layer : layers_) {
+      count += layer->subtree_layer_count();
+    }
+    subtree_layer_count_ = count;
+  }
+  return subtree_layer_count_;
 }
 
 void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
@@ -130,6 +201,11 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+  if (ShouldPrerollChildrenInParallel(context)) {
+    PrerollChildrenInParallel(context, child_matrix, child_paint_bounds);
+    return;
+  }
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   for (auto& layer : layers_) {
@@ -138,6 +214,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // sibling tree.
     context->has_platform_view = false;
 
+    layer->set_preroll_cull_rect(context->cull_rect);
     layer->Preroll(context, child_matrix);
     child_paint_bounds->join(layer->paint_bounds());
 
@@ -152,6 +229,80 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   set_subtree_has_platform_view(child_has_platform_view);
 }
 
+bool ContainerLayer::ShouldPrerollChildrenInParallel(
+    PrerollContext* context) const {
+  // Subtrees that are already prerolled in parallel aren't split further.
+  if (!context->concurrent_task_runner || context->deferred_tasks) {
+    return false;
+  }
+  size_t large_children = 0;
+  for (auto& layer : layers_) {
+    if (layer->subtree_layer_count() >= kParallelPrerollMinSubtreeSize &&
+        ++large_children == 2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ContainerLayer::PrerollChildrenInParallel(PrerollContext* context,
+                                               const SkMatrix& child_matrix,
+                                               SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenInParallel");
+
+  // Every large child but the first is offered to the task runner. This
+  // thread then prerolls all the children that no worker has started on, so
+  // the frame never waits on a busy task runner to pick up work.
+  std::vector<std::shared_ptr<ChildPreroll>> children;
+  children.reserve(layers_.size());
+  bool is_first_large_child = true;
+  for (auto& layer : layers_) {
+    auto child =
+        std::make_shared<ChildPreroll>(*context, layer.get(), child_matrix);
+    children.push_back(child);
+    if (layer->subtree_layer_count() < kParallelPrerollMinSubtreeSize) {
+      continue;
+    }
+    if (is_first_large_child) {
+      is_first_large_child = false;
+      continue;
+    }
+    context->concurrent_task_runner->PostTask(
+        [child = std::move(child)]() { child->TryPreroll(); });
+  }
+  for (auto& child : children) {
+    child->TryPreroll();
+  }
+
+  // Merge the results and run the deferred tasks in the order of the children
+  // so that the outcome doesn't depend on which thread prerolled what.
+  //
+  // Unlike the serial preroll, the texture layers of a child don't affect the
+  // raster cache decisions made for its later siblings.
+  bool child_has_platform_view = false;
+  bool child_has_texture_layer = false;
+  for (auto& child : children) {
+    child->done.Wait();
+    child_paint_bounds->join(child->layer->paint_bounds());
+    child_has_platform_view =
+        child_has_platform_view || child->context.has_platform_view;
+    child_has_texture_layer =
+        child_has_texture_layer || child->context.has_texture_layer;
+    context->surface_needs_readback = context->surface_needs_readback ||
+                                      child->context.surface_needs_readback;
+    context->has_reusable_backdrop = context->has_reusable_backdrop ||
+                                     child->context.has_reusable_backdrop;
+    for (auto& task : child->deferred_tasks) {
+      task();
+    }
+    child->deferred_tasks.clear();
+  }
+
+  context->has_platform_view = child_has_platform_view;
+  context->has_texture_layer = child_has_texture_layer;
+  set_subtree_has_platform_view(child_has_platform_view);
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -163,7 +314,14 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
-      layer->Paint(context);
+      LayerPaintTimes::ScopedLayer paint_time(context.layer_paint_times,
+                                              layer->unique_id());
+      if (context.layer_record_cache &&
+          LayerRecordCache::ShouldCache(layer.get())) {
+        context.layer_record_cache->Paint(layer.get(), context);
+      } else {
+        layer->Paint(context);
+      }
     }
   }
 }
@@ -174,7 +332,15 @@ void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
   if (!context->has_platform_view && !context->has_texture_layer &&
       context->raster_cache &&
       SkRect::Intersects(context->cull_rect, layer->paint_bounds())) {
-    context->raster_cache->Prepare(context, layer, matrix);
+    if (context->deferred_tasks) {
+      // Rasterizing the layer reads the context, so keep a copy of it.
+      context->deferred_tasks->emplace_back(
+          [context = *context, layer, matrix]() mutable {
+            context.raster_cache->Prepare(&context, layer, matrix);
+          });
+    } else {
+      context->raster_cache->Prepare(context, layer, matrix);
+    }
   }
 }
 
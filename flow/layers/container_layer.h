@@ -13,6 +13,11 @@ namespace flutter {
 
 class ContainerLayer : public Layer {
  public:
+  // Children with at least this many layers in their subtree are prerolled
+  // on the concurrent task runner of the context, if any, as long as there
+  // are at least two of them.
+  static constexpr size_t kParallelPrerollMinSubtreeSize = 32;
+
   ContainerLayer();
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
@@ -29,6 +34,8 @@ class ContainerLayer : public Layer {
 
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  size_t subtree_layer_count() const override;
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
   virtual void DiffChildren(DiffContext* context,
@@ -57,7 +64,15 @@ class ContainerLayer : public Layer {
                                       const SkMatrix& matrix);
 
  private:
+  bool ShouldPrerollChildrenInParallel(PrerollContext* context) const;
+
+  void PrerollChildrenInParallel(PrerollContext* context,
+                                 const SkMatrix& child_matrix,
+                                 SkRect* child_paint_bounds);
+
   std::vector<std::shared_ptr<Layer>> layers_;
+  // Computed on first use. Layer trees don't change once they are built.
+  mutable size_t subtree_layer_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
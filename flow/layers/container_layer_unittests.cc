@@ -7,6 +7,7 @@
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -251,6 +252,57 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, PrerollsLargeSubtreesInParallel) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+
+  const size_t subtree_size = ContainerLayer::kParallelPrerollMinSubtreeSize;
+  std::vector<std::shared_ptr<MockLayer>> mock_layers;
+  auto make_subtree = [&](float left, bool has_platform_view) {
+    auto container = std::make_shared<ContainerLayer>();
+    for (size_t i = 1; i < subtree_size; i++) {
+      SkPath path;
+      path.addRect(SkRect::MakeXYWH(left + i, 0, 1, 1));
+      auto mock_layer = std::make_shared<MockLayer>(
+          path, SkPaint(), has_platform_view && i == subtree_size - 1);
+      mock_layers.push_back(mock_layer);
+      container->Add(mock_layer);
+    }
+    return container;
+  };
+  auto subtree1 = make_subtree(0, false);
+  auto subtree2 = make_subtree(100, true);
+  SkPath small_path;
+  small_path.addRect(SkRect::MakeXYWH(50, 0, 1, 1));
+  auto small_layer = std::make_shared<MockLayer>(small_path);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(subtree1);
+  layer->Add(small_layer);
+  layer->Add(subtree2);
+  ASSERT_EQ(layer->subtree_layer_count(), 2 * subtree_size + 2);
+
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+  preroll_context()->mutators_stack.PushTransform(initial_transform);
+  preroll_context()->concurrent_task_runner = task_runner.get();
+  layer->Preroll(preroll_context(), initial_transform);
+
+  EXPECT_EQ(layer->paint_bounds(),
+            SkRect::MakeLTRB(1, 0, 100 + subtree_size, 1));
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_FALSE(subtree1->subtree_has_platform_view());
+  EXPECT_TRUE(subtree2->subtree_has_platform_view());
+  EXPECT_TRUE(layer->subtree_has_platform_view());
+  EXPECT_EQ(preroll_context()->deferred_tasks, nullptr);
+  EXPECT_EQ(preroll_context()->mutators_stack.size(), 1u);
+  for (auto& mock_layer : mock_layers) {
+    EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+    EXPECT_TRUE(mock_layer->parent_mutators() ==
+                preroll_context()->mutators_stack);
+  }
+  EXPECT_EQ(small_layer->parent_matrix(), initial_transform);
+}
+
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
 using ContainerLayerDiffTest = DiffContextTest;
@@ -456,6 +508,34 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, DistantChangesAreDamagedSeparately) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(950, 950, 1000, 1000));
+
+  auto path1a = SkPath().addRect(SkRect::MakeLTRB(0, 10, 50, 60));
+  auto path2a = SkPath().addRect(SkRect::MakeLTRB(950, 940, 1000, 990));
+
+  MockLayerTree t1;
+  t1.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path1)));
+  t1.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path2)));
+
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 1000, 1000));
+  EXPECT_EQ(damage.frame_damage_rects.size(), 2u);
+
+  MockLayerTree t2;
+  t2.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path1a)));
+  t2.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(path2a)));
+
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 1000, 1000));
+  ASSERT_EQ(damage.frame_damage_rects.size(), 2u);
+  EXPECT_EQ(damage.frame_damage_rects[0], SkIRect::MakeLTRB(0, 0, 50, 60));
+  EXPECT_EQ(damage.frame_damage_rects[1],
+            SkIRect::MakeLTRB(950, 940, 1000, 1000));
+  EXPECT_EQ(damage.buffer_damage_rects, damage.frame_damage_rects);
+}
+
 #endif
 
 }  // namespace testing
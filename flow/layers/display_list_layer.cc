@@ -97,8 +97,12 @@ void DisplayListLayer::Preroll(PrerollContext* context,
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, disp_list, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    RunOrDeferPrerollTask(
+        context, [this, cache, ctm, gr_context = context->gr_context,
+                  dst_color_space = context->dst_color_space]() {
+          cache->Prepare(gr_context, display_list(), ctm, dst_color_space,
+                         is_complex_, will_change_);
+        });
   }
 
   SkRect bounds = disp_list->bounds().makeOffset(offset_.x(), offset_.y());
@@ -123,7 +127,7 @@ void DisplayListLayer::Paint(PaintContext& context) const {
     return;
   }
 
-  display_list()->RenderTo(context.leaf_nodes_canvas);
+  display_list()->RenderTo(context.leaf_nodes_canvas, context.shadow_cache);
 }
 
 }  // namespace flutter
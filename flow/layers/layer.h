@@ -14,9 +14,11 @@
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -61,8 +63,36 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a texture layer during Preroll.
   bool has_texture_layer = false;
+
+  // When set, large enough sibling subtrees are prerolled in parallel on this
+  // task runner. See |ContainerLayer::PrerollChildren|.
+  fml::BasicTaskRunner* concurrent_task_runner = nullptr;
+  // When set, the subtree is prerolled in parallel with its siblings and the
+  // work that must happen on the raster thread in tree order, like preparing
+  // the raster cache, is queued here instead of being done right away.
+  std::vector<fml::closure>* deferred_tasks = nullptr;
+
+  // Set when the tree has a backdrop blur whose filtered backdrop can be
+  // reused in the next frame, provided that the layer trees are diffed.
+  bool has_reusable_backdrop = false;
 };
 
+// Runs |task| right away, or queues it if the subtree is being prerolled in
+// parallel with its siblings. Queued tasks run on the raster thread in tree
+// order once all the siblings are done.
+template <typename Task>
+void RunOrDeferPrerollTask(PrerollContext* context, Task task) {
+  if (context->deferred_tasks) {
+    context->deferred_tasks->emplace_back(std::move(task));
+  } else {
+    task();
+  }
+}
+
+class DisplayListBuilder;
+class LayerPaintTimes;
+class LayerRecordCache;
+class ShadowCache;
 class PictureLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
@@ -151,6 +181,19 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+    // Collects the paint time of each layer when instrumentation is enabled.
+    LayerPaintTimes* layer_paint_times = nullptr;
+    // Set when the leaf_nodes_canvas records into a display list, which is the
+    // case when a layer tree is flattened.
+    DisplayListBuilder* leaf_nodes_builder = nullptr;
+    // Reuses the records of unchanged subtrees when a layer tree is flattened
+    // repeatedly. Requires the leaf_nodes_builder.
+    LayerRecordCache* layer_record_cache = nullptr;
+    // Keeps the shadows of physical shapes across frames when rendering with
+    // the CPU.
+    ShadowCache* shadow_cache = nullptr;
+    // The largest factor by which backdrop blurs may be downsampled.
+    int backdrop_blur_max_downsampling = 1;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -181,6 +224,9 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // The number of layers in the subtree rooted at this layer.
+  virtual size_t subtree_layer_count() const { return 1; }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
@@ -207,6 +253,14 @@ class Layer {
     paint_bounds_ = paint_bounds;
   }
 
+  // The cull rect of the context the layer was last prerolled in, which the
+  // paint bounds of some layers, such as backdrop filters, depend on. It is
+  // set by the container that prerolls the layer.
+  const SkRect& preroll_cull_rect() const { return preroll_cull_rect_; }
+  void set_preroll_cull_rect(const SkRect& cull_rect) {
+    preroll_cull_rect_ = cull_rect;
+  }
+
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
@@ -253,6 +307,7 @@ class Layer {
 
  private:
   SkRect paint_bounds_;
+  SkRect preroll_cull_rect_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
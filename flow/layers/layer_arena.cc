@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+LayerArena::Block::Block(size_t size)
+    : data_(new uint8_t[size]), size_(size) {}
+
+LayerArena::Block::~Block() = default;
+
+void* LayerArena::Block::Allocate(size_t size, size_t alignment) {
+  const uintptr_t start = reinterpret_cast<uintptr_t>(data_.get()) + used_;
+  const size_t padding = (alignment - start % alignment) % alignment;
+  if (padding + size > remaining()) {
+    return nullptr;
+  }
+  used_ += padding + size;
+  return reinterpret_cast<void*>(start + padding);
+}
+
+LayerArena::LayerArena(size_t block_size) : block_size_(block_size) {}
+
+LayerArena::~LayerArena() = default;
+
+fml::RefPtr<LayerArena::Block> LayerArena::Reserve(size_t size) {
+  // Leave room for aligning the allocation.
+  size += alignof(std::max_align_t);
+  if (!current_block_ || current_block_->remaining() < size) {
+    current_block_ = fml::MakeRefCounted<Block>(std::max(block_size_, size));
+    block_count_++;
+  }
+  return current_block_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/memory/ref_ptr.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Allocates layers that only live for a single frame, such as the picture,
+/// texture and platform view layers added by a `SceneBuilder`, from large
+/// blocks of memory.
+///
+/// The layers are still owned through `std::shared_ptr`s, but each layer and
+/// its control block take a single bump allocation from the current block.
+/// Destroying a layer doesn't free any memory. Instead a block is freed at
+/// once when the last layer allocated from it is destroyed, which makes
+/// releasing the layer tree of the previous frame cheap.
+///
+/// Layers may outlive their arena. A layer that outlives its frame, for
+/// instance because it is part of a retained subtree, only keeps the block it
+/// was allocated from alive.
+///
+/// Layers must be made on one thread at a time but may be destroyed on any
+/// thread.
+class LayerArena {
+ private:
+  class Block;
+
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit LayerArena(size_t block_size = kDefaultBlockSize);
+
+  ~LayerArena();
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Make(Args&&... args) {
+    return std::allocate_shared<T>(
+        Allocator<T>(Reserve(sizeof(T) + kControlBlockSize)),
+        std::forward<Args>(args)...);
+  }
+
+  /// The number of blocks allocated by this arena so far.
+  size_t block_count() const { return block_count_; }
+
+ private:
+  // An upper bound of the size of the control block the standard library
+  // places next to an object made with |std::allocate_shared|.
+  static constexpr size_t kControlBlockSize = 64;
+
+  class Block : public fml::RefCountedThreadSafe<Block> {
+   public:
+    // Returns nullptr if there is no room left in the block.
+    void* Allocate(size_t size, size_t alignment);
+
+    bool Contains(const void* pointer) const {
+      const uint8_t* address = static_cast<const uint8_t*>(pointer);
+      return address >= data_.get() && address < data_.get() + size_;
+    }
+
+    size_t remaining() const { return size_ - used_; }
+
+   private:
+    explicit Block(size_t size);
+
+    ~Block();
+
+    std::unique_ptr<uint8_t[]> data_;
+    const size_t size_;
+    size_t used_ = 0;
+
+    FML_FRIEND_REF_COUNTED_THREAD_SAFE(Block);
+    FML_FRIEND_MAKE_REF_COUNTED(Block);
+    FML_DISALLOW_COPY_AND_ASSIGN(Block);
+  };
+
+  // Allocates from the block it was created with and falls back to the heap
+  // when that block is full. Copies of the allocator kept by the control
+  // blocks of the layers hold on to their block.
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(fml::RefPtr<Block> block) : block_(std::move(block)) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) : block_(other.block_) {}
+
+    T* allocate(size_t count) {
+      void* memory = block_->Allocate(count * sizeof(T), alignof(T));
+      if (!memory) {
+        memory = ::operator new(count * sizeof(T));
+      }
+      return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, size_t count) {
+      if (!block_->Contains(pointer)) {
+        ::operator delete(pointer);
+      }
+    }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return block_ == other.block_;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return !operator==(other);
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    fml::RefPtr<Block> block_;
+  };
+
+  // Returns a block with at least |size| bytes left, starting a new one if
+  // the current block is full.
+  fml::RefPtr<Block> Reserve(size_t size);
+
+  const size_t block_size_;
+  fml::RefPtr<Block> current_block_;
+  size_t block_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
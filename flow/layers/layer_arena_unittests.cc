@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <array>
+#include <vector>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class CountedObject {
+ public:
+  CountedObject(int* live_count, int value)
+      : live_count_(live_count), value_(value) {
+    (*live_count_)++;
+  }
+
+  ~CountedObject() { (*live_count_)--; }
+
+  int value() const { return value_; }
+
+ private:
+  int* live_count_;
+  int value_;
+};
+
+}  // namespace
+
+TEST(LayerArenaTest, MakesObjectsInSharedBlocks) {
+  int live_count = 0;
+  std::vector<std::shared_ptr<CountedObject>> objects;
+  {
+    LayerArena arena(4096);
+    for (int i = 0; i < 100; i++) {
+      objects.push_back(arena.Make<CountedObject>(&live_count, i));
+    }
+    EXPECT_LT(arena.block_count(), 5u);
+  }
+
+  // The objects outlive the arena.
+  EXPECT_EQ(live_count, 100);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(objects[i]->value(), i);
+  }
+
+  objects.erase(objects.begin(), objects.begin() + 50);
+  EXPECT_EQ(live_count, 50);
+  objects.clear();
+  EXPECT_EQ(live_count, 0);
+}
+
+TEST(LayerArenaTest, StartsNewBlockWhenFull) {
+  LayerArena arena(1024);
+  auto first = arena.Make<std::array<char, 600>>();
+  auto second = arena.Make<std::array<char, 600>>();
+  EXPECT_EQ(arena.block_count(), 2u);
+
+  // Objects larger than a block get a block of their own.
+  auto large = arena.Make<std::array<char, 4000>>();
+  large->fill('a');
+  EXPECT_EQ(arena.block_count(), 3u);
+}
+
+TEST(LayerArenaTest, MakesLayers) {
+  LayerArena arena;
+  SkPath path;
+  path.addRect(SkRect::MakeWH(10, 10));
+  std::shared_ptr<Layer> layer = arena.Make<MockLayer>(path);
+  std::weak_ptr<Layer> weak_layer = layer;
+
+  auto parent = std::make_shared<ContainerLayer>();
+  parent->Add(std::move(layer));
+  ASSERT_FALSE(weak_layer.expired());
+
+  parent.reset();
+  ASSERT_TRUE(weak_layer.expired());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_record_cache.h"
+
+#include <utility>
+
+#include "flutter/flow/display_list_canvas.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+LayerRecordCache::LayerRecordCache() = default;
+
+LayerRecordCache::~LayerRecordCache() = default;
+
+void LayerRecordCache::PrepareForFlatten(float device_pixel_ratio) {
+  FML_DCHECK(recording_children_.empty());
+  // Some layers, such as physical shapes, paint differently depending on the
+  // device pixel ratio.
+  if (device_pixel_ratio != device_pixel_ratio_) {
+    entries_.clear();
+    device_pixel_ratio_ = device_pixel_ratio;
+  }
+  flatten_count_++;
+}
+
+void LayerRecordCache::SweepAfterFlatten() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (flatten_count_ - it->second.last_used_flatten >= kMaxUnusedFlattens) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void LayerRecordCache::Paint(const Layer* layer,
+                             Layer::PaintContext& context) {
+  FML_DCHECK(context.leaf_nodes_builder);
+  const uint64_t id = layer->unique_id();
+  auto it = entries_.find(id);
+  if (it != entries_.end() &&
+      it->second.cull_rect != layer->preroll_cull_rect()) {
+    entries_.erase(it);
+    it = entries_.end();
+  }
+  if (it == entries_.end()) {
+    TRACE_EVENT0("flutter", "LayerRecordCache::Record");
+    // Record the layer with the top left corner of its bounds at the origin,
+    // as the recorder culls whatever is above or to the left of it.
+    const SkIRect bounds = layer->paint_bounds().roundOut();
+    auto recorder = sk_make_sp<DisplayListCanvasRecorder>(
+        SkRect::MakeIWH(bounds.width(), bounds.height()));
+    recorder->translate(-bounds.left(), -bounds.top());
+
+    Layer::PaintContext record_context = context;
+    record_context.internal_nodes_canvas = recorder.get();
+    record_context.leaf_nodes_canvas = recorder.get();
+    record_context.leaf_nodes_builder = recorder->builder().get();
+
+    recording_children_.emplace_back();
+    layer->Paint(record_context);
+
+    Entry entry;
+    entry.display_list = recorder->Build();
+    entry.origin = {bounds.left(), bounds.top()};
+    entry.cull_rect = layer->preroll_cull_rect();
+    entry.children = std::move(recording_children_.back());
+    recording_children_.pop_back();
+    it = entries_.emplace(id, std::move(entry)).first;
+  }
+
+  const Entry& entry = it->second;
+  MarkUsed(id);
+  if (!recording_children_.empty()) {
+    recording_children_.back().push_back(id);
+  }
+
+  DisplayListBuilder* builder = context.leaf_nodes_builder;
+  builder->save();
+  builder->translate(entry.origin.x(), entry.origin.y());
+  builder->drawDisplayList(entry.display_list);
+  builder->restore();
+}
+
+void LayerRecordCache::MarkUsed(uint64_t id) {
+  auto it = entries_.find(id);
+  if (it == entries_.end() || it->second.last_used_flatten == flatten_count_) {
+    return;
+  }
+  // The records this one references are still needed if a later layer tree
+  // contains their layers but not this one.
+  it->second.last_used_flatten = flatten_count_;
+  for (uint64_t child : it->second.children) {
+    MarkUsed(child);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_RECORD_CACHE_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_RECORD_CACHE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps the display lists that subtrees of a layer tree were recorded into
+/// when it was flattened, so that flattening a later layer tree only records
+/// the subtrees that changed.
+///
+/// Layers can't be changed once their layer tree is built, so a subtree is
+/// identified by the unique id of its root layer. Retained layers keep their
+/// id from one frame to the next. The paint bounds of some layers depend on
+/// the cull rect they are prerolled with, so a record is only reused for the
+/// cull rect it was made with. The record of a subtree references the records
+/// of the subtrees within it instead of copying their operations.
+///
+/// Records that were not used by the last |kMaxUnusedFlattens| flattens are
+/// discarded, so that scenes that are converted to images in turn don't
+/// discard each other's records.
+///
+/// This must only be used on one thread at a time.
+class LayerRecordCache {
+ public:
+  LayerRecordCache();
+
+  ~LayerRecordCache();
+
+  /// Called before flattening a layer tree with the given device pixel ratio.
+  /// Records made for another device pixel ratio are discarded.
+  void PrepareForFlatten(float device_pixel_ratio);
+
+  /// Called after flattening a layer tree. Discards the records that were not
+  /// used by the last |kMaxUnusedFlattens| flattens.
+  void SweepAfterFlatten();
+
+  /// The number of flattens a record is kept for without being used.
+  static constexpr uint64_t kMaxUnusedFlattens = 3;
+
+  /// Whether the given layer should be painted through |Paint| rather than
+  /// directly. Leaf layers are cheaper to paint again than to record.
+  static bool ShouldCache(const Layer* layer) {
+    return layer->subtree_layer_count() > 1;
+  }
+
+  /// Paints the given layer into |context.leaf_nodes_builder|, recording it
+  /// first if there is no record of it yet.
+  void Paint(const Layer* layer, Layer::PaintContext& context);
+
+  /// The number of records in the cache.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    sk_sp<DisplayList> display_list;
+    // The top left corner of the record in the coordinates of the layer.
+    SkIPoint origin;
+    // The cull rect the layer was prerolled with when it was recorded.
+    SkRect cull_rect;
+    // The ids of the records referenced by this one.
+    std::vector<uint64_t> children;
+    // The flatten that last used this record.
+    uint64_t last_used_flatten = 0;
+  };
+
+  void MarkUsed(uint64_t id);
+
+  std::unordered_map<uint64_t, Entry> entries_;
+  float device_pixel_ratio_ = 0;
+  // The number of flattens so far, including the current one.
+  uint64_t flatten_count_ = 0;
+  // The children of the records that are being made, innermost last.
+  std::vector<std::vector<uint64_t>> recording_children_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerRecordCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_RECORD_CACHE_H_
@@ -4,8 +4,11 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/flow/frame_statistics.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/display_list_canvas.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_record_cache.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -22,6 +25,50 @@ LayerTree::LayerTree(const SkISize& frame_size, float device_pixel_ratio)
   FML_CHECK(device_pixel_ratio_ != 0.0f);
 }
 
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+
+Damage LayerTree::ComputeDamage(const LayerTree* old_layer_tree) {
+  TRACE_EVENT0("flutter", "LayerTree::ComputeDamage");
+
+  const SkIRect frame_rect = SkIRect::MakeSize(frame_size_);
+  Damage full_damage;
+  full_damage.frame_damage = frame_rect;
+  full_damage.buffer_damage = frame_rect;
+  full_damage.frame_damage_rects = {frame_rect};
+  full_damage.buffer_damage_rects = {frame_rect};
+
+  // The paint regions of a layer tree are only recorded when it is diffed, so
+  // an empty map means that the old layer tree can't be diffed against.
+  const bool can_diff = old_layer_tree && old_layer_tree != this &&
+                        old_layer_tree->root_layer() &&
+                        old_layer_tree->frame_size() == frame_size_ &&
+                        !old_layer_tree->paint_region_map().empty();
+
+  paint_region_map_.clear();
+  if (!root_layer_) {
+    return full_damage;
+  }
+
+  const PaintRegionMap no_paint_regions;
+  DiffContext context(
+      frame_size_, device_pixel_ratio_, paint_region_map_,
+      can_diff ? old_layer_tree->paint_region_map() : no_paint_regions);
+  context.PushCullRect(SkRect::Make(frame_rect));
+  if (can_diff) {
+    root_layer_->Diff(&context, old_layer_tree->root_layer());
+    context.statistics().LogStatistics();
+    return context.ComputeDamage(SkIRect::MakeEmpty());
+  }
+
+  // Still diff against nothing so that the paint regions get recorded.
+  DiffContext::AutoSubtreeRestore subtree(&context);
+  context.MarkSubtreeDirty();
+  root_layer_->Diff(&context, nullptr);
+  return full_damage;
+}
+
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache) {
   TRACE_EVENT0("flutter", "LayerTree::Preroll");
@@ -49,8 +96,11 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.concurrent_task_runner =
+      frame.context().concurrent_preroll_task_runner();
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
+  has_reusable_backdrop_ = context.has_reusable_backdrop;
   return context.surface_needs_readback;
 }
 
@@ -83,9 +133,19 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
-      device_pixel_ratio_};
+      device_pixel_ratio_,
+      frame.layer_paint_times()};
+  context.backdrop_blur_max_downsampling =
+      frame.context().backdrop_blur_max_downsampling();
+  // Shadows are cheap enough to draw on the GPU that the images wouldn't pay
+  // for themselves.
+  if (!frame.gr_context()) {
+    context.shadow_cache = &frame.context().shadow_cache();
+  }
 
   if (root_layer_->needs_painting(context)) {
+    LayerPaintTimes::ScopedLayer paint_time(context.layer_paint_times,
+                                            root_layer_->unique_id());
     root_layer_->Paint(context);
   }
 }
@@ -100,6 +160,29 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
     return nullptr;
   }
 
+  FlattenInto(canvas, nullptr, nullptr);
+  return recorder.finishRecordingAsPicture();
+}
+
+sk_sp<DisplayList> LayerTree::FlattenToDisplayList(
+    const SkRect& bounds,
+    LayerRecordCache* record_cache) {
+  TRACE_EVENT0("flutter", "LayerTree::FlattenToDisplayList");
+
+  auto recorder = sk_make_sp<DisplayListCanvasRecorder>(bounds);
+  if (record_cache) {
+    record_cache->PrepareForFlatten(device_pixel_ratio_);
+  }
+  FlattenInto(recorder.get(), recorder->builder().get(), record_cache);
+  if (record_cache) {
+    record_cache->SweepAfterFlatten();
+  }
+  return recorder->Build();
+}
+
+void LayerTree::FlattenInto(SkCanvas* canvas,
+                            DisplayListBuilder* builder,
+                            LayerRecordCache* record_cache) {
   MutatorsStack unused_stack;
   const Stopwatch unused_stopwatch;
   TextureRegistry unused_texture_registry;
@@ -136,7 +219,10 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       unused_texture_registry,  // texture registry (not supported)
       nullptr,                  // raster cache
       false,                    // checkerboard offscreen layers
-      device_pixel_ratio_       // ratio between logical and physical
+      device_pixel_ratio_,      // ratio between logical and physical
+      nullptr,                  // layer paint times
+      builder,                  // leaf nodes builder
+      record_cache              // layer record cache
   };
 
   // Even if we don't have a root layer, we still need to create an empty
@@ -148,8 +234,6 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       root_layer_->Paint(paint_context);
     }
   }
-
-  return recorder.finishRecordingAsPicture();
 }
 
 }  // namespace flutter
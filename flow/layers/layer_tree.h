@@ -9,7 +9,9 @@
 #include <memory>
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_record_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -31,11 +33,22 @@ class LayerTree {
   bool Preroll(CompositorContext::ScopedFrame& frame,
                bool ignore_raster_cache = false);
 
+  // Whether the last preroll found a backdrop blur that can reuse its filtered
+  // backdrop when the next layer tree is diffed against this one.
+  bool has_reusable_backdrop() const { return has_reusable_backdrop_; }
+
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
   sk_sp<SkPicture> Flatten(const SkRect& bounds);
 
+  // Same as |Flatten| but records into a display list. If a record cache is
+  // given, the subtrees whose records were kept in it by a previous call are
+  // not recorded again.
+  sk_sp<DisplayList> FlattenToDisplayList(
+      const SkRect& bounds,
+      LayerRecordCache* record_cache = nullptr);
+
   Layer* root_layer() const { return root_layer_.get(); }
 
   void set_root_layer(std::shared_ptr<Layer> root_layer) {
@@ -50,6 +63,14 @@ class LayerTree {
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  // Diffs this layer tree against the one previously rasterized to the same
+  // surface and returns the parts of the frame that changed. The paint regions
+  // of this layer tree are recorded for the next diff.
+  //
+  // The whole frame is damaged if there is no old layer tree, or if it has a
+  // different size or was not diffed itself.
+  Damage ComputeDamage(const LayerTree* old_layer_tree);
+
 #endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 
   // The number of frame intervals missed after which the compositor must
@@ -72,12 +93,17 @@ class LayerTree {
   }
 
  private:
+  void FlattenInto(SkCanvas* canvas,
+                   DisplayListBuilder* builder,
+                   LayerRecordCache* record_cache);
+
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
   const float device_pixel_ratio_;  // Logical / Physical pixels ratio.
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  bool has_reusable_backdrop_ = false;
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
   PaintRegionMap paint_region_map_;
@@ -4,13 +4,24 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <cstring>
+#include <functional>
+
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
 #include "flutter/testing/mock_canvas.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
 namespace testing {
@@ -193,5 +204,150 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+class PaintCountingContainerLayer : public ContainerLayer {
+ public:
+  void Paint(PaintContext& context) const override {
+    paint_count_++;
+    ContainerLayer::Paint(context);
+  }
+
+  int paint_count() const { return paint_count_; }
+
+ private:
+  mutable int paint_count_ = 0;
+};
+
+std::shared_ptr<PictureLayer> MakeRectPictureLayer(const SkPoint& offset,
+                                                   const SkRect& rect,
+                                                   SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(rect);
+  SkPaint paint;
+  paint.setColor(color);
+  canvas->drawRect(rect, paint);
+  return std::make_shared<PictureLayer>(
+      offset,
+      SkiaGPUObject<SkPicture>(recorder.finishRecordingAsPicture(), nullptr),
+      false, false);
+}
+
+// A subtree whose layers paint at fractional translations, which picture and
+// opacity layers snap to whole pixels by replacing the canvas matrix.
+std::shared_ptr<PaintCountingContainerLayer> MakeRetainedSubtree() {
+  auto transform = std::make_shared<TransformLayer>(
+      SkMatrix::Translate(3.5f, 2.25f).preScale(1.5f, 1.5f));
+  auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(4, 5));
+  opacity->Add(MakeRectPictureLayer(SkPoint::Make(2, 0),
+                                    SkRect::MakeWH(10, 10), SK_ColorRED));
+  opacity->Add(MakeRectPictureLayer(SkPoint::Make(10, 10),
+                                    SkRect::MakeWH(8, 6), SK_ColorBLUE));
+  transform->Add(opacity);
+  auto subtree = std::make_shared<PaintCountingContainerLayer>();
+  subtree->Add(transform);
+  return subtree;
+}
+
+SkBitmap Rasterize(const std::function<void(SkCanvas*)>& draw) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(64, 64);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorTRANSPARENT);
+  draw(&canvas);
+  return bitmap;
+}
+
+bool HaveSamePixels(const SkBitmap& a, const SkBitmap& b) {
+  return a.computeByteSize() == b.computeByteSize() &&
+         memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()) == 0;
+}
+
+TEST_F(LayerTreeTest, FlattenToDisplayListMatchesFlatten) {
+  auto retained = MakeRetainedSubtree();
+  LayerRecordCache cache;
+  const SkRect bounds = SkRect::MakeWH(64, 64);
+
+  for (int frame = 0; frame < 2; frame++) {
+    // Every frame has new layers around the retained subtree.
+    LayerTree tree(SkISize::Make(64, 64), 1.0f);
+    auto root = std::make_shared<ContainerLayer>();
+    auto offset = std::make_shared<TransformLayer>(
+        SkMatrix::Translate(frame * 7.25f, 0));
+    offset->Add(MakeRectPictureLayer(SkPoint::Make(1, 40),
+                                     SkRect::MakeWH(5, 5), SK_ColorGREEN));
+    root->Add(retained);
+    root->Add(offset);
+    tree.set_root_layer(root);
+
+    auto picture = tree.Flatten(bounds);
+    ASSERT_TRUE(picture);
+    auto display_list = tree.FlattenToDisplayList(bounds, &cache);
+    ASSERT_TRUE(display_list);
+    const SkBitmap expected =
+        Rasterize([&](SkCanvas* canvas) { canvas->drawPicture(picture); });
+    const SkBitmap actual = Rasterize(
+        [&](SkCanvas* canvas) { display_list->RenderTo(canvas); });
+    EXPECT_TRUE(HaveSamePixels(expected, actual)) << "frame " << frame;
+  }
+  // Once by Flatten in each frame, and once to record it.
+  EXPECT_EQ(retained->paint_count(), 3);
+}
+
+TEST_F(LayerTreeTest, FlattenToDisplayListKeepsRecordsOfAlternatingScenes) {
+  auto retained1 = MakeRetainedSubtree();
+  auto retained2 = MakeRetainedSubtree();
+  LayerRecordCache cache;
+  const SkRect bounds = SkRect::MakeWH(64, 64);
+
+  auto flatten = [&](std::shared_ptr<Layer> retained) {
+    LayerTree tree(SkISize::Make(64, 64), 1.0f);
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    tree.set_root_layer(root);
+    tree.FlattenToDisplayList(bounds, &cache);
+  };
+  for (int i = 0; i < 3; i++) {
+    flatten(retained1);
+    flatten(retained2);
+  }
+  EXPECT_EQ(retained1->paint_count(), 1);
+  EXPECT_EQ(retained2->paint_count(), 1);
+
+  // Records that go unused for long enough are discarded.
+  const size_t size = cache.size();
+  for (uint64_t i = 0; i < LayerRecordCache::kMaxUnusedFlattens; i++) {
+    flatten(retained2);
+  }
+  EXPECT_LT(cache.size(), size);
+  flatten(retained1);
+  EXPECT_EQ(retained1->paint_count(), 2);
+}
+
+TEST_F(LayerTreeTest, FlattenToDisplayListRecordsAgainForAnotherCullRect) {
+  // The paint bounds of a backdrop filter extend to the cull rect.
+  auto retained = std::make_shared<PaintCountingContainerLayer>();
+  auto backdrop = std::make_shared<BackdropFilterLayer>(
+      SkImageFilters::Blur(2, 2, nullptr), SkBlendMode::kSrcOver);
+  backdrop->Add(MakeRectPictureLayer(SkPoint::Make(0, 0),
+                                     SkRect::MakeWH(8, 8), SK_ColorRED));
+  retained->Add(backdrop);
+  LayerRecordCache cache;
+  const SkRect bounds = SkRect::MakeWH(64, 64);
+
+  auto flatten = [&](const SkRect& clip) {
+    LayerTree tree(SkISize::Make(64, 64), 1.0f);
+    auto root = std::make_shared<ClipRectLayer>(clip, Clip::hardEdge);
+    root->Add(retained);
+    tree.set_root_layer(root);
+    tree.FlattenToDisplayList(bounds, &cache);
+    return backdrop->paint_bounds();
+  };
+  EXPECT_EQ(flatten(SkRect::MakeWH(32, 32)), SkRect::MakeWH(32, 32));
+  EXPECT_EQ(retained->paint_count(), 1);
+  EXPECT_EQ(flatten(SkRect::MakeWH(48, 16)), SkRect::MakeWH(48, 16));
+  EXPECT_EQ(retained->paint_count(), 2);
+  flatten(SkRect::MakeWH(48, 16));
+  EXPECT_EQ(retained->paint_count(), 2);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/physical_shape_layer.h"
 
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/shadow_cache.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
 namespace flutter {
@@ -81,7 +82,8 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
 
   if (elevation_ != 0) {
     DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
-               SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
+               SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio,
+               context.shadow_cache);
   }
 
   // Call drawPath without clip if possible for better performance.
@@ -176,7 +178,8 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                                     SkColor color,
                                     float elevation,
                                     bool transparentOccluder,
-                                    SkScalar dpr) {
+                                    SkScalar dpr,
+                                    ShadowCache* shadow_cache) {
   const SkScalar kAmbientAlpha = 0.039f;
   const SkScalar kSpotAlpha = 0.25f;
 
@@ -191,10 +194,23 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
   SkColor ambientColor, spotColor;
   SkShadowUtils::ComputeTonalColors(inAmbient, inSpot, &ambientColor,
                                     &spotColor);
-  SkShadowUtils::DrawShadow(
-      canvas, path, SkPoint3::Make(0, 0, dpr * elevation),
-      SkPoint3::Make(shadow_x, shadow_y, dpr * kLightHeight),
-      dpr * kLightRadius, ambientColor, spotColor, flags);
+  const SkPoint3 light_position =
+      SkPoint3::Make(shadow_x, shadow_y, dpr * kLightHeight);
+  auto draw_shadow = [&](SkCanvas* target, const SkPoint3& light) {
+    SkShadowUtils::DrawShadow(target, path,
+                              SkPoint3::Make(0, 0, dpr * elevation), light,
+                              dpr * kLightRadius, ambientColor, spotColor,
+                              flags);
+  };
+
+  if (shadow_cache &&
+      shadow_cache->Draw(canvas, path, color, elevation, transparentOccluder,
+                         dpr, light_position,
+                         ComputeShadowBounds(bounds, elevation, dpr),
+                         draw_shadow)) {
+    return;
+  }
+  draw_shadow(canvas, light_position);
 }
 
 }  // namespace flutter
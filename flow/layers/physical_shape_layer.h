@@ -25,7 +25,8 @@ class PhysicalShapeLayer : public ContainerLayer {
                          SkColor color,
                          float elevation,
                          bool transparentOccluder,
-                         SkScalar dpr);
+                         SkScalar dpr,
+                         ShadowCache* shadow_cache = nullptr);
 
 #ifdef FLUTTER_ENABLE_DIFF_CONTEXT
 
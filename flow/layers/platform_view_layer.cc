@@ -23,6 +23,18 @@ void PlatformViewLayer::Preroll(PrerollContext* context,
   }
   context->has_platform_view = true;
   set_subtree_has_platform_view(true);
+  if (context->deferred_tasks) {
+    // The embedder is not thread-safe and expects the platform views in tree
+    // order. Hold on to the params until the deferred tasks are run.
+    context->deferred_tasks->emplace_back(
+        [view_embedder = context->view_embedder, view_id = view_id_,
+         params =
+             EmbeddedViewParams(matrix, size_, context->mutators_stack)]() {
+          view_embedder->PrerollCompositeEmbeddedView(
+              view_id, std::make_unique<EmbeddedViewParams>(params));
+        });
+    return;
+  }
   std::unique_ptr<EmbeddedViewParams> params =
       std::make_unique<EmbeddedViewParams>(matrix, size_,
                                            context->mutators_stack);
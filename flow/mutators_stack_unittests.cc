@@ -3,11 +3,21 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/embedded_views.h"
+
+#include <type_traits>
+
 #include "gtest/gtest.h"
 
 namespace flutter {
 namespace testing {
 
+// Containers of mutators and stacks move them instead of copying them on
+// reallocation.
+static_assert(std::is_nothrow_move_constructible_v<Mutator>);
+static_assert(std::is_nothrow_move_assignable_v<Mutator>);
+static_assert(std::is_nothrow_move_constructible_v<MutatorsStack>);
+static_assert(std::is_nothrow_move_assignable_v<MutatorsStack>);
+
 TEST(MutatorsStack, Initialization) {
   MutatorsStack stack;
   ASSERT_TRUE(true);
@@ -36,11 +46,11 @@ TEST(MutatorsStack, CopyAndUpdateTheCopy) {
   ASSERT_TRUE(copy.is_empty());
   ASSERT_TRUE(!stack.is_empty());
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
   ++iter;
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRect) {
@@ -48,8 +58,8 @@ TEST(MutatorsStack, PushClipRect) {
   auto rect = SkRect::MakeEmpty();
   stack.PushClipRect(rect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRRect) {
@@ -57,8 +67,8 @@ TEST(MutatorsStack, PushClipRRect) {
   auto rrect = SkRRect::MakeEmpty();
   stack.PushClipRRect(rrect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
 }
 
 TEST(MutatorsStack, PushClipPath) {
@@ -66,8 +76,8 @@ TEST(MutatorsStack, PushClipPath) {
   SkPath path;
   stack.PushClipPath(path);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == flutter::MutatorType::clip_path);
-  ASSERT_TRUE(iter->get()->GetPath() == path);
+  ASSERT_TRUE(iter->GetType() == flutter::MutatorType::clip_path);
+  ASSERT_TRUE(iter->GetPath() == path);
 }
 
 TEST(MutatorsStack, PushTransform) {
@@ -76,8 +86,8 @@ TEST(MutatorsStack, PushTransform) {
   matrix.setIdentity();
   stack.PushTransform(matrix);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-  ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+  ASSERT_TRUE(iter->GetType() == MutatorType::transform);
+  ASSERT_TRUE(iter->GetMatrix() == matrix);
 }
 
 TEST(MutatorsStack, PushOpacity) {
@@ -85,8 +95,8 @@ TEST(MutatorsStack, PushOpacity) {
   int alpha = 240;
   stack.PushOpacity(alpha);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::opacity);
-  ASSERT_TRUE(iter->get()->GetAlpha() == 240);
+  ASSERT_TRUE(iter->GetType() == MutatorType::opacity);
+  ASSERT_TRUE(iter->GetAlpha() == 240);
 }
 
 TEST(MutatorsStack, Pop) {
@@ -113,16 +123,16 @@ TEST(MutatorsStack, Traversal) {
   while (iter != stack.Top()) {
     switch (index) {
       case 0:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rrect);
-        ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::clip_rrect);
+        ASSERT_TRUE(iter->GetRRect() == rrect);
         break;
       case 1:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::clip_rect);
-        ASSERT_TRUE(iter->get()->GetRect() == rect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::clip_rect);
+        ASSERT_TRUE(iter->GetRect() == rect);
         break;
       case 2:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::transform);
-        ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+        ASSERT_TRUE(iter->GetType() == MutatorType::transform);
+        ASSERT_TRUE(iter->GetMatrix() == matrix);
         break;
       default:
         break;
@@ -160,6 +170,100 @@ TEST(MutatorsStack, Equality) {
   ASSERT_TRUE(stack == stackOther);
 }
 
+TEST(MutatorsStack, EqualStacksHaveEqualHashes) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  stack.PushClipRect(SkRect::MakeWH(10, 10));
+  stack.PushClipRRect(SkRRect::MakeRectXY(SkRect::MakeWH(10, 10), 2, 2));
+  stack.PushClipPath(SkPath().addOval(SkRect::MakeWH(5, 5)));
+  stack.PushOpacity(128);
+
+  MutatorsStack copy = stack;
+  ASSERT_TRUE(copy == stack);
+  ASSERT_EQ(copy.Hash(), stack.Hash());
+
+  copy.Pop();
+  copy.PushOpacity(127);
+  ASSERT_TRUE(copy != stack);
+  ASSERT_NE(copy.Hash(), stack.Hash());
+}
+
+TEST(MutatorsStack, PopRestoresTheHash) {
+  MutatorsStack stack;
+  const size_t empty_hash = stack.Hash();
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  const size_t transform_hash = stack.Hash();
+  for (size_t i = 0; i < MutatorsStack::kInlineCapacity * 2; i++) {
+    stack.PushClipRect(SkRect::MakeWH(i, i));
+  }
+  for (size_t i = 0; i < MutatorsStack::kInlineCapacity * 2; i++) {
+    stack.Pop();
+  }
+  ASSERT_EQ(stack.Hash(), transform_hash);
+  stack.Pop();
+  ASSERT_EQ(stack.Hash(), empty_hash);
+
+  MutatorsStack moved = std::move(stack);
+  ASSERT_EQ(moved.Hash(), empty_hash);
+}
+
+TEST(MutatorsStack, HashDependsOnTheOrder) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  stack.PushOpacity(127);
+  MutatorsStack reversed;
+  reversed.PushOpacity(127);
+  reversed.PushTransform(SkMatrix::Scale(2, 2));
+  ASSERT_TRUE(stack != reversed);
+  ASSERT_NE(stack.Hash(), reversed.Hash());
+}
+
+TEST(MutatorsStack, GrowsBeyondInlineCapacity) {
+  MutatorsStack stack;
+  const int count = MutatorsStack::kInlineCapacity * 3;
+  for (int i = 0; i < count; i++) {
+    stack.PushClipRect(SkRect::MakeWH(i, i));
+  }
+  ASSERT_EQ(stack.size(), static_cast<size_t>(count));
+
+  MutatorsStack copy = stack;
+  ASSERT_TRUE(copy == stack);
+
+  int index = 0;
+  for (auto iter = stack.Begin(); iter != stack.End(); ++iter, ++index) {
+    ASSERT_TRUE(iter->GetRect() == SkRect::MakeWH(index, index));
+  }
+  ASSERT_EQ(index, count);
+
+  while (!copy.is_empty()) {
+    copy.Pop();
+  }
+  ASSERT_EQ(copy.size(), 0u);
+}
+
+TEST(MutatorsStack, MoveLeavesSourceEmpty) {
+  SkPath path;
+  path.addRect(SkRect::MakeWH(3, 3));
+  for (size_t count : {size_t{2}, MutatorsStack::kInlineCapacity + 1}) {
+    MutatorsStack stack;
+    for (size_t i = 0; i < count; i++) {
+      stack.PushClipPath(path);
+    }
+    MutatorsStack expected = stack;
+
+    MutatorsStack moved = std::move(stack);
+    ASSERT_TRUE(moved == expected);
+    ASSERT_TRUE(stack.is_empty());
+
+    MutatorsStack assigned;
+    assigned.PushOpacity(10);
+    assigned = std::move(moved);
+    ASSERT_TRUE(assigned == expected);
+    ASSERT_TRUE(moved.is_empty());
+    ASSERT_TRUE(assigned.Bottom()->GetPath() == path);
+  }
+}
+
 TEST(Mutator, Initialization) {
   SkRect rect = SkRect::MakeEmpty();
   Mutator mutator = Mutator(rect);
@@ -258,5 +362,25 @@ TEST(Mutator, UnEquality) {
   ASSERT_TRUE(mutator2 != otherMutator2);
 }
 
+TEST(Mutator, AssignmentAndHash) {
+  SkPath path;
+  path.addCircle(5, 5, 5);
+  Mutator mutator = Mutator(path);
+  Mutator other = Mutator(SkRect::MakeWH(5, 5));
+  ASSERT_TRUE(mutator != other);
+
+  other = mutator;
+  ASSERT_TRUE(other.GetType() == MutatorType::clip_path);
+  ASSERT_TRUE(other == mutator);
+  ASSERT_EQ(other.Hash(), mutator.Hash());
+
+  other = Mutator(120);
+  ASSERT_TRUE(other.GetType() == MutatorType::opacity);
+  ASSERT_EQ(other.GetAlpha(), 120);
+  ASSERT_TRUE(other == Mutator(120));
+  ASSERT_EQ(other.Hash(), Mutator(120).Hash());
+  ASSERT_NE(other.Hash(), Mutator(121).Hash());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -10,6 +10,7 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -203,7 +204,10 @@ void RasterCache::Prepare(PrerollContext* context,
   entry.access_count++;
   entry.used_this_frame = true;
   if (!entry.image) {
+    const auto start = fml::TimePoint::Now();
     entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - start);
   }
 }
 
@@ -275,8 +279,11 @@ bool RasterCache::Prepare(GrDirectContext* context,
   }
 
   if (!entry.image) {
+    const auto start = fml::TimePoint::Now();
     entry.image = RasterizePicture(picture, context, transformation_matrix,
                                    dst_color_space, checkerboard_images_);
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - start);
     picture_cached_this_frame_++;
   }
   return true;
@@ -309,20 +316,26 @@ bool RasterCache::Prepare(GrDirectContext* context,
     return false;
   }
 
-  DisplayListRasterCacheKey cache_key(display_list->unique_id(),
-                                      transformation_matrix);
+  DisplayListRasterCacheKey cache_key =
+      MakeDisplayListKey(*display_list, transformation_matrix);
 
   // Creates an entry, if not present prior.
   Entry& entry = display_list_cache_[cache_key];
+  if (!MatchDisplayList(entry, *display_list)) {
+    return false;
+  }
   if (entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
     return false;
   }
 
   if (!entry.image) {
+    const auto start = fml::TimePoint::Now();
     entry.image =
         RasterizeDisplayList(display_list, context, transformation_matrix,
                              dst_color_space, checkerboard_images_);
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - start);
     picture_cached_this_frame_++;
   }
   return true;
@@ -349,10 +362,11 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
 
 bool RasterCache::Draw(const DisplayList& display_list,
                        SkCanvas& canvas) const {
-  DisplayListRasterCacheKey cache_key(display_list.unique_id(),
-                                      canvas.getTotalMatrix());
+  DisplayListRasterCacheKey cache_key =
+      MakeDisplayListKey(display_list, canvas.getTotalMatrix());
   auto it = display_list_cache_.find(cache_key);
-  if (it == display_list_cache_.end()) {
+  if (it == display_list_cache_.end() ||
+      !MatchDisplayList(it->second, display_list)) {
     return false;
   }
 
@@ -394,6 +408,7 @@ void RasterCache::SweepAfterFrame() {
   SweepOneCacheAfterFrame(display_list_cache_);
   SweepOneCacheAfterFrame(layer_cache_);
   picture_cached_this_frame_ = 0;
+  rasterize_time_this_frame_ = fml::TimeDelta::Zero();
   TraceStatsToTimeline();
 }
 
@@ -420,6 +435,41 @@ size_t RasterCache::GetDisplayListCachedEntriesCount() const {
   return display_list_cache_.size();
 }
 
+void RasterCache::SetUseDisplayListContentKeys(bool use_content_keys) {
+  if (use_display_list_content_keys_ == use_content_keys) {
+    return;
+  }
+
+  use_display_list_content_keys_ = use_content_keys;
+  display_list_cache_.clear();
+}
+
+DisplayListRasterCacheKey RasterCache::MakeDisplayListKey(
+    const DisplayList& display_list,
+    const SkMatrix& matrix) const {
+  return DisplayListRasterCacheKey(use_display_list_content_keys_
+                                       ? display_list.content_hash()
+                                       : display_list.unique_id(),
+                                   matrix);
+}
+
+bool RasterCache::MatchDisplayList(Entry& entry,
+                                   const DisplayList& display_list) const {
+  if (!use_display_list_content_keys_ ||
+      entry.display_list.get() == &display_list) {
+    return true;
+  }
+  if (entry.display_list && !entry.display_list->Equals(display_list)) {
+    // The hashes collided. Leave the entry to the display list it was made
+    // for.
+    return false;
+  }
+  // Hold on to the latest display list, so that the next frame finds the
+  // same one and can skip the comparison.
+  entry.display_list = sk_ref_sp(&display_list);
+  return true;
+}
+
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   if (checkerboard_images_ == checkerboard) {
     return;
@@ -12,6 +12,7 @@
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
 
@@ -180,8 +181,20 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // Whether display lists are cached by their content rather than their
+  // identity, so that re-recording an unchanged display list keeps its
+  // cached image. Display lists with the same content hash are compared
+  // before an image is reused.
+  void SetUseDisplayListContentKeys(bool use_content_keys);
+
   size_t GetCachedEntriesCount() const;
 
+  // The time spent rasterizing new cache entries since the last sweep, that
+  // is, during the frame being rasterized.
+  fml::TimeDelta GetRasterizeTimeThisFrame() const {
+    return rasterize_time_this_frame_;
+  }
+
   size_t GetLayerCachedEntriesCount() const;
 
   size_t GetPictureCachedEntriesCount() const;
@@ -223,8 +236,19 @@ class RasterCache {
     bool used_this_frame = false;
     size_t access_count = 0;
     std::unique_ptr<RasterCacheResult> image;
+    // The last display list this entry was used for, when display lists are
+    // cached by their content.
+    sk_sp<DisplayList> display_list;
   };
 
+  DisplayListRasterCacheKey MakeDisplayListKey(const DisplayList& display_list,
+                                               const SkMatrix& matrix) const;
+
+  // Returns whether the entry can be used for the display list. Entries that
+  // are keyed on content may belong to another display list whose content
+  // hash is the same.
+  bool MatchDisplayList(Entry& entry, const DisplayList& display_list) const;
+
   template <class Cache>
   static void SweepOneCacheAfterFrame(Cache& cache) {
     std::vector<typename Cache::iterator> dead;
@@ -245,10 +269,12 @@ class RasterCache {
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
+  fml::TimeDelta rasterize_time_this_frame_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable DisplayListRasterCacheKey::Map<Entry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
   bool checkerboard_images_;
+  bool use_display_list_content_keys_ = false;
 
   void TraceStatsToTimeline() const;
 
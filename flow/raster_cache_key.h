@@ -52,8 +52,9 @@ class RasterCacheKey {
 // The ID is the uint32_t picture uniqueID
 using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
 
-// The ID is the uint32_t DisplayList uniqueID
-using DisplayListRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is the uint32_t DisplayList unique_id, or its content_hash if the
+// raster cache is keyed on the content of display lists
+using DisplayListRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
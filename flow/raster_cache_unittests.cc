@@ -24,6 +24,13 @@ sk_sp<SkPicture> GetSamplePicture() {
   return recorder.finishRecordingAsPicture();
 }
 
+sk_sp<DisplayList> GetSampleDisplayList() {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80));
+  return builder.Build();
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -164,5 +171,55 @@ TEST(RasterCache, DeviceRectRoundOut) {
   ASSERT_TRUE(cache.Draw(*picture, canvas));
 }
 
+TEST(RasterCache, ContentKeysMatchRerecordedDisplayLists) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetUseDisplayListContentKeys(true);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  auto display_list = GetSampleDisplayList();
+  ASSERT_FALSE(cache.Prepare(NULL, display_list.get(), matrix, srgb.get(),
+                             true, false));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, display_list.get(), matrix, srgb.get(),
+                            true, false));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  // The same content recorded again reuses the cached image.
+  auto rerecorded = GetSampleDisplayList();
+  ASSERT_NE(rerecorded->unique_id(), display_list->unique_id());
+  ASSERT_TRUE(
+      cache.Prepare(NULL, rerecorded.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*rerecorded, dummy_canvas));
+  ASSERT_EQ(cache.GetDisplayListCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, DisplayListsAreKeyedByIdentityByDefault) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  auto display_list = GetSampleDisplayList();
+  cache.Prepare(NULL, display_list.get(), matrix, srgb.get(), true, false);
+  cache.Draw(*display_list, dummy_canvas);
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, display_list.get(), matrix, srgb.get(),
+                            true, false));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+
+  auto rerecorded = GetSampleDisplayList();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, rerecorded.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*rerecorded, dummy_canvas));
+}
+
 }  // namespace testing
 }  // namespace flutter
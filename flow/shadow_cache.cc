@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shadow_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns the shape of the path moved to the origin if it is a rectangle, an
+// oval or a rounded rectangle.
+bool GetNormalizedRRect(const SkPath& path, SkRRect* rrect) {
+  SkRect rect;
+  if (path.isRect(&rect)) {
+    rrect->setRect(rect);
+  } else if (path.isOval(&rect)) {
+    rrect->setOval(rect);
+  } else if (!path.isRRect(rrect)) {
+    return false;
+  }
+  rrect->offset(-rrect->rect().left(), -rrect->rect().top());
+  return true;
+}
+
+}  // namespace
+
+ShadowCache::ShadowCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+ShadowCache::~ShadowCache() = default;
+
+bool ShadowCache::Key::operator==(const Key& other) const {
+  return path_id == other.path_id && rrect == other.rrect &&
+         color == other.color && elevation == other.elevation &&
+         dpr == other.dpr &&
+         transparent_occluder == other.transparent_occluder &&
+         scale_x == other.scale_x && scale_y == other.scale_y &&
+         light_x == other.light_x && light_y == other.light_y &&
+         subpixel_x == other.subpixel_x && subpixel_y == other.subpixel_y;
+}
+
+size_t ShadowCache::KeyHash::operator()(const Key& key) const {
+  const SkVector upper_left = key.rrect.radii(SkRRect::kUpperLeft_Corner);
+  const SkVector lower_right = key.rrect.radii(SkRRect::kLowerRight_Corner);
+  return fml::HashCombine(
+      key.path_id, key.rrect.width(), key.rrect.height(), upper_left.x(),
+      upper_left.y(), lower_right.x(), lower_right.y(), key.color,
+      key.elevation, key.dpr, key.transparent_occluder, key.scale_x,
+      key.scale_y, key.light_x, key.light_y, key.subpixel_x, key.subpixel_y);
+}
+
+bool ShadowCache::Draw(SkCanvas* canvas,
+                       const SkPath& path,
+                       SkColor color,
+                       float elevation,
+                       bool transparent_occluder,
+                       float dpr,
+                       const SkPoint3& light_position,
+                       const SkRect& shadow_bounds,
+                       const RenderShadow& render) {
+  const SkMatrix& matrix = canvas->getTotalMatrix();
+  if (!matrix.isScaleTranslate() || matrix.getScaleX() <= 0 ||
+      matrix.getScaleY() <= 0 || path.isInverseFillType()) {
+    return false;
+  }
+  const SkScalar z = elevation * dpr;
+  if (z <= 0 || z >= light_position.fZ) {
+    return false;
+  }
+
+  Key key;
+  if (GetNormalizedRRect(path, &key.rrect)) {
+    key.path_id = 0;
+  } else {
+    key.path_id = path.getGenerationID();
+    key.rrect.setEmpty();
+  }
+  key.color = color;
+  key.elevation = elevation;
+  key.dpr = dpr;
+  key.transparent_occluder = transparent_occluder;
+  key.scale_x = matrix.getScaleX();
+  key.scale_y = matrix.getScaleY();
+
+  const SkRect device_bounds = matrix.mapRect(path.getBounds());
+  const SkScalar anchor_x = std::floor(device_bounds.left());
+  const SkScalar anchor_y = std::floor(device_bounds.top());
+  key.subpixel_x = std::min(
+      static_cast<int32_t>((device_bounds.left() - anchor_x) * kSubpixelSteps),
+      kSubpixelSteps - 1);
+  key.subpixel_y = std::min(
+      static_cast<int32_t>((device_bounds.top() - anchor_y) * kSubpixelSteps),
+      kSubpixelSteps - 1);
+
+  // Moving the light sideways by d moves the spot shadow by d * z / (h - z),
+  // where h is the height of the light. Pick the step so that the shadows of
+  // lights within the same step are less than half a pixel apart.
+  const SkScalar light_step =
+      std::max(1.0f, std::floor((light_position.fZ - z) / (2 * z)));
+  key.light_x = static_cast<int32_t>(
+      std::lround((light_position.fX - device_bounds.centerX()) / light_step));
+  key.light_y = static_cast<int32_t>(
+      std::lround((light_position.fY - device_bounds.centerY()) / light_step));
+
+  Entry& entry = entries_[key];
+  entry.last_used_frame = frame_;
+  if (!entry.image) {
+    if (++entry.access_count < kAccessThreshold) {
+      return false;
+    }
+
+    // Leave a pixel of margin for the shadows that only match this one up
+    // to the subpixel steps.
+    SkIRect bounds = matrix.mapRect(shadow_bounds)
+                         .makeOffset(-anchor_x, -anchor_y)
+                         .roundOut()
+                         .makeOutset(1, 1);
+    const size_t bytes = bounds.width() * bounds.height() * sizeof(SkPMColor);
+    if (bounds.isEmpty() || bytes > max_bytes_) {
+      return false;
+    }
+    TRACE_EVENT0("flutter", "ShadowCache::Render");
+    auto surface =
+        SkSurface::MakeRasterN32Premul(bounds.width(), bounds.height());
+    if (!surface) {
+      return false;
+    }
+    // Render the shape at the subpixel position of the key, so that the
+    // image is the same for every shadow that matches it.
+    const SkVector offset = SkVector::Make(
+        static_cast<SkScalar>(key.subpixel_x) / kSubpixelSteps -
+            device_bounds.left() - bounds.left(),
+        static_cast<SkScalar>(key.subpixel_y) / kSubpixelSteps -
+            device_bounds.top() - bounds.top());
+    SkCanvas* image_canvas = surface->getCanvas();
+    image_canvas->clear(SK_ColorTRANSPARENT);
+    image_canvas->translate(offset.x(), offset.y());
+    image_canvas->concat(matrix);
+    render(image_canvas,
+           SkPoint3::Make(light_position.fX + offset.x(),
+                          light_position.fY + offset.y(), light_position.fZ));
+    entry.image = surface->makeImageSnapshot();
+    entry.bounds = bounds;
+    cached_bytes_ += bytes;
+  }
+
+  // The image is in device space and aligned to its pixels.
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->resetMatrix();
+  canvas->drawImage(entry.image, anchor_x + entry.bounds.left(),
+                    anchor_y + entry.bounds.top());
+  return true;
+}
+
+void ShadowCache::SweepAfterFrame() {
+  std::vector<std::pair<size_t, Key>> images;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.image) {
+      images.emplace_back(it->second.last_used_frame, it->first);
+      ++it;
+    } else if (it->second.last_used_frame != frame_) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  frame_++;
+
+  if (cached_bytes_ <= max_bytes_) {
+    return;
+  }
+  std::sort(images.begin(), images.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (const auto& image : images) {
+    if (cached_bytes_ <= max_bytes_) {
+      break;
+    }
+    auto it = entries_.find(image.second);
+    const SkIRect& bounds = it->second.bounds;
+    cached_bytes_ -= bounds.width() * bounds.height() * sizeof(SkPMColor);
+    entries_.erase(it);
+  }
+}
+
+void ShadowCache::Clear() {
+  entries_.clear();
+  cached_bytes_ = 0;
+}
+
+size_t ShadowCache::GetCachedImageCount() const {
+  return std::count_if(
+      entries_.begin(), entries_.end(),
+      [](const auto& entry) { return entry.second.image != nullptr; });
+}
+
+}  // namespace flutter
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_SHADOW_CACHE_H_
+#define FLUTTER_FLOW_SHADOW_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPoint3.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps pre-rendered images of the shadows of physical shapes so that
+/// identical shadows are not blurred again on every frame. This matters most
+/// when rendering with the CPU, where every shadow costs a blur.
+///
+/// A shadow is identified by its shape, color, elevation, occlusion, the
+/// device pixel ratio and the scale of the canvas. Rectangles, ovals and
+/// rounded rectangles are identified by their geometry, so that the shadows
+/// of same-shaped widgets such as cards and buttons share an image wherever
+/// they are. Other paths are identified by their generation id.
+///
+/// The light that casts the shadows is in device space, so the shadow of a
+/// shape also depends on where it is drawn. Shadows are matched if the light
+/// is close enough to their shape that the result is off by less than half a
+/// pixel, and if their subpixel position is within a quarter of a pixel.
+///
+/// A shadow is only cached the second time it is drawn. Images are kept
+/// across frames until the cache exceeds its budget, at which point the least
+/// recently used ones are discarded.
+class ShadowCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 8 * 1024 * 1024;
+
+  // The number of times a shadow must be drawn before it is cached.
+  static constexpr int kAccessThreshold = 2;
+
+  // Draws a shadow into the canvas for the given light in device space.
+  using RenderShadow = std::function<void(SkCanvas* canvas,
+                                          const SkPoint3& light_position)>;
+
+  explicit ShadowCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~ShadowCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the shadow of a path from the cache, rendering it into
+  ///             the cache with |render| first if needed.
+  ///
+  /// @param[in]  canvas          The canvas to draw the shadow into.
+  /// @param[in]  path            The path casting the shadow.
+  /// @param[in]  color           The color of the shadow.
+  /// @param[in]  elevation       The elevation of the path, before it is
+  ///                             multiplied by the device pixel ratio.
+  /// @param[in]  transparent_occluder  Whether the path is see-through.
+  /// @param[in]  dpr             The device pixel ratio.
+  /// @param[in]  light_position  The light that casts the shadow, in device
+  ///                             space.
+  /// @param[in]  shadow_bounds   The bounds of the shadow in the coordinates
+  ///                             of the path.
+  /// @param[in]  render          Draws the shadow for a light.
+  ///
+  /// @return     Whether the shadow was drawn. Nothing is drawn if the shadow
+  ///             can't be cached or wasn't drawn often enough yet.
+  ///
+  bool Draw(SkCanvas* canvas,
+            const SkPath& path,
+            SkColor color,
+            float elevation,
+            bool transparent_occluder,
+            float dpr,
+            const SkPoint3& light_position,
+            const SkRect& shadow_bounds,
+            const RenderShadow& render);
+
+  /// Discards the shadows that were only seen once in the last frame and, if
+  /// the cache is over budget, the least recently used images.
+  void SweepAfterFrame();
+
+  void Clear();
+
+  /// The number of cached images.
+  size_t GetCachedImageCount() const;
+
+  /// The memory used by the cached images.
+  size_t GetCachedBytes() const { return cached_bytes_; }
+
+ private:
+  // The number of steps a pixel is divided into to match subpixel positions.
+  static constexpr int32_t kSubpixelSteps = 4;
+
+  struct Key {
+    // The generation id of the path, or 0 if the shape is |rrect|.
+    uint32_t path_id;
+    // The shape moved to the origin.
+    SkRRect rrect;
+    SkColor color;
+    float elevation;
+    float dpr;
+    bool transparent_occluder;
+    float scale_x;
+    float scale_y;
+    // The position of the light relative to the center of the shape in
+    // device space, in multiples of a step that depends on the elevation.
+    int32_t light_x;
+    int32_t light_y;
+    // The fractional part of the top left corner of the shape in device
+    // space, in multiples of 1 / kSubpixelSteps.
+    int32_t subpixel_x;
+    int32_t subpixel_y;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    int access_count = 0;
+    size_t last_used_frame = 0;
+    sk_sp<SkImage> image;
+    // The bounds of the image relative to the pixel that the top left corner
+    // of the shape falls in.
+    SkIRect bounds;
+  };
+
+  const size_t max_bytes_;
+  size_t frame_ = 0;
+  size_t cached_bytes_ = 0;
+  std::unordered_map<Key, Entry, KeyHash> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShadowCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_SHADOW_CACHE_H_
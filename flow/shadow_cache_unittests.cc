@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shadow_cache.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+constexpr float kElevation = 4.0f;
+constexpr float kDpr = 2.0f;
+
+// Draws the shadow of a path with the light above its top edge, as
+// PhysicalShapeLayer does.
+bool DrawShadow(ShadowCache& cache,
+                SkCanvas* canvas,
+                const SkPath& path,
+                int* render_count) {
+  const SkRect& bounds = path.getBounds();
+  const SkPoint3 light =
+      SkPoint3::Make(bounds.centerX(), bounds.top() - 600.0f, kDpr * 600.0f);
+  return cache.Draw(canvas, path, SK_ColorBLACK, kElevation, false, kDpr,
+                    light, bounds.makeOutset(20, 20),
+                    [render_count](SkCanvas* target, const SkPoint3&) {
+                      (*render_count)++;
+                      target->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+                    });
+}
+
+}  // namespace
+
+TEST(ShadowCache, CachesShadowsDrawnTwice) {
+  ShadowCache cache;
+  auto surface = SkSurface::MakeRasterN32Premul(200, 200);
+  const SkPath path = SkPath().addRRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(30, 40, 60, 30), 4, 4));
+
+  int render_count = 0;
+  EXPECT_FALSE(DrawShadow(cache, surface->getCanvas(), path, &render_count));
+  EXPECT_EQ(render_count, 0);
+  cache.SweepAfterFrame();
+
+  EXPECT_TRUE(DrawShadow(cache, surface->getCanvas(), path, &render_count));
+  EXPECT_TRUE(DrawShadow(cache, surface->getCanvas(), path, &render_count));
+  EXPECT_EQ(render_count, 1);
+  EXPECT_EQ(cache.GetCachedImageCount(), 1u);
+  EXPECT_GT(cache.GetCachedBytes(), 0u);
+}
+
+TEST(ShadowCache, SharesImagesBetweenSameShapedRRects) {
+  ShadowCache cache;
+  auto surface = SkSurface::MakeRasterN32Premul(200, 200);
+  const SkPath path1 = SkPath().addRRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(30, 40, 60, 30), 4, 4));
+  const SkPath path2 = SkPath().addRRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(100, 120, 60, 30), 4, 4));
+  const SkPath path3 = SkPath().addRRect(
+      SkRRect::MakeRectXY(SkRect::MakeXYWH(100, 120, 60, 31), 4, 4));
+
+  int render_count = 0;
+  DrawShadow(cache, surface->getCanvas(), path1, &render_count);
+  EXPECT_TRUE(DrawShadow(cache, surface->getCanvas(), path2, &render_count));
+  EXPECT_EQ(render_count, 1);
+
+  EXPECT_FALSE(DrawShadow(cache, surface->getCanvas(), path3, &render_count));
+  EXPECT_EQ(render_count, 1);
+}
+
+TEST(ShadowCache, DoesNotCacheRotatedShadows) {
+  ShadowCache cache;
+  auto surface = SkSurface::MakeRasterN32Premul(200, 200);
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(30, 40, 60, 30));
+  surface->getCanvas()->rotate(30);
+
+  int render_count = 0;
+  for (int i = 0; i < ShadowCache::kAccessThreshold + 1; i++) {
+    EXPECT_FALSE(DrawShadow(cache, surface->getCanvas(), path, &render_count));
+  }
+  EXPECT_EQ(render_count, 0);
+  EXPECT_EQ(cache.GetCachedImageCount(), 0u);
+}
+
+TEST(ShadowCache, EvictsLeastRecentlyUsedImagesOverBudget) {
+  auto surface = SkSurface::MakeRasterN32Premul(200, 200);
+  const SkPath path1 = SkPath().addRect(SkRect::MakeXYWH(30, 40, 60, 30));
+  const SkPath path2 = SkPath().addRect(SkRect::MakeXYWH(30, 40, 60, 31));
+
+  // Measure a single image to size the budget.
+  size_t image_bytes;
+  {
+    ShadowCache cache;
+    int render_count = 0;
+    DrawShadow(cache, surface->getCanvas(), path1, &render_count);
+    DrawShadow(cache, surface->getCanvas(), path1, &render_count);
+    image_bytes = cache.GetCachedBytes();
+  }
+
+  ShadowCache cache(image_bytes * 3 / 2);
+  int render_count = 0;
+  DrawShadow(cache, surface->getCanvas(), path1, &render_count);
+  DrawShadow(cache, surface->getCanvas(), path1, &render_count);
+  cache.SweepAfterFrame();
+  DrawShadow(cache, surface->getCanvas(), path2, &render_count);
+  DrawShadow(cache, surface->getCanvas(), path2, &render_count);
+  EXPECT_EQ(cache.GetCachedImageCount(), 2u);
+  cache.SweepAfterFrame();
+
+  EXPECT_EQ(cache.GetCachedImageCount(), 1u);
+  EXPECT_LE(cache.GetCachedBytes(), image_bytes * 3 / 2);
+  // The most recently used image is kept.
+  EXPECT_TRUE(DrawShadow(cache, surface->getCanvas(), path2, &render_count));
+  EXPECT_EQ(render_count, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
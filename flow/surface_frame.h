@@ -6,6 +6,8 @@
 #define FLUTTER_FLOW_SURFACE_FRAME_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/fml/macros.h"
@@ -42,10 +44,26 @@ class SurfaceFrame {
 
   bool supports_readback() { return supports_readback_; }
 
+  // Whether the surface still holds the previously presented frame, in which
+  // case only the parts of this frame that changed need to be repainted.
+  bool supports_partial_repaint() const { return supports_partial_repaint_; }
+
+  void set_supports_partial_repaint(bool supports_partial_repaint) {
+    supports_partial_repaint_ = supports_partial_repaint;
+  }
+
+  // The non-overlapping rects of the frame that changed since the previously
+  // presented frame, if known. Otherwise the whole frame changed.
+  const std::optional<std::vector<SkIRect>>& damage() const { return damage_; }
+
+  void set_damage(std::vector<SkIRect> damage) { damage_ = std::move(damage); }
+
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
   bool supports_readback_;
+  bool supports_partial_repaint_ = false;
+  std::optional<std::vector<SkIRect>> damage_;
   SubmitCallback submit_callback_;
   std::unique_ptr<GLContextResult> context_result_;
 
@@ -41,7 +41,7 @@ class ConcurrentMessageLoop
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
+  std::queue<fml::UniqueClosure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
@@ -50,7 +50,7 @@ class ConcurrentMessageLoop
 
   void WorkerMain();
 
-  void PostTask(const fml::closure& task);
+  void PostTask(fml::UniqueClosure task);
 
   bool HasThreadTasksLocked() const;
 
@@ -65,7 +65,7 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::UniqueClosure task) override;
 
  private:
   friend ConcurrentMessageLoop;
@@ -6,25 +6,36 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+#include <functional>
+
+#include "flutter/fml/logging.h"
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::UniqueClosure task,
                          fml::TimePoint target_time,
                          fml::TaskSourceGrade task_source_grade)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
       task_source_grade_(task_source_grade) {}
 
 DelayedTask::~DelayedTask() = default;
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) = default;
 
-const fml::closure& DelayedTask::GetTask() const {
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) = default;
+
+const fml::UniqueClosure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::UniqueClosure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
@@ -40,4 +51,31 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+DelayedTaskQueue::DelayedTaskQueue() = default;
+
+DelayedTaskQueue::DelayedTaskQueue(DelayedTaskQueue&& other) = default;
+
+DelayedTaskQueue& DelayedTaskQueue::operator=(DelayedTaskQueue&& other) =
+    default;
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+const DelayedTask& DelayedTaskQueue::top() const {
+  FML_DCHECK(!heap_.empty());
+  return heap_.front();
+}
+
+void DelayedTaskQueue::push(DelayedTask task) {
+  heap_.push_back(std::move(task));
+  std::push_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+}
+
+DelayedTask DelayedTaskQueue::pop() {
+  FML_DCHECK(!heap_.empty());
+  std::pop_heap(heap_.begin(), heap_.end(), std::greater<DelayedTask>());
+  DelayedTask task = std::move(heap_.back());
+  heap_.pop_back();
+  return task;
+}
+
 }  // namespace fml
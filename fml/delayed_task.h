@@ -5,26 +5,32 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
-#include <queue>
+#include <vector>
 
-#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::UniqueClosure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::UniqueClosure& GetTask() const;
+
+  /// Moves the task out, leaving this one empty.
+  fml::UniqueClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
@@ -34,14 +40,41 @@ class DelayedTask {
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::UniqueClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTask);
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A heap of delayed tasks, with the one to run first at the top. Unlike a
+/// std::priority_queue, it lets the top task be moved out as it is popped.
+class DelayedTaskQueue {
+ public:
+  DelayedTaskQueue();
+
+  DelayedTaskQueue(DelayedTaskQueue&& other);
+
+  DelayedTaskQueue& operator=(DelayedTaskQueue&& other);
+
+  ~DelayedTaskQueue();
+
+  bool empty() const { return heap_.empty(); }
+
+  size_t size() const { return heap_.size(); }
+
+  const DelayedTask& top() const;
+
+  void push(DelayedTask task);
+
+  /// Removes the top task and returns it.
+  DelayedTask pop();
+
+ private:
+  std::vector<DelayedTask> heap_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTaskQueue);
+};
 
 }  // namespace fml
 
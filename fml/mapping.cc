@@ -9,8 +9,18 @@
 
 namespace fml {
 
+// Mapping
+
+bool Mapping::IsFileBacked() const {
+  return false;
+}
+
 // FileMapping
 
+bool FileMapping::IsFileBacked() const {
+  return true;
+}
+
 uint8_t* FileMapping::GetMutableMapping() {
   return mutable_mapping_;
 }
@@ -84,8 +94,12 @@ const uint8_t* DataMapping::GetMapping() const {
 // NonOwnedMapping
 NonOwnedMapping::NonOwnedMapping(const uint8_t* data,
                                  size_t size,
-                                 const ReleaseProc& release_proc)
-    : data_(data), size_(size), release_proc_(release_proc) {}
+                                 const ReleaseProc& release_proc,
+                                 bool is_file_backed)
+    : data_(data),
+      size_(size),
+      release_proc_(release_proc),
+      is_file_backed_(is_file_backed) {}
 
 NonOwnedMapping::~NonOwnedMapping() {
   if (release_proc_) {
@@ -101,6 +115,10 @@ const uint8_t* NonOwnedMapping::GetMapping() const {
   return data_;
 }
 
+bool NonOwnedMapping::IsFileBacked() const {
+  return is_file_backed_;
+}
+
 // MallocMapping
 MallocMapping::MallocMapping() : data_(nullptr), size_(0) {}
 
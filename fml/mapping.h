@@ -28,6 +28,11 @@ class Mapping {
 
   virtual const uint8_t* GetMapping() const = 0;
 
+  /// Whether the bytes are mapped from a file rather than allocated on the
+  /// heap, so releasing them on another thread than the one that created the
+  /// mapping does not grow the native heap.
+  virtual bool IsFileBacked() const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -65,6 +70,9 @@ class FileMapping final : public Mapping {
   // |Mapping|
   const uint8_t* GetMapping() const override;
 
+  // |Mapping|
+  bool IsFileBacked() const override;
+
   uint8_t* GetMutableMapping();
 
   bool IsValid() const;
@@ -105,9 +113,12 @@ class DataMapping final : public Mapping {
 class NonOwnedMapping final : public Mapping {
  public:
   using ReleaseProc = std::function<void(const uint8_t* data, size_t size)>;
+  // `is_file_backed` is whether `data` points into a file mapping that
+  // outlives this mapping.
   NonOwnedMapping(const uint8_t* data,
                   size_t size,
-                  const ReleaseProc& release_proc = nullptr);
+                  const ReleaseProc& release_proc = nullptr,
+                  bool is_file_backed = false);
 
   ~NonOwnedMapping() override;
 
@@ -117,10 +128,14 @@ class NonOwnedMapping final : public Mapping {
   // |Mapping|
   const uint8_t* GetMapping() const override;
 
+  // |Mapping|
+  bool IsFileBacked() const override;
+
  private:
   const uint8_t* const data_;
   const size_t size_;
   const ReleaseProc release_proc_;
+  const bool is_file_backed_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(NonOwnedMapping);
 };
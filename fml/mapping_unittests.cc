@@ -3,10 +3,28 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
 
+TEST(Mapping, IsFileBacked) {
+  ScopedTemporaryDirectory dir;
+  ASSERT_TRUE(WriteAtomically(dir.fd(), "file", DataMapping("contents")));
+  auto file_mapping = FileMapping::CreateReadOnly(dir.fd(), "file");
+  ASSERT_TRUE(file_mapping);
+  ASSERT_TRUE(file_mapping->IsFileBacked());
+
+  ASSERT_FALSE(DataMapping("contents").IsFileBacked());
+  ASSERT_FALSE(MallocMapping::Copy("contents", 8).IsFileBacked());
+  ASSERT_FALSE(NonOwnedMapping(file_mapping->GetMapping(),
+                               file_mapping->GetSize())
+                   .IsFileBacked());
+  ASSERT_TRUE(NonOwnedMapping(file_mapping->GetMapping(),
+                              file_mapping->GetSize(), nullptr, true)
+                  .IsFileBacked());
+}
+
 TEST(MallocMapping, EmptyContructor) {
   MallocMapping mapping;
   ASSERT_EQ(nullptr, mapping.GetMapping());
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop_task_queues.h"
 
+#include <climits>
 #include <iostream>
 #include <memory>
 
@@ -101,14 +102,14 @@ TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
 
 void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
-    const fml::closure& task,
+    fml::UniqueClosure task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
   std::lock_guard guard(queue_mutex_);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
   queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+      {order, std::move(task), target_time, task_source_grade});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
@@ -125,8 +126,9 @@ bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
   return HasPendingTasksUnlocked(queue_id);
 }
 
-fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
-                                                     fml::TimePoint from_time) {
+fml::UniqueClosure MessageLoopTaskQueues::GetNextTaskToRun(
+    TaskQueueId queue_id,
+    fml::TimePoint from_time) {
   std::lock_guard guard(queue_mutex_);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
@@ -142,13 +144,20 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
+  // The top task is only valid until it is popped.
+  const auto task_source_grade = top.task.GetTaskSourceGrade();
+  fml::UniqueClosure invocation = queue_entries_.at(top.task_queue_id)
+                                      ->task_source->PopTask(task_source_grade)
+                                      .TakeTask();
   {
     std::scoped_lock creation(creation_mutex_);
-    const auto task_source_grade = top.task.GetTaskSourceGrade();
-    tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+    // Reuses the holder of the thread rather than allocating one per task.
+    TaskSourceGradeHolder* holder = tls_task_source_grade.get();
+    if (holder) {
+      holder->task_source_grade = task_source_grade;
+    } else {
+      tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+    }
   }
   return invocation;
 }
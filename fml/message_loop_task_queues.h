@@ -6,6 +6,7 @@
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "flutter/fml/synchronization/shared_mutex.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/unique_closure.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
@@ -76,14 +78,15 @@ class MessageLoopTaskQueues
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::UniqueClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
@@ -4,14 +4,37 @@
 
 #include "flutter/fml/message_loop_task_queues.h"
 
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <new>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 
+// Counts the heap allocations of the benchmarks, which are the main cost of
+// posting a task besides taking the lock.
+static std::atomic<size_t> gAllocationCount = 0;
+
+void* operator new(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  FML_CHECK(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+  std::free(ptr);
+}
+
 namespace fml {
 namespace benchmarking {
 
@@ -44,7 +67,7 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
+          fml::UniqueClosure invocation =
               task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
           if (!invocation) {
             break;
@@ -66,5 +89,45 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Posts tasks that capture a few pointers, as most tasks do. These don't fit
+// in the small buffer of a std::function, but are stored inline in a
+// UniqueClosure.
+static void BM_RunCapturingTasks(benchmark::State& state) {  // NOLINT
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const TaskQueueId queue_id = task_queue->CreateTaskQueue();
+  const int num_tasks = state.range(0);
+  const fml::TimePoint past = fml::TimePoint::Now();
+  int a = 0, b = 0, c = 0;
+
+  const size_t allocations_before =
+      gAllocationCount.load(std::memory_order_relaxed);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < num_tasks; i++) {
+      task_queue->RegisterTask(
+          queue_id, [&a, &b, &c, i] { a += b + c + i; }, past);
+    }
+    const auto now = fml::TimePoint::Now();
+    for (;;) {
+      fml::UniqueClosure invocation =
+          task_queue->GetNextTaskToRun(queue_id, now);
+      if (!invocation) {
+        break;
+      }
+      invocation();
+    }
+  }
+
+  const size_t allocations =
+      gAllocationCount.load(std::memory_order_relaxed) - allocations_before;
+
+  benchmark::DoNotOptimize(a);
+  task_queue->Dispose(queue_id);
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+  state.counters["AllocationsPerTask"] = benchmark::Counter(
+      static_cast<double>(allocations) / (state.iterations() * num_tasks));
+}
+
+BENCHMARK(BM_RunCapturingTasks)->Arg(1)->Arg(100);
+
 }  // namespace benchmarking
 }  // namespace fml
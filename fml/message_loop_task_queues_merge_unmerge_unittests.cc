@@ -31,7 +31,7 @@ static int CountRemainingTasks(fml::RefPtr<MessageLoopTaskQueues> task_queue,
                                bool run_invocation = false) {
   const auto now = fml::TimePoint::Now();
   int count = 0;
-  fml::closure invocation;
+  fml::UniqueClosure invocation;
   do {
     invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
@@ -78,7 +78,7 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = fml::TimePoint::Now();
   int expected_value = 1;
   for (;;) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -12,6 +12,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_recorder.h"
 
 #if defined(OS_WIN)
 #include <windows.h>
@@ -71,6 +72,7 @@ void Thread::SetCurrentThreadName(const std::string& name) {
   if (name == "") {
     return;
   }
+  tracing::TraceRecorder::SetCurrentThreadName(name);
 #if defined(OS_MACOSX)
   pthread_setname_np(name.c_str());
 #elif defined(OS_LINUX) || defined(OS_ANDROID)
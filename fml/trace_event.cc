@@ -11,10 +11,16 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
 
+size_t TraceNonce() {
+  static std::atomic_size_t gLastItem;
+  return ++gLastItem;
+}
+
 #if FLUTTER_TIMELINE_ENABLED
 
 namespace {
@@ -28,6 +34,18 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  if (TraceRecorder::IsEnabled()) {
+    // The recorder keeps time on the fml::TimePoint clock, so timestamps of
+    // the Dart timeline are moved over by the current offset between the two.
+    const int64_t offset = TimePoint::Now().ToEpochDelta().ToMicroseconds() -
+                           Dart_TimelineGetMicros();
+    TraceRecorder::Record(label, type,
+                          type == Dart_Timeline_Event_Duration
+                              ? timestamp1_or_async_id + offset
+                              : timestamp1_or_async_id,
+                          timestamp0 + offset, argument_count, argument_names,
+                          argument_values);
+  }
   if (gTimelineEventHandler && gAllowlist.Query(label)) {
     gTimelineEventHandler(label, timestamp0, timestamp1_or_async_id, type,
                           argument_count, argument_names, argument_values);
@@ -43,11 +61,6 @@ void TraceSetTimelineEventHandler(TimelineEventHandler handler) {
   gTimelineEventHandler = handler;
 }
 
-size_t TraceNonce() {
-  static std::atomic_size_t gLastItem;
-  return ++gLastItem;
-}
-
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
@@ -291,44 +304,110 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
 
 #else  // FLUTTER_TIMELINE_ENABLED
 
+// The Dart timeline is compiled out of these builds but the trace recorder can
+// still be enabled as a flight recorder.
+namespace {
+inline void FlutterTimelineEvent(const char* label,
+                                 Dart_Timeline_Event_Type type,
+                                 int64_t id,
+                                 intptr_t argument_count = 0,
+                                 const char** argument_names = nullptr,
+                                 const char** argument_values = nullptr) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::Record(label, type, id,
+                          TimePoint::Now().ToEpochDelta().ToMicroseconds(),
+                          argument_count, argument_names, argument_values);
+  }
+}
+}  // namespace
+
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
 
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
 
-size_t TraceNonce() {
-  return 0;
-}
-
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         int64_t timestamp_micros,
                         TraceIDArg identifier,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
+                        const std::vector<std::string>& values) {
+  if (!TraceRecorder::IsEnabled()) {
+    return;
+  }
+
+  const auto argument_count = std::min(c_names.size(), values.size());
+
+  std::vector<const char*> c_values;
+  c_values.resize(argument_count, nullptr);
+
+  for (size_t i = 0; i < argument_count; i++) {
+    c_values[i] = values[i].c_str();
+  }
+
+  // Callers pass timestamps of the Dart timeline, like in other builds.
+  const int64_t offset = TimePoint::Now().ToEpochDelta().ToMicroseconds() -
+                         Dart_TimelineGetMicros();
+  TraceRecorder::Record(
+      name, type,
+      type == Dart_Timeline_Event_Duration ? identifier + offset : identifier,
+      timestamp_micros + offset, argument_count,
+      const_cast<const char**>(c_names.data()), c_values.data());
+}
 
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         TraceIDArg identifier,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
+                        const std::vector<std::string>& values) {
+  if (!TraceRecorder::IsEnabled()) {
+    return;
+  }
+
+  const auto argument_count = std::min(c_names.size(), values.size());
+
+  std::vector<const char*> c_values;
+  c_values.resize(argument_count, nullptr);
+
+  for (size_t i = 0; i < argument_count; i++) {
+    c_values[i] = values[i].c_str();
+  }
 
-void TraceEvent0(TraceArg category_group, TraceArg name) {}
+  FlutterTimelineEvent(name, type, identifier, argument_count,
+                       const_cast<const char**>(c_names.data()),
+                       c_values.data());
+}
+
+void TraceEvent0(TraceArg category_group, TraceArg name) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Begin, 0);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {arg1_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Begin, 0, 1, arg_names,
+                       arg_values);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  const char* arg_names[] = {arg1_name, arg2_name};
+  const char* arg_values[] = {arg1_val, arg2_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Begin, 0, 2, arg_names,
+                       arg_values);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_End, 0);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
@@ -337,47 +416,78 @@ void TraceEventAsyncComplete(TraceArg category_group,
 
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
-                           TraceIDArg id) {}
+                           TraceIDArg id) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Async_Begin, id);
+}
 
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Async_End, id);
+}
 
 void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id,
                            TraceArg arg1_name,
-                           TraceArg arg1_val) {}
+                           TraceArg arg1_val) {
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {arg1_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Async_Begin, id, 1, arg_names,
+                       arg_values);
+}
 
 void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id,
                          TraceArg arg1_name,
-                         TraceArg arg1_val) {}
+                         TraceArg arg1_val) {
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {arg1_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Async_End, id, 1, arg_names,
+                       arg_values);
+}
 
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
+void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Instant, 0);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {arg1_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Instant, 0, 1, arg_names,
+                       arg_values);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  const char* arg_names[] = {arg1_name, arg2_name};
+  const char* arg_values[] = {arg1_val, arg2_val};
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Instant, 0, 2, arg_names,
+                       arg_values);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
-                          TraceIDArg id) {}
+                          TraceIDArg id) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Flow_Begin, id);
+}
 
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Flow_Step, id);
+}
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  FlutterTimelineEvent(name, Dart_Timeline_Event_Flow_End, id);
 }
 
 #endif  // FLUTTER_TIMELINE_ENABLED
@@ -45,6 +45,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA))
@@ -224,11 +225,15 @@ void TraceCounter(TraceArg category,
                   TraceArg name,
                   TraceIDArg identifier,
                   Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
+#if !FLUTTER_TIMELINE_ENABLED
+  // Only the trace recorder takes events when the timeline is compiled out.
+  if (!TraceRecorder::IsEnabled()) {
+    return;
+  }
+#endif  // !FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, identifier, Dart_Timeline_Event_Counter,
                      split.first, split.second);
-#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 // HACK: Used to NOP FML_TRACE_COUNTER macro without triggering unused var
@@ -239,17 +244,19 @@ void TraceCounterNopHACK(TraceArg category,
                          TraceIDArg identifier,
                          Args... args) {}
 
+void TraceEvent0(TraceArg category_group, TraceArg name);
+
 template <typename... Args>
 void TraceEvent(TraceArg category, TraceArg name, Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
                      split.second);
+#else   // FLUTTER_TIMELINE_ENABLED
+  TraceEvent0(category, name);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
-void TraceEvent0(TraceArg category_group, TraceArg name);
-
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
@@ -270,7 +277,11 @@ void TraceEventAsyncComplete(TraceArg category_group,
                              TimePoint begin,
                              TimePoint end,
                              Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
+#if !FLUTTER_TIMELINE_ENABLED
+  if (!TraceRecorder::IsEnabled()) {
+    return;
+  }
+#endif  // !FLUTTER_TIMELINE_ENABLED
   auto identifier = TraceNonce();
   const auto split = SplitArguments(args...);
 
@@ -278,8 +289,11 @@ void TraceEventAsyncComplete(TraceArg category_group,
     std::swap(begin, end);
   }
 
-  const int64_t begin_micros = begin.ToEpochDelta().ToMicroseconds();
-  const int64_t end_micros = end.ToEpochDelta().ToMicroseconds();
+  // The Dart timeline keeps time on a clock of its own.
+  const int64_t offset = Dart_TimelineGetMicros() -
+                         TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  const int64_t begin_micros = begin.ToEpochDelta().ToMicroseconds() + offset;
+  const int64_t end_micros = end.ToEpochDelta().ToMicroseconds() + offset;
 
   TraceTimelineEvent(category_group,                   // group
                      name,                             // name
@@ -298,7 +312,6 @@ void TraceEventAsyncComplete(TraceArg category_group,
                      split.first,                    // names
                      split.second                    // values
   );
-#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 void TraceEventAsyncBegin0(TraceArg category_group,
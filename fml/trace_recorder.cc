@@ -0,0 +1,439 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+std::atomic_bool TraceRecorder::enabled_{false};
+
+namespace {
+
+// Records are fixed-size and self-contained so that writing one is a plain
+// copy into the ring buffer.
+struct TraceRecord {
+  int64_t timestamp_micros;
+  int64_t id;
+  int32_t type;
+  char name[TraceRecorder::kMaxNameLength + 1];
+};
+
+static_assert(sizeof(TraceRecord) == 64, "Trace records must stay compact.");
+
+// The type of the records that follow a counter record, one for each of its
+// values. They hold the name of the value and its bits in place of the id.
+constexpr int32_t kCounterValueType = -1;
+
+int64_t CounterValueToId(double value) {
+  int64_t id;
+  static_assert(sizeof(id) == sizeof(value));
+  std::memcpy(&id, &value, sizeof(id));
+  return id;
+}
+
+double CounterValueFromId(int64_t id) {
+  double value;
+  std::memcpy(&value, &id, sizeof(value));
+  return value;
+}
+
+// A ring buffer with a single writer, the thread that owns it, and any number
+// of readers taking snapshots. The writer claims a slot by bumping |claimed_|
+// before overwriting it and publishes the record by bumping |written_| after.
+// Readers copy the published records out and then discard the ones in slots
+// that were claimed again in the meantime.
+class ThreadBuffer {
+ public:
+  ThreadBuffer(size_t index, size_t capacity)
+      : index_(index), records_(std::max<size_t>(capacity, 1)) {}
+
+  size_t index() const { return index_; }
+
+  void Add(const char* name,
+           int32_t type,
+           int64_t id,
+           int64_t timestamp_micros) {
+    const uint64_t position = written_.load(std::memory_order_relaxed);
+    claimed_.store(position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    TraceRecord& record = records_[position % records_.size()];
+    record.timestamp_micros = timestamp_micros;
+    record.id = id;
+    record.type = type;
+    if (name != nullptr) {
+      ::strncpy(record.name, name, TraceRecorder::kMaxNameLength);
+      record.name[TraceRecorder::kMaxNameLength] = '\0';
+    } else {
+      record.name[0] = '\0';
+    }
+    written_.store(position + 1, std::memory_order_release);
+  }
+
+  void Collect(int64_t since_micros,
+               std::vector<TraceRecorder::Event>& events) const {
+    const uint64_t capacity = records_.size();
+    const uint64_t end = written_.load(std::memory_order_acquire);
+    const uint64_t begin = end > capacity ? end - capacity : 0;
+
+    std::vector<TraceRecord> copy;
+    copy.reserve(end - begin);
+    for (uint64_t position = begin; position < end; position++) {
+      copy.push_back(records_[position % capacity]);
+    }
+
+    // The writer may have started overwriting the oldest records while they
+    // were being copied. Only keep the ones whose slots weren't claimed since.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+    const uint64_t intact = claimed > capacity ? claimed - capacity : 0;
+
+    // Counter values are dropped along with their counter record.
+    bool collecting_counter = false;
+    for (uint64_t position = std::max(begin, intact); position < end;
+         position++) {
+      const TraceRecord& record = copy[position - begin];
+      if (record.type == kCounterValueType) {
+        if (collecting_counter) {
+          events.back().counter_values.emplace_back(
+              record.name, CounterValueFromId(record.id));
+        }
+        continue;
+      }
+      collecting_counter = false;
+      if (record.timestamp_micros < since_micros) {
+        continue;
+      }
+      const auto type = static_cast<Dart_Timeline_Event_Type>(record.type);
+      const bool is_duration = type == Dart_Timeline_Event_Duration;
+      events.push_back({
+          record.name,                  // name
+          type,                         // type
+          is_duration ? 0 : record.id,  // id
+          record.timestamp_micros,      // timestamp
+          is_duration ? record.id : 0,  // end timestamp
+          index_,                       // thread
+          {},                           // counter values
+      });
+      collecting_counter = type == Dart_Timeline_Event_Counter;
+    }
+  }
+
+ private:
+  const size_t index_;
+  std::vector<TraceRecord> records_;
+  std::atomic<uint64_t> claimed_{0};
+  std::atomic<uint64_t> written_{0};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+struct ThreadState {
+  std::string name;
+  std::shared_ptr<ThreadBuffer> buffer;
+  size_t generation = 0;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::atomic<size_t> generation{0};
+  size_t records_per_thread = 0;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::vector<std::string> thread_names;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadState> tThreadState;
+
+ThreadState& GetThreadState() {
+  if (!tThreadState.get()) {
+    tThreadState.reset(new ThreadState());
+  }
+  return *tThreadState.get();
+}
+
+// Returns the buffer of the calling thread for the current recording session,
+// registering a new one on first use.
+ThreadBuffer* GetThreadBuffer() {
+  auto& registry = GetRegistry();
+  auto& state = GetThreadState();
+  if (state.generation == registry.generation.load(std::memory_order_acquire)) {
+    return state.buffer.get();
+  }
+
+  std::scoped_lock lock(registry.mutex);
+  state.generation = registry.generation.load(std::memory_order_relaxed);
+  if (registry.records_per_thread == 0) {
+    state.buffer = nullptr;
+    return nullptr;
+  }
+  state.buffer = std::make_shared<ThreadBuffer>(registry.buffers.size(),
+                                                registry.records_per_thread);
+  registry.buffers.push_back(state.buffer);
+  registry.thread_names.push_back(state.name);
+  return state.buffer.get();
+}
+
+void ResetRegistry(size_t records_per_thread) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  registry.records_per_thread = records_per_thread;
+  registry.buffers.clear();
+  registry.thread_names.clear();
+  registry.generation.fetch_add(1, std::memory_order_release);
+}
+
+const char* ChromeTracePhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+  }
+  return "i";
+}
+
+bool HasChromeTraceId(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Integral values, like most counters, are written without an exponent.
+void WriteJSONNumber(std::ostream& stream, double value) {
+  if (std::trunc(value) == value && std::abs(value) < 1e15) {
+    stream << static_cast<int64_t>(value);
+  } else {
+    stream << value;
+  }
+}
+
+void WriteJSONString(std::ostream& stream, const std::string& string) {
+  static const char kHex[] = "0123456789abcdef";
+  stream << '"';
+  for (const char c : string) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          stream << "\\u00" << kHex[(c >> 4) & 0xF] << kHex[c & 0xF];
+        } else {
+          stream << c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+void TraceRecorder::Enable(size_t records_per_thread) {
+  ResetRegistry(records_per_thread);
+  enabled_.store(records_per_thread > 0, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+  ResetRegistry(0);
+}
+
+void TraceRecorder::Record(const char* name,
+                           Dart_Timeline_Event_Type type,
+                           int64_t id,
+                           int64_t timestamp_micros,
+                           intptr_t argument_count,
+                           const char** argument_names,
+                           const char** argument_values) {
+  if (!IsEnabled()) {
+    return;
+  }
+  auto buffer = GetThreadBuffer();
+  if (!buffer) {
+    return;
+  }
+  buffer->Add(name, type, id, timestamp_micros);
+  if (type != Dart_Timeline_Event_Counter) {
+    return;
+  }
+  for (intptr_t i = 0; i < argument_count; i++) {
+    if (argument_values[i] == nullptr) {
+      continue;
+    }
+    char* end = nullptr;
+    const double value = std::strtod(argument_values[i], &end);
+    if (end == argument_values[i] || *end != '\0' || !std::isfinite(value)) {
+      continue;
+    }
+    buffer->Add(argument_names[i], kCounterValueType, CounterValueToId(value),
+                timestamp_micros);
+  }
+}
+
+void TraceRecorder::Record(const char* name,
+                           Dart_Timeline_Event_Type type,
+                           int64_t id) {
+  if (!IsEnabled()) {
+    return;
+  }
+  Record(name, type, id,
+         fml::TimePoint::Now().ToEpochDelta().ToMicroseconds());
+}
+
+void TraceRecorder::SetCurrentThreadName(const std::string& name) {
+  auto& state = GetThreadState();
+  state.name = name;
+  if (!state.buffer) {
+    return;
+  }
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  const auto index = state.buffer->index();
+  if (index < registry.buffers.size() &&
+      registry.buffers[index] == state.buffer) {
+    registry.thread_names[index] = name;
+  }
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::Snapshot(
+    fml::TimeDelta window) {
+  const int64_t since_micros =
+      (fml::TimePoint::Now() - window).ToEpochDelta().ToMicroseconds();
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    buffers = registry.buffers;
+  }
+
+  std::vector<Event> events;
+  for (const auto& buffer : buffers) {
+    buffer->Collect(since_micros, events);
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event& a, const Event& b) {
+                     return a.timestamp_micros < b.timestamp_micros;
+                   });
+  return events;
+}
+
+std::string TraceRecorder::SnapshotToChromeTrace(fml::TimeDelta window) {
+  const auto events = Snapshot(window);
+
+  std::vector<std::string> thread_names;
+  {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    thread_names = registry.thread_names;
+  }
+
+  std::stringstream stream;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (size_t i = 0; i < thread_names.size(); i++) {
+    if (thread_names[i].empty()) {
+      continue;
+    }
+    stream << (first ? "" : ",")
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+           << ",\"args\":{\"name\":";
+    WriteJSONString(stream, thread_names[i]);
+    stream << "}}";
+    first = false;
+  }
+  for (const auto& event : events) {
+    stream << (first ? "" : ",") << "{\"name\":";
+    WriteJSONString(stream, event.name);
+    stream << ",\"cat\":\"flutter\",\"ph\":\"" << ChromeTracePhase(event.type)
+           << "\",\"ts\":" << event.timestamp_micros
+           << ",\"pid\":0,\"tid\":" << event.thread_index;
+    if (HasChromeTraceId(event.type)) {
+      stream << ",\"id\":" << event.id;
+    }
+    if (event.type == Dart_Timeline_Event_Duration) {
+      stream << ",\"dur\":"
+             << std::max<int64_t>(
+                    event.end_timestamp_micros - event.timestamp_micros, 0);
+    }
+    if (event.type == Dart_Timeline_Event_Counter) {
+      stream << ",\"args\":{";
+      for (size_t i = 0; i < event.counter_values.size(); i++) {
+        stream << (i == 0 ? "" : ",");
+        WriteJSONString(stream, event.counter_values[i].first);
+        stream << ":";
+        WriteJSONNumber(stream, event.counter_values[i].second);
+      }
+      stream << "}";
+    }
+    if (event.type == Dart_Timeline_Event_Instant) {
+      stream << ",\"s\":\"t\"";
+    }
+    if (event.type == Dart_Timeline_Event_Flow_End) {
+      stream << ",\"bp\":\"e\"";
+    }
+    stream << "}";
+    first = false;
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+bool TraceRecorder::WriteSnapshot(const fml::UniqueFD& directory,
+                                  const char* file_name,
+                                  fml::TimeDelta window) {
+  DataMapping mapping(SnapshotToChromeTrace(window));
+  return fml::WriteAtomically(directory, file_name, mapping);
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      An in-memory flight recorder for trace events.
+///
+///             When enabled, every trace event emitted through the macros in
+///             `trace_event.h` is also appended to a fixed-size ring buffer
+///             owned by the emitting thread. Writers never take a lock or
+///             allocate once their buffer exists, and the recorder is
+///             available in release builds where the Dart timeline is
+///             compiled out. The most recent events of all threads can be
+///             collected on demand, for instance when jank is detected, and
+///             written out in the Chrome trace event format, which is also
+///             understood by Perfetto.
+///
+///             Only the event name (truncated to `kMaxNameLength`), type,
+///             identifier and timestamps are recorded. Event arguments are
+///             not, except for the values of counter events, which take a
+///             record each.
+///
+///             All timestamps are in microseconds on the `fml::TimePoint`
+///             clock. Events traced with timestamps of the Dart timeline are
+///             converted to it before they are recorded.
+///
+///             When disabled, recording a trace event costs a single relaxed
+///             atomic load.
+///
+class TraceRecorder {
+ public:
+  static constexpr size_t kDefaultRecordsPerThread = 4096;
+
+  static constexpr size_t kMaxNameLength = 43;
+
+  struct Event {
+    std::string name;
+    Dart_Timeline_Event_Type type;
+    int64_t id;
+    int64_t timestamp_micros;
+    // The end of duration events, zero for other events.
+    int64_t end_timestamp_micros;
+    size_t thread_index;
+    // The values of counter events, in the order they were traced.
+    std::vector<std::pair<std::string, double>> counter_values;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts recording trace events. Any previously recorded events
+  ///             are discarded.
+  ///
+  /// @param[in]  records_per_thread  The number of most recent events kept
+  ///                                 for each thread.
+  ///
+  static void Enable(size_t records_per_thread = kDefaultRecordsPerThread);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording trace events and discards the recorded ones.
+  ///
+  static void Disable();
+
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an event on the ring buffer of the calling thread.
+  ///             Does nothing if the recorder is disabled.
+  ///
+  /// @param[in]  id                The identifier of the event. Like on the
+  ///                               Dart timeline, this is the end timestamp
+  ///                               for duration events.
+  /// @param[in]  argument_count    The number of arguments. Arguments are
+  ///                               only recorded for counter events, whose
+  ///                               argument values are numbers.
+  ///
+  static void Record(const char* name,
+                     Dart_Timeline_Event_Type type,
+                     int64_t id,
+                     int64_t timestamp_micros,
+                     intptr_t argument_count = 0,
+                     const char** argument_names = nullptr,
+                     const char** argument_values = nullptr);
+
+  static void Record(const char* name,
+                     Dart_Timeline_Event_Type type,
+                     int64_t id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Associates a name with the calling thread in snapshots.
+  ///
+  static void SetCurrentThreadName(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the events of all threads that were recorded within
+  ///             the given window before now, sorted by timestamp. This is
+  ///             safe to call while other threads keep recording.
+  ///
+  static std::vector<Event> Snapshot(fml::TimeDelta window);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Same as `Snapshot` but returns the events as a Chrome trace
+  ///             event format JSON document.
+  ///
+  static std::string SnapshotToChromeTrace(fml::TimeDelta window);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the output of `SnapshotToChromeTrace` to a file in the
+  ///             given directory.
+  ///
+  /// @return     If the file was written.
+  ///
+  static bool WriteSnapshot(const fml::UniqueFD& directory,
+                            const char* file_name,
+                            fml::TimeDelta window);
+
+ private:
+  static std::atomic_bool enabled_;
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+static constexpr fml::TimeDelta kWindow = fml::TimeDelta::FromSeconds(60);
+
+TEST(TraceRecorderTest, RecordsNothingWhenDisabled) {
+  TraceRecorder::Disable();
+  ASSERT_FALSE(TraceRecorder::IsEnabled());
+  TraceRecorder::Record("Event", Dart_Timeline_Event_Instant, 0);
+  ASSERT_TRUE(TraceRecorder::Snapshot(kWindow).empty());
+}
+
+TEST(TraceRecorderTest, SnapshotsEventsInWindowSortedByTime) {
+  TraceRecorder::Enable(4);
+
+  for (auto name : {"A", "B", "C", "D", "E", "F"}) {
+    TraceRecorder::Record(name, Dart_Timeline_Event_Begin, 0);
+  }
+  std::thread thread([] {
+    Thread::SetCurrentThreadName("recorder_test_thread");
+    TraceRecorder::Record("Other", Dart_Timeline_Event_Async_Begin, 42);
+  });
+  thread.join();
+
+  const auto events = TraceRecorder::Snapshot(kWindow);
+  const auto trace = TraceRecorder::SnapshotToChromeTrace(kWindow);
+  TraceRecorder::Disable();
+
+  // Only the last four events of the first thread are kept.
+  ASSERT_EQ(events.size(), 5u);
+  std::string names;
+  for (size_t i = 0; i < events.size(); i++) {
+    names += events[i].name;
+    if (i > 0) {
+      ASSERT_LE(events[i - 1].timestamp_micros, events[i].timestamp_micros);
+    }
+  }
+  ASSERT_EQ(names, "CDEFOther");
+  ASSERT_EQ(events.back().id, 42);
+  ASSERT_NE(events.front().thread_index, events.back().thread_index);
+
+  ASSERT_NE(trace.find("\"traceEvents\":["), std::string::npos);
+  ASSERT_NE(trace.find("\"name\":\"C\",\"cat\":\"flutter\",\"ph\":\"B\""),
+            std::string::npos);
+  ASSERT_NE(trace.find("\"ph\":\"b\""), std::string::npos);
+  ASSERT_NE(trace.find("\"id\":42"), std::string::npos);
+  ASSERT_NE(trace.find("\"name\":\"recorder_test_thread\""), std::string::npos);
+}
+
+TEST(TraceRecorderTest, TruncatesLongNames) {
+  TraceRecorder::Enable(1);
+  const std::string name(TraceRecorder::kMaxNameLength * 2, 'x');
+  TraceRecorder::Record(name.c_str(), Dart_Timeline_Event_Instant, 0);
+  const auto events = TraceRecorder::Snapshot(kWindow);
+  TraceRecorder::Disable();
+
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].name, name.substr(0, TraceRecorder::kMaxNameLength));
+}
+
+TEST(TraceRecorderTest, WritesDurationsAndCounterValues) {
+  TraceRecorder::Enable(8);
+  const int64_t now = fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  TraceRecorder::Record("Duration", Dart_Timeline_Event_Duration,
+                        now - 750,  // end timestamp
+                        now - 1000);
+  const char* names[] = {"Count", "Invalid", "MBytes"};
+  const char* values[] = {"3", "three", "1.5"};
+  TraceRecorder::Record("Counter", Dart_Timeline_Event_Counter, 0, now, 3,
+                        names, values);
+  const auto events = TraceRecorder::Snapshot(kWindow);
+  const auto trace = TraceRecorder::SnapshotToChromeTrace(kWindow);
+  TraceRecorder::Disable();
+
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].timestamp_micros, now - 1000);
+  ASSERT_EQ(events[0].end_timestamp_micros, now - 750);
+  ASSERT_EQ(events[1].counter_values,
+            (std::vector<std::pair<std::string, double>>{{"Count", 3.0},
+                                                         {"MBytes", 1.5}}));
+
+  ASSERT_NE(trace.find("\"ph\":\"X\",\"ts\":" + std::to_string(now - 1000)),
+            std::string::npos);
+  ASSERT_NE(trace.find("\"dur\":250"), std::string::npos);
+  ASSERT_NE(trace.find("\"ph\":\"C\""), std::string::npos);
+  ASSERT_NE(trace.find("\"args\":{\"Count\":3,\"MBytes\":1.5}"),
+            std::string::npos);
+}
+
+// Trace events are forwarded to the system tracing on Fuchsia.
+#if !defined(OS_FUCHSIA)
+// This also runs in release builds, where the Dart timeline is compiled out
+// and the trace macros only feed the recorder.
+TEST(TraceRecorderTest, SnapshotWindowFiltersTracedEvents) {
+  TraceRecorder::Enable();
+  { TRACE_EVENT0("flutter", "Old"); }
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  { TRACE_EVENT0("flutter", "New"); }
+  FML_TRACE_COUNTER("flutter", "Counter", 0, "Value", 7);
+  const auto events =
+      TraceRecorder::Snapshot(fml::TimeDelta::FromMilliseconds(150));
+  TraceRecorder::Disable();
+
+  // The events traced with Dart timeline timestamps are within the window
+  // of the recorder clock, and the older ones are left out. Converting the
+  // timestamps may reorder events traced within a microsecond, so only their
+  // names are compared.
+  std::multiset<std::string> names;
+  for (const auto& event : events) {
+    names.insert(event.name);
+  }
+  ASSERT_EQ(names, (std::multiset<std::string>{"New", "New", "Counter"}));
+  for (const auto& event : events) {
+    if (event.type == Dart_Timeline_Event_Counter) {
+      ASSERT_EQ(event.counter_values,
+                (std::vector<std::pair<std::string, double>>{{"Value", 7.0}}));
+    }
+  }
+}
+
+TEST(TraceRecorderTest, RecordsAsyncCompleteEvents) {
+  TraceRecorder::Enable();
+  const auto now = fml::TimePoint::Now();
+  fml::tracing::TraceEventAsyncComplete(
+      "flutter", "Async", now - fml::TimeDelta::FromMilliseconds(2),
+      now - fml::TimeDelta::FromMilliseconds(1), "Frame", "1");
+  const auto events = TraceRecorder::Snapshot(kWindow);
+  TraceRecorder::Disable();
+
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].type, Dart_Timeline_Event_Async_Begin);
+  ASSERT_EQ(events[1].type, Dart_Timeline_Event_Async_End);
+  ASSERT_EQ(events[0].id, events[1].id);
+  // Allow for the clocks moving apart while the timestamps are converted.
+  ASSERT_NEAR(events[1].timestamp_micros - events[0].timestamp_micros, 1000,
+              10);
+}
+#endif  // !defined(OS_FUCHSIA)
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
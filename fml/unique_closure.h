@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_UNIQUE_CLOSURE_H_
+#define FLUTTER_FML_UNIQUE_CLOSURE_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only `void()` callable, used for the tasks posted to
+///             task runners.
+///
+///             Unlike `fml::closure`, which is a `std::function`, the callable
+///             doesn't have to be copyable, so lambdas can capture move-only
+///             state without `fml::MakeCopyable`. Callables of up to
+///             `kInlineSize` bytes, which covers most lambdas as well as
+///             `std::function`s, are stored inline instead of on the heap.
+///
+///             A `fml::closure` converts to a `UniqueClosure` implicitly. An
+///             empty `fml::closure` or a null function pointer converts to an
+///             empty `UniqueClosure`.
+///
+class UniqueClosure {
+ public:
+  static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+  UniqueClosure() = default;
+
+  UniqueClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename Decayed = std::decay_t<Callable>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Decayed, UniqueClosure> &&
+                std::is_invocable_r_v<void, Decayed&>>>
+  UniqueClosure(Callable&& callable) {
+    if (IsNull(callable)) {
+      return;
+    }
+    if constexpr (kStoredInline<Decayed>) {
+      new (storage_) Decayed(std::forward<Callable>(callable));
+    } else {
+      *reinterpret_cast<Decayed**>(storage_) =
+          new Decayed(std::forward<Callable>(callable));
+    }
+    ops_ = &kOps<Decayed>;
+  }
+
+  UniqueClosure(UniqueClosure&& other) noexcept { MoveFrom(other); }
+
+  UniqueClosure& operator=(UniqueClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueClosure() { Reset(); }
+
+  // Like std::function, the callable may modify its state even though the
+  // closure is const.
+  void operator()() const {
+    FML_DCHECK(ops_);
+    ops_->invoke(const_cast<unsigned char*>(storage_));
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  /// Whether the callable is stored inline, that is without a heap
+  /// allocation. Empty closures are not.
+  bool is_inline() const { return ops_ && ops_->is_inline; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    // Move constructs the callable into |to| and destroys it in |from|.
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+    bool is_inline;
+  };
+
+  template <typename Callable>
+  static constexpr bool kStoredInline =
+      sizeof(Callable) <= kInlineSize &&
+      alignof(Callable) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Callable>;
+
+  template <typename Callable>
+  static Callable* Get(void* storage) {
+    if constexpr (kStoredInline<Callable>) {
+      return std::launder(reinterpret_cast<Callable*>(storage));
+    } else {
+      return *reinterpret_cast<Callable**>(storage);
+    }
+  }
+
+  template <typename Callable>
+  static void Invoke(void* storage) {
+    (*Get<Callable>(storage))();
+  }
+
+  template <typename Callable>
+  static void Relocate(void* from, void* to) {
+    if constexpr (kStoredInline<Callable>) {
+      Callable* callable = Get<Callable>(from);
+      new (to) Callable(std::move(*callable));
+      callable->~Callable();
+    } else {
+      *reinterpret_cast<Callable**>(to) = Get<Callable>(from);
+    }
+  }
+
+  template <typename Callable>
+  static void Destroy(void* storage) {
+    if constexpr (kStoredInline<Callable>) {
+      Get<Callable>(storage)->~Callable();
+    } else {
+      delete Get<Callable>(storage);
+    }
+  }
+
+  template <typename Callable>
+  static constexpr Ops kOps = {&Invoke<Callable>, &Relocate<Callable>,
+                               &Destroy<Callable>, kStoredInline<Callable>};
+
+  template <typename Callable>
+  static bool IsNull(const Callable& callable) {
+    if constexpr (std::is_pointer_v<Callable>) {
+      return callable == nullptr;
+    } else if constexpr (std::is_same_v<Callable, std::function<void()>>) {
+      return !callable;
+    } else {
+      return false;
+    }
+  }
+
+  void MoveFrom(UniqueClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      // Clear the closure first in case destroying the callable resets it.
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(storage_);
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const Ops* ops_ = nullptr;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_UNIQUE_CLOSURE_H_
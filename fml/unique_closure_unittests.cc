@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/unique_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+// Counts how many instances are alive.
+class Counted {
+ public:
+  explicit Counted(int* count) : count_(count) { (*count_)++; }
+
+  Counted(Counted&& other) noexcept : count_(other.count_) { (*count_)++; }
+
+  ~Counted() { (*count_)--; }
+
+ private:
+  int* count_;
+};
+
+void IncrementValue(int* value) {
+  (*value)++;
+}
+
+}  // namespace
+
+TEST(UniqueClosureTest, IsEmptyByDefault) {
+  UniqueClosure closure;
+  ASSERT_FALSE(closure);
+  ASSERT_FALSE(closure.is_inline());
+
+  UniqueClosure null_closure = nullptr;
+  ASSERT_FALSE(null_closure);
+}
+
+TEST(UniqueClosureTest, StoresSmallLambdasInline) {
+  int value = 0;
+  UniqueClosure closure = [&value] { value++; };
+  ASSERT_TRUE(closure);
+  ASSERT_TRUE(closure.is_inline());
+  closure();
+  closure();
+  ASSERT_EQ(value, 2);
+}
+
+TEST(UniqueClosureTest, StoresLargeLambdasOnTheHeap) {
+  std::array<char, UniqueClosure::kInlineSize + 1> data = {};
+  data[0] = 3;
+  int value = 0;
+  UniqueClosure closure = [data, &value] { value = data[0]; };
+  ASSERT_TRUE(closure);
+  ASSERT_FALSE(closure.is_inline());
+  closure();
+  ASSERT_EQ(value, 3);
+}
+
+TEST(UniqueClosureTest, CanCaptureMoveOnlyState) {
+  auto pointer = std::make_unique<int>(5);
+  int value = 0;
+  UniqueClosure closure = [pointer = std::move(pointer), &value] {
+    value = *pointer;
+  };
+  ASSERT_TRUE(closure.is_inline());
+  closure();
+  ASSERT_EQ(value, 5);
+}
+
+TEST(UniqueClosureTest, ConvertsFromClosures) {
+  int value = 0;
+  fml::closure function = [&value] { value++; };
+  UniqueClosure closure = function;
+  ASSERT_TRUE(closure.is_inline());
+  closure();
+  ASSERT_EQ(value, 1);
+
+  UniqueClosure empty = fml::closure();
+  ASSERT_FALSE(empty);
+}
+
+TEST(UniqueClosureTest, ConvertsFromFunctionPointers) {
+  int value = 0;
+  void (*function)(int*) = &IncrementValue;
+  UniqueClosure closure = [function, &value] { function(&value); };
+  closure();
+  ASSERT_EQ(value, 1);
+
+  void (*null_function)() = nullptr;
+  UniqueClosure empty = null_function;
+  ASSERT_FALSE(empty);
+}
+
+TEST(UniqueClosureTest, MovingTransfersTheCallable) {
+  int count = 0;
+  {
+    UniqueClosure closure = [counted = Counted(&count)] {};
+    ASSERT_EQ(count, 1);
+
+    UniqueClosure moved = std::move(closure);
+    ASSERT_EQ(count, 1);
+    ASSERT_TRUE(moved);
+    ASSERT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+
+    UniqueClosure assigned;
+    assigned = std::move(moved);
+    ASSERT_EQ(count, 1);
+    ASSERT_TRUE(assigned);
+    ASSERT_FALSE(moved);  // NOLINT(bugprone-use-after-move)
+  }
+  ASSERT_EQ(count, 0);
+}
+
+TEST(UniqueClosureTest, DestroysTheCallableWhenReset) {
+  int count = 0;
+  UniqueClosure inline_closure = [counted = Counted(&count)] {};
+  std::array<char, UniqueClosure::kInlineSize> data = {};
+  UniqueClosure heap_closure = [counted = Counted(&count), data] {};
+  ASSERT_TRUE(inline_closure.is_inline());
+  ASSERT_FALSE(heap_closure.is_inline());
+  ASSERT_EQ(count, 2);
+
+  inline_closure = nullptr;
+  ASSERT_EQ(count, 1);
+  heap_closure = UniqueClosure();
+  ASSERT_EQ(count, 0);
+}
+
+}  // namespace testing
+}  // namespace fml
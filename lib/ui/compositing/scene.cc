@@ -75,6 +75,18 @@ Dart_Handle Scene::toImage(uint32_t width,
     return tonic::ToDart("Scene did not contain a layer tree.");
   }
 
+  auto* dart_state = UIDartState::Current();
+  if (dart_state->enable_display_list()) {
+    auto display_list = layer_tree_->FlattenToDisplayList(
+        SkRect::MakeWH(width, height), dart_state->GetLayerRecordCache());
+    if (!display_list) {
+      return tonic::ToDart("Could not flatten scene into a display list.");
+    }
+    return Picture::RasterizeToImage(
+        [display_list](SkCanvas* canvas) { display_list->RenderTo(canvas); },
+        width, height, raw_image_callback);
+  }
+
   auto picture = layer_tree_->Flatten(SkRect::MakeWH(width, height));
   if (!picture) {
     return tonic::ToDart("Could not flatten scene into a layer tree.");
@@ -203,8 +203,14 @@ void SceneBuilder::pushBackdropFilter(Dart_Handle layer_handle,
                                       ImageFilter* filter,
                                       int blendMode,
                                       fml::RefPtr<EngineLayer> oldLayer) {
+  std::optional<flutter::BackdropFilterLayer::Blur> blur;
+  if (filter->blur_sigma()) {
+    const SkVector& sigma = *filter->blur_sigma();
+    blur = flutter::BackdropFilterLayer::Blur{sigma.x(), sigma.y(),
+                                              filter->blur_tile_mode()};
+  }
   auto layer = std::make_shared<flutter::BackdropFilterLayer>(
-      filter->filter(), static_cast<SkBlendMode>(blendMode));
+      filter->filter(), static_cast<SkBlendMode>(blendMode), blur);
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -267,12 +273,12 @@ void SceneBuilder::addPicture(double dx,
                               Picture* picture,
                               int hints) {
   if (picture->picture()) {
-    auto layer = std::make_unique<flutter::PictureLayer>(
+    auto layer = layer_arena_.Make<flutter::PictureLayer>(
         SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(picture->picture()),
         !!(hints & 1), !!(hints & 2));
     AddLayer(std::move(layer));
   } else {
-    auto layer = std::make_unique<flutter::DisplayListLayer>(
+    auto layer = layer_arena_.Make<flutter::DisplayListLayer>(
         SkPoint::Make(dx, dy), picture->display_list(), !!(hints & 1),
         !!(hints & 2));
     AddLayer(std::move(layer));
@@ -287,7 +293,7 @@ void SceneBuilder::addTexture(double dx,
                               bool freeze,
                               int filterQualityIndex) {
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
-  auto layer = std::make_unique<flutter::TextureLayer>(
+  auto layer = layer_arena_.Make<flutter::TextureLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
       sampling);
   AddLayer(std::move(layer));
@@ -298,7 +304,7 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
-  auto layer = std::make_unique<flutter::PlatformViewLayer>(
+  auto layer = layer_arena_.Make<flutter::PlatformViewLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
 }
@@ -310,7 +316,7 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
   auto layer =
-      std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
+      layer_arena_.Make<flutter::PerformanceOverlayLayer>(enabledOptions);
   layer->set_paint_bounds(rect);
   AddLayer(std::move(layer));
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -133,6 +134,11 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   void PopLayer();
 
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
+  // Leaf layers can't be retained through an |EngineLayer| and usually don't
+  // outlive the frame, so they are allocated in bulk. Container layers stay on
+  // the heap: the framework holds on to their engine layers across frames and
+  // they would otherwise keep whole blocks of previous frames alive.
+  LayerArena layer_arena_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
   bool checkerboard_offscreen_layers_ = false;
@@ -65,6 +65,15 @@ Future<void> createSingleFrameCodec() async {
 }
 void _validateCodec(Codec codec) native 'ValidateCodec';
 
+@pragma('vm:entry-point')
+Future<void> createImmutableBufferFromAsset() async {
+  final ImmutableBuffer buffer = await ImmutableBuffer.fromAsset('immutable_buffer_asset');
+  _validateImmutableBuffer(buffer);
+  buffer.dispose();
+  _finish();
+}
+void _validateImmutableBuffer(ImmutableBuffer buffer) native 'ValidateImmutableBuffer';
+
 @pragma('vm:entry-point')
 void createVertices() {
   const int uint16max = 65535;
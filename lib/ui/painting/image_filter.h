@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_FILTER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_FILTER_H_
 
+#include <optional>
+
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -34,12 +36,20 @@ class ImageFilter : public RefCountedDartWrappable<ImageFilter> {
 
   const sk_sp<SkImageFilter>& filter() const { return filter_; }
 
+  // The sigmas of the filter if it was made by initBlur, which lets layers
+  // run it at a reduced resolution.
+  const std::optional<SkVector>& blur_sigma() const { return blur_sigma_; }
+
+  SkTileMode blur_tile_mode() const { return blur_tile_mode_; }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   ImageFilter();
 
   sk_sp<SkImageFilter> filter_;
+  std::optional<SkVector> blur_sigma_;
+  SkTileMode blur_tile_mode_ = SkTileMode::kClamp;
 };
 
 }  // namespace flutter
@@ -4,9 +4,13 @@
 
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 
+#include <atomic>
 #include <cstring>
 
+#include "flutter/assets/asset_manager.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -29,6 +33,8 @@ ImmutableBuffer::~ImmutableBuffer() {}
 
 void ImmutableBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
+                     {"ImmutableBuffer_initFromAsset",
+                      ImmutableBuffer::initFromAsset, 3, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
@@ -49,6 +55,38 @@ void ImmutableBuffer::init(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+void ImmutableBuffer::initFromAsset(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Callback must be a function"));
+    return;
+  }
+
+  Dart_Handle buffer_handle = Dart_GetNativeArgument(args, 0);
+  std::string asset_name = tonic::DartConverter<std::string>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  auto* dart_state = UIDartState::Current();
+  std::shared_ptr<AssetManager> asset_manager =
+      dart_state->platform_configuration()->client()->GetAssetManager();
+  std::unique_ptr<fml::Mapping> data =
+      asset_manager ? asset_manager->GetAsMapping(asset_name) : nullptr;
+  // Mappings of empty files have no data, other mappings without data could
+  // not be read, like APK assets that failed to decompress.
+  if (data == nullptr ||
+      (data->GetMapping() == nullptr && data->GetSize() != 0)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Asset not found"));
+    return;
+  }
+
+  size_t size = data->GetSize();
+  auto sk_data = MakeSkDataFromMapping(std::move(data));
+  auto buffer = fml::MakeRefCounted<ImmutableBuffer>(sk_data);
+  buffer->AssociateWithDartWrapper(buffer_handle);
+  tonic::DartInvoke(callback_handle, {tonic::ToDart(size)});
+}
+
 size_t ImmutableBuffer::GetAllocationSize() const {
   return sizeof(ImmutableBuffer) + data_->size();
 }
@@ -98,4 +136,31 @@ sk_sp<SkData> ImmutableBuffer::MakeSkDataWithCopy(const void* data,
 
 #endif  // OS_ANDROID
 
+// Asset mappings backed by a file are not subject to the allocator issue
+// described above, so the SkData can own them directly. Others are copied,
+// like compressed APK assets, which are decompressed into a heap allocation.
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping->GetSize() == 0) {
+    return SkData::MakeEmpty();
+  }
+
+  if (!mapping->IsFileBacked()) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), mapping->GetSize());
+  }
+
+  static std::atomic<int64_t> bytes_not_copied = 0;
+  bytes_not_copied += mapping->GetSize();
+  FML_TRACE_COUNTER("flutter", "ImmutableBuffer::FromAsset",
+                    0,  // Trace Counter ID
+                    "BytesNotCopied", bytes_not_copied.load());
+
+  const uint8_t* data = mapping->GetMapping();
+  size_t size = mapping->GetSize();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(data, size, proc, mapping.release());
+}
+
 }  // namespace flutter
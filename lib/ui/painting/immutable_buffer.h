@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -39,6 +40,23 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// when the copy has completed.
   static void init(Dart_NativeArguments args);
 
+  /// Initializes a new ImmutableData from an asset matching a provided asset
+  /// string.
+  ///
+  /// The zero indexed argument is the the caller that will be registered as the
+  /// Dart peer of the native ImmutableBuffer object.
+  ///
+  /// The first indexed argumented is a String corresponding to the asset
+  /// to load.
+  ///
+  /// The second indexed argument is expected to be a void callback to signal
+  /// when the buffer has been initialized, with the length of the asset in
+  /// bytes.
+  ///
+  /// The buffer takes ownership of the fml::Mapping returned by the asset
+  /// manager instead of copying it.
+  static void initFromAsset(Dart_NativeArguments args);
+
   /// The length of the data in bytes.
   size_t length() const {
     FML_DCHECK(data_);
@@ -69,6 +87,9 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
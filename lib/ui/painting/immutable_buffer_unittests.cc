@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+
+#include <cstring>
+#include <memory>
+
+#include "flutter/assets/asset_index.h"
+#include "flutter/assets/asset_manager.h"
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST_F(ShellTest, ImmutableBufferFromAssetSharesTheAssetData) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  // The data of assets in an index stays at the same address for as long as
+  // the asset manager lives, so a buffer that shares it can be told apart
+  // from a copy.
+  const std::string kAssetData = "immutable buffer asset data";
+  fml::ScopedTemporaryDirectory asset_dir;
+  auto index = AssetIndex::Serialize(
+      {{"immutable_buffer_asset",
+        std::vector<uint8_t>(kAssetData.begin(), kAssetData.end())}});
+  ASSERT_TRUE(index);
+  ASSERT_TRUE(
+      fml::WriteAtomically(asset_dir.fd(), AssetIndex::kFileName, *index));
+
+  auto validate_buffer = [&kAssetData](Dart_NativeArguments args) {
+    auto handle = Dart_GetNativeArgument(args, 0);
+    intptr_t peer = 0;
+    Dart_Handle result = Dart_GetNativeInstanceField(
+        handle, tonic::DartWrappable::kPeerIndex, &peer);
+    ASSERT_FALSE(Dart_IsError(result));
+    ImmutableBuffer* buffer = reinterpret_cast<ImmutableBuffer*>(peer);
+    ASSERT_EQ(buffer->length(), kAssetData.size());
+    ASSERT_EQ(memcmp(buffer->data()->data(), kAssetData.data(),
+                     kAssetData.size()),
+              0);
+
+    std::shared_ptr<AssetManager> asset_manager = UIDartState::Current()
+                                                      ->platform_configuration()
+                                                      ->client()
+                                                      ->GetAssetManager();
+    ASSERT_TRUE(asset_manager);
+    auto mapping = asset_manager->GetAsMapping("immutable_buffer_asset");
+    ASSERT_TRUE(mapping);
+    ASSERT_EQ(buffer->data()->data(), mapping->GetMapping());
+  };
+  auto finish = [message_latch](Dart_NativeArguments args) {
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  settings.assets_path = asset_dir.path();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("ValidateImmutableBuffer",
+                    CREATE_NATIVE_ENTRY(validate_buffer));
+  AddNativeCallback("Finish", CREATE_NATIVE_ENTRY(finish));
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("createImmutableBufferFromAsset");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
+}  // namespace testing
+}  // namespace flutter
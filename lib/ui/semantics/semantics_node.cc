@@ -14,6 +14,13 @@ SemanticsNode::SemanticsNode() = default;
 
 SemanticsNode::SemanticsNode(const SemanticsNode& other) = default;
 
+SemanticsNode::SemanticsNode(SemanticsNode&& other) noexcept = default;
+
+SemanticsNode& SemanticsNode::operator=(const SemanticsNode& other) = default;
+
+SemanticsNode& SemanticsNode::operator=(SemanticsNode&& other) noexcept =
+    default;
+
 SemanticsNode::~SemanticsNode() = default;
 
 bool SemanticsNode::HasAction(SemanticsAction action) const {
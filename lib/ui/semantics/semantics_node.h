@@ -98,6 +98,12 @@ struct SemanticsNode {
 
   SemanticsNode(const SemanticsNode& other);
 
+  SemanticsNode(SemanticsNode&& other) noexcept;
+
+  SemanticsNode& operator=(const SemanticsNode& other);
+
+  SemanticsNode& operator=(SemanticsNode&& other) noexcept;
+
   ~SemanticsNode();
 
   bool HasAction(SemanticsAction action) const;
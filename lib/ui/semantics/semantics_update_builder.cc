@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 
+#include <utility>
+
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkScalar.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -104,15 +106,15 @@ void SemanticsUpdateBuilder::updateNode(
   node.rect = SkRect::MakeLTRB(left, top, right, bottom);
   node.elevation = elevation;
   node.thickness = thickness;
-  node.label = label;
+  node.label = std::move(label);
   pushStringAttributes(node.labelAttributes, labelAttributes);
-  node.value = value;
+  node.value = std::move(value);
   pushStringAttributes(node.valueAttributes, valueAttributes);
-  node.increasedValue = increasedValue;
+  node.increasedValue = std::move(increasedValue);
   pushStringAttributes(node.increasedValueAttributes, increasedValueAttributes);
-  node.decreasedValue = decreasedValue;
+  node.decreasedValue = std::move(decreasedValue);
   pushStringAttributes(node.decreasedValueAttributes, decreasedValueAttributes);
-  node.hint = hint;
+  node.hint = std::move(hint);
   pushStringAttributes(node.hintAttributes, hintAttributes);
   node.textDirection = textDirection;
   SkScalar scalarTransform[16];
@@ -130,7 +132,7 @@ void SemanticsUpdateBuilder::updateNode(
   node.customAccessibilityActions = std::vector<int32_t>(
       localContextActions.data(),
       localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -140,9 +142,9 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
   CustomAccessibilityAction action;
   action.id = id;
   action.overrideId = overrideId;
-  action.label = label;
-  action.hint = hint;
-  actions_[id] = action;
+  action.label = std::move(label);
+  action.hint = std::move(hint);
+  actions_[id] = std::move(action);
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
@@ -6,6 +6,7 @@
 
 #include <iostream>
 
+#include "flutter/flow/layers/layer_record_cache.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -67,7 +68,8 @@ UIDartState::UIDartState(
       isolate_name_server_(std::move(isolate_name_server)),
       enable_skparagraph_(enable_skparagraph),
       enable_display_list_(enable_display_list),
-      context_(std::move(context)) {
+      context_(std::move(context)),
+      layer_record_cache_(std::make_unique<LayerRecordCache>()) {
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -244,4 +246,8 @@ bool UIDartState::enable_display_list() const {
   return enable_display_list_;
 }
 
+LayerRecordCache* UIDartState::GetLayerRecordCache() const {
+  return layer_record_cache_.get();
+}
+
 }  // namespace flutter
@@ -29,6 +29,7 @@
 namespace flutter {
 class FontSelector;
 class ImageGeneratorRegistry;
+class LayerRecordCache;
 class PlatformConfiguration;
 
 class UIDartState : public tonic::DartState {
@@ -145,6 +146,10 @@ class UIDartState : public tonic::DartState {
 
   bool enable_display_list() const;
 
+  // Keeps the records of the subtrees of flattened scenes so that scenes
+  // that are converted to images repeatedly only record what changed.
+  LayerRecordCache* GetLayerRecordCache() const;
+
   template <class T>
   static flutter::SkiaGPUObject<T> CreateGPUObject(sk_sp<T> object) {
     if (!object) {
@@ -194,6 +199,7 @@ class UIDartState : public tonic::DartState {
   const bool enable_skparagraph_;
   const bool enable_display_list_;
   UIDartState::Context context_;
+  std::unique_ptr<LayerRecordCache> layer_record_cache_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
@@ -11,6 +11,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/assets/asset_manager.h"
+
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
@@ -99,6 +101,11 @@ class PlatformConfigurationClient {
   ///             creation.
   virtual FontCollection& GetFontCollection() = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the current collection of assets available on the
+  ///             platform.
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      Notifies this client of the name of the root isolate and its
   ///             port when that isolate is launched, restarted (in the
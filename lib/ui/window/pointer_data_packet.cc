@@ -8,6 +8,16 @@
 
 namespace flutter {
 
+namespace {
+
+bool IsMove(const PointerData& data) {
+  return data.signal_kind == PointerData::SignalKind::kNone &&
+         (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover);
+}
+
+}  // namespace
+
 PointerDataPacket::PointerDataPacket(size_t count)
     : data_(count * sizeof(PointerData)) {}
 
@@ -20,4 +30,41 @@ void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
 }
 
+PointerData PointerDataPacket::GetPointerData(size_t i) const {
+  PointerData data;
+  memcpy(&data, &data_[i * sizeof(PointerData)], sizeof(PointerData));
+  return data;
+}
+
+void PointerDataPacket::Assign(const PointerData* data, size_t count) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  data_.assign(bytes, bytes + count * sizeof(PointerData));
+}
+
+size_t PointerDataPacket::AppendCoalescingMoves(
+    const PointerDataPacket& other) {
+  size_t merged = 0;
+  data_.reserve(data_.size() + other.data_.size());
+  for (size_t i = 0; i < other.GetLength(); i++) {
+    PointerData data = other.GetPointerData(i);
+    if (IsMove(data) && GetLength() > 0) {
+      PointerData previous = GetPointerData(GetLength() - 1);
+      if (previous.change == data.change && IsMove(previous) &&
+          previous.device == data.device &&
+          previous.pointer_identifier == data.pointer_identifier &&
+          previous.buttons == data.buttons) {
+        data.physical_delta_x += previous.physical_delta_x;
+        data.physical_delta_y += previous.physical_delta_y;
+        data.synthesized = data.synthesized && previous.synthesized;
+        SetPointerData(GetLength() - 1, data);
+        merged++;
+        continue;
+      }
+    }
+    data_.resize(data_.size() + sizeof(PointerData));
+    SetPointerData(GetLength() - 1, data);
+  }
+  return merged;
+}
+
 }  // namespace flutter
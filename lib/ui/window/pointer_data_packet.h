@@ -20,8 +20,31 @@ class PointerDataPacket {
   ~PointerDataPacket();
 
   void SetPointerData(size_t i, const PointerData& data);
+  PointerData GetPointerData(size_t i) const;
+  size_t GetLength() const { return data_.size() / sizeof(PointerData); }
   const std::vector<uint8_t>& data() const { return data_; }
 
+  /// Replaces the contents of the packet with |count| pointer data.
+  void Assign(const PointerData* data, size_t count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the pointer data of |other| to this packet, merging
+  ///             moves and hovers into the previous move or hover of the same
+  ///             pointer.
+  ///
+  ///             Events are only merged into the last event of the packet, so
+  ///             that the framework still sees the events of different
+  ///             pointers and devices interleaved as they came in. The merged
+  ///             event has the position and time of the later one and the
+  ///             summed deltas.
+  ///
+  /// @param[in]  other  A converted packet, that is one with deltas and
+  ///                    pointer identifiers filled in.
+  ///
+  /// @return     The number of events merged.
+  ///
+  size_t AppendCoalescingMoves(const PointerDataPacket& other);
+
  private:
   std::vector<uint8_t> data_;
 
@@ -16,29 +16,16 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
-  size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
-  auto buffer = packet->data();
-  size_t buffer_length = buffer.size();
-
-  std::vector<PointerData> converted_pointers;
-  // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
-  for (size_t i = 0; i < buffer_length / kBytesPerPointerData; i++) {
-    PointerData pointer_data;
-    memcpy(&pointer_data, &buffer[i * kBytesPerPointerData],
-           sizeof(PointerData));
-    ConvertPointerData(pointer_data, converted_pointers);
+  // Converts into a buffer that is kept from packet to packet and writes the
+  // result back into the packet, so that converting doesn't allocate once the
+  // buffer has grown to the usual packet size.
+  converted_pointers_.clear();
+  const size_t length = packet->GetLength();
+  for (size_t i = 0; i < length; i++) {
+    ConvertPointerData(packet->GetPointerData(i), converted_pointers_);
   }
-
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
-  size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
-  }
-
-  return converted_packet;
+  packet->Assign(converted_pointers_.data(), converted_pointers_.size());
+  return packet;
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
@@ -51,9 +38,9 @@ void PointerDataPacketConverter::ConvertPointerData(
         // to a non-existing pointer. Drops the cancel if pointer
         // is not previously added.
         // https://github.com/flutter/flutter/issues/20517
-        auto iter = states_.find(pointer_data.device);
-        if (iter != states_.end()) {
-          PointerState state = iter->second;
+        const PointerState* found = FindPointerState(pointer_data.device);
+        if (found) {
+          PointerState state = *found;
           FML_DCHECK(state.is_down);
           UpdatePointerIdentifier(pointer_data, state, false);
 
@@ -68,22 +55,22 @@ void PointerDataPacketConverter::ConvertPointerData(
           }
 
           state.is_down = false;
-          states_[pointer_data.device] = state;
+          SetPointerState(pointer_data.device, state);
           converted_pointers.push_back(pointer_data);
         }
         break;
       }
       case PointerData::Change::kAdd: {
-        FML_DCHECK(states_.find(pointer_data.device) == states_.end());
+        FML_DCHECK(!FindPointerState(pointer_data.device));
         EnsurePointerState(pointer_data);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kRemove: {
         // Makes sure we have an existing pointer
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        const PointerState* found = FindPointerState(pointer_data.device);
+        FML_DCHECK(found);
+        PointerState state = *found;
 
         if (state.is_down) {
           // Synthesizes cancel event if the pointer is down.
@@ -93,7 +80,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           UpdatePointerIdentifier(synthesized_cancel_event, state, false);
 
           state.is_down = false;
-          states_[synthesized_cancel_event.device] = state;
+          SetPointerState(synthesized_cancel_event.device, state);
           converted_pointers.push_back(synthesized_cancel_event);
         }
 
@@ -107,14 +94,14 @@ void PointerDataPacketConverter::ConvertPointerData(
           converted_pointers.push_back(synthesized_hover_event);
         }
 
-        states_.erase(pointer_data.device);
+        RemovePointerState(pointer_data.device);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kHover: {
-        auto iter = states_.find(pointer_data.device);
+        const PointerState* found = FindPointerState(pointer_data.device);
         PointerState state;
-        if (iter == states_.end()) {
+        if (!found) {
           // Synthesizes add event if the pointer is not previously added.
           PointerData synthesized_add_event = pointer_data;
           synthesized_add_event.change = PointerData::Change::kAdd;
@@ -123,7 +110,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           state = EnsurePointerState(synthesized_add_event);
           converted_pointers.push_back(synthesized_add_event);
         } else {
-          state = iter->second;
+          state = *found;
         }
 
         FML_DCHECK(!state.is_down);
@@ -135,9 +122,9 @@ void PointerDataPacketConverter::ConvertPointerData(
         break;
       }
       case PointerData::Change::kDown: {
-        auto iter = states_.find(pointer_data.device);
+        const PointerState* found = FindPointerState(pointer_data.device);
         PointerState state;
-        if (iter == states_.end()) {
+        if (!found) {
           // Synthesizes a add event if the pointer is not previously added.
           PointerData synthesized_add_event = pointer_data;
           synthesized_add_event.change = PointerData::Change::kAdd;
@@ -146,7 +133,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           state = EnsurePointerState(synthesized_add_event);
           converted_pointers.push_back(synthesized_add_event);
         } else {
-          state = iter->second;
+          state = *found;
         }
 
         FML_DCHECK(!state.is_down);
@@ -164,15 +151,15 @@ void PointerDataPacketConverter::ConvertPointerData(
         UpdatePointerIdentifier(pointer_data, state, true);
         state.is_down = true;
         state.buttons = pointer_data.buttons;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kMove: {
         // Makes sure we have an existing pointer in down state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        const PointerState* found = FindPointerState(pointer_data.device);
+        FML_DCHECK(found);
+        PointerState state = *found;
         FML_DCHECK(state.is_down);
 
         UpdatePointerIdentifier(pointer_data, state, false);
@@ -183,9 +170,9 @@ void PointerDataPacketConverter::ConvertPointerData(
       }
       case PointerData::Change::kUp: {
         // Makes sure we have an existing pointer in down state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        const PointerState* found = FindPointerState(pointer_data.device);
+        FML_DCHECK(found);
+        PointerState state = *found;
         FML_DCHECK(state.is_down);
 
         UpdatePointerIdentifier(pointer_data, state, false);
@@ -203,7 +190,7 @@ void PointerDataPacketConverter::ConvertPointerData(
 
         state.is_down = false;
         state.buttons = pointer_data.buttons;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
@@ -216,10 +203,10 @@ void PointerDataPacketConverter::ConvertPointerData(
     switch (pointer_data.signal_kind) {
       case PointerData::SignalKind::kScroll: {
         // Makes sure we have an existing pointer
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
+        const PointerState* found = FindPointerState(pointer_data.device);
+        FML_DCHECK(found);
 
-        PointerState state = iter->second;
+        PointerState state = *found;
         if (LocationNeedsUpdate(pointer_data, state)) {
           if (state.is_down) {
             // Synthesizes a move event if the pointer is down.
@@ -263,7 +250,7 @@ PointerState PointerDataPacketConverter::EnsurePointerState(
   state.is_down = false;
   state.physical_x = pointer_data.physical_x;
   state.physical_y = pointer_data.physical_y;
-  states_[pointer_data.device] = state;
+  SetPointerState(pointer_data.device, state);
   return state;
 }
 
@@ -273,7 +260,36 @@ void PointerDataPacketConverter::UpdateDeltaAndState(PointerData& pointer_data,
   pointer_data.physical_delta_y = pointer_data.physical_y - state.physical_y;
   state.physical_x = pointer_data.physical_x;
   state.physical_y = pointer_data.physical_y;
-  states_[pointer_data.device] = state;
+  SetPointerState(pointer_data.device, state);
+}
+
+PointerState* PointerDataPacketConverter::FindPointerState(int64_t device) {
+  for (auto& entry : states_) {
+    if (entry.first == device) {
+      return &entry.second;
+    }
+  }
+  return nullptr;
+}
+
+void PointerDataPacketConverter::SetPointerState(int64_t device,
+                                                 const PointerState& state) {
+  PointerState* existing = FindPointerState(device);
+  if (existing) {
+    *existing = state;
+  } else {
+    states_.emplace_back(device, state);
+  }
+}
+
+void PointerDataPacketConverter::RemovePointerState(int64_t device) {
+  for (auto iter = states_.begin(); iter != states_.end(); ++iter) {
+    if (iter->first == device) {
+      *iter = states_.back();
+      states_.pop_back();
+      return;
+    }
+  }
 }
 
 bool PointerDataPacketConverter::LocationNeedsUpdate(
@@ -289,7 +305,7 @@ void PointerDataPacketConverter::UpdatePointerIdentifier(
     bool start_new_pointer) {
   if (start_new_pointer) {
     state.pointer_identifier = ++pointer_;
-    states_[pointer_data.device] = state;
+    SetPointerState(pointer_data.device, state);
   }
   pointer_data.pointer_identifier = state.pointer_identifier;
 }
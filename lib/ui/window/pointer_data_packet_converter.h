@@ -6,8 +6,8 @@
 #define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_PACKET_CONVERTER_H_
 
 #include <cstring>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -87,18 +87,30 @@ class PointerDataPacketConverter {
   /// filled.
   ///             It may contain synthetic pointer data as the result of
   ///             converter's attempt to correct illegal pointer transitions.
+  ///             This is |packet| itself, converted in place.
   ///
   std::unique_ptr<PointerDataPacket> Convert(
       std::unique_ptr<PointerDataPacket> packet);
 
  private:
-  std::map<int64_t, PointerState> states_;
+  // The states by device. There are only ever a few pointers, so looking them
+  // up in a flat vector is cheaper than in a tree.
+  std::vector<std::pair<int64_t, PointerState>> states_;
+
+  // Holds the converted pointers of the packet being converted.
+  std::vector<PointerData> converted_pointers_;
 
   int64_t pointer_;
 
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
+  PointerState* FindPointerState(int64_t device);
+
+  void SetPointerState(int64_t device, const PointerState& state);
+
+  void RemovePointerState(int64_t device);
+
   PointerState EnsurePointerState(PointerData pointer_data);
 
   void UpdateDeltaAndState(PointerData& pointer_data, PointerState& state);
@@ -599,5 +599,134 @@ TEST(PointerDataPacketConverterTest, CanConvetScroll) {
   ASSERT_EQ(result[6].scroll_delta_y, 0.0);
 }
 
+TEST(PointerDataPacketConverterTest, ConvertsPacketsInPlace) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(0, data);
+  PointerDataPacket* raw_packet = packet.get();
+
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(converted_packet.get(), raw_packet);
+  // The down is preceded by a synthesized add.
+  ASSERT_EQ(converted_packet->GetLength(), 2u);
+  ASSERT_EQ(converted_packet->GetPointerData(0).change,
+            PointerData::Change::kAdd);
+  ASSERT_EQ(converted_packet->GetPointerData(1).change,
+            PointerData::Change::kDown);
+}
+
+TEST(PointerDataPacketConverterTest, CanCoalesceMoves) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(4);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 1, 0.0, 0.0, 1);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 0.0, 1.0, 1);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1, 2.0, 0.0, 1);
+  packet->SetPointerData(3, data);
+  auto pending = converter.Convert(std::move(packet));
+  // Two synthesized adds, two downs and two moves.
+  ASSERT_EQ(pending->GetLength(), 6u);
+
+  packet = std::make_unique<PointerDataPacket>(2);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 0.0, 3.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 0.0, 6.0, 1);
+  packet->SetPointerData(1, data);
+  auto converted_packet = converter.Convert(std::move(packet));
+  // The first move of pointer 0 follows a move of pointer 1 and is kept
+  // apart from the earlier one, so that the pointers stay interleaved.
+  ASSERT_EQ(pending->AppendCoalescingMoves(*converted_packet), 1u);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(pending));
+  ASSERT_EQ(result.size(), 7u);
+  ASSERT_EQ(result[4].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[4].device, 0);
+  ASSERT_EQ(result[4].physical_delta_y, 1.0);
+  ASSERT_EQ(result[5].device, 1);
+  ASSERT_EQ(result[5].physical_delta_x, 2.0);
+  ASSERT_EQ(result[6].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[6].device, 0);
+  ASSERT_EQ(result[6].physical_y, 6.0);
+  ASSERT_EQ(result[6].physical_delta_y, 5.0);
+}
+
+TEST(PointerDataPacketConverterTest, CanCoalesceHovers) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  PointerData data;
+  CreateSimulatedMousePointerData(data, PointerData::Change::kAdd,
+                                  PointerData::SignalKind::kNone, 0, 0.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                  PointerData::SignalKind::kNone, 0, 1.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  auto pending = converter.Convert(std::move(packet));
+  ASSERT_EQ(pending->GetLength(), 2u);
+
+  packet = std::make_unique<PointerDataPacket>(3);
+  CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                  PointerData::SignalKind::kNone, 0, 3.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                  PointerData::SignalKind::kNone, 0, 6.0, 0.0,
+                                  0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  // A scroll is a hover with a signal and is never merged.
+  CreateSimulatedMousePointerData(data, PointerData::Change::kHover,
+                                  PointerData::SignalKind::kScroll, 0, 6.0, 0.0,
+                                  0.0, 10.0, 0);
+  packet->SetPointerData(2, data);
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(pending->AppendCoalescingMoves(*converted_packet), 2u);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(pending));
+  ASSERT_EQ(result.size(), 3u);
+  ASSERT_EQ(result[1].change, PointerData::Change::kHover);
+  ASSERT_EQ(result[1].physical_x, 6.0);
+  ASSERT_EQ(result[1].physical_delta_x, 6.0);
+  ASSERT_EQ(result[2].signal_kind, PointerData::SignalKind::kScroll);
+}
+
+TEST(PointerDataPacketConverterTest, DoesNotCoalesceMovesAcrossOtherChanges) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 0.0, 1.0, 1);
+  packet->SetPointerData(1, data);
+  auto pending = converter.Convert(std::move(packet));
+
+  packet = std::make_unique<PointerDataPacket>(2);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 1, 0.0, 0.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 0.0, 2.0, 1);
+  packet->SetPointerData(1, data);
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(pending->AppendCoalescingMoves(*converted_packet), 0u);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(pending));
+  // Add, down and move of the first pointer, then add and down of the second
+  // one and the move of the first one again.
+  ASSERT_EQ(result.size(), 6u);
+  ASSERT_EQ(result[2].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[2].physical_delta_y, 1.0);
+  ASSERT_EQ(result[4].change, PointerData::Change::kDown);
+  ASSERT_EQ(result[5].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[5].physical_delta_y, 1.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -711,6 +711,11 @@ class ImmutableBuffer {
     return instance;
   }
 
+  static Future<ImmutableBuffer> fromAsset(String assetKey) async {
+    final ByteData data = await webOnlyAssetManager.load(assetKey);
+    return fromUint8List(data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes));
+  }
+
   Uint8List? _list;
   final int length;
 
@@ -19,6 +19,10 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The pipeline runs a frame deeper while the raster thread falls behind, so
+// that the UI thread doesn't skip a frame every time it finds it full.
+constexpr uint32_t kMaxLayerTreePipelineDepth = 3;
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -29,16 +33,18 @@ Animator::Animator(Delegate& delegate,
       waiter_(std::move(waiter)),
       dart_frame_deadline_(0),
 #if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
+      layer_tree_pipeline_(
+          std::make_shared<LayerTreePipeline>(2, kMaxLayerTreePipelineDepth)),
 #else   // SHELL_ENABLE_METAL
       // TODO(dnfield): We should remove this logic and set the pipeline depth
       // back to 2 in this case. See
       // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
+      layer_tree_pipeline_(
           task_runners.GetPlatformTaskRunner() ==
                   task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
+              ? std::make_shared<LayerTreePipeline>(1)
+              : std::make_shared<LayerTreePipeline>(
+                    2, kMaxLayerTreePipelineDepth)),
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       paused_(false),
@@ -283,6 +289,10 @@ void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+fml::TimePoint Animator::GetLastVsyncTargetTime() const {
+  return waiter_->GetLastFrameTargetTime();
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
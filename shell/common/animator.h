@@ -72,6 +72,13 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    The target time of the frame for the last vsync, as seen by
+  ///           the secondary vsync callbacks.
+  ///
+  /// @see      `PointerDataDispatcher::Delegate::GetLastVsyncTargetTime`.
+  fml::TimePoint GetLastVsyncTargetTime() const;
+
   void Start();
 
   void Stop();
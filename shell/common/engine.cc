@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
@@ -145,8 +146,22 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
   font_collection_->SetupDefaultFontManager();
+  LoadFallbackFontHints();
 }
 
+void Engine::SetupDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  font_collection_->GetFontCollection()->SetDefaultFontManager(
+      std::move(font_manager));
+  LoadFallbackFontHints();
+}
+
+void Engine::LoadFallbackFontHints() {
+  font_collection_->GetFontCollection()->LoadFallbackFontHints(
+      PersistentCache::GetCacheForProcess()->LoadFontFallbackHints());
+}
+
+// |RuntimeDelegate|
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -191,6 +206,9 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
     return RunStatus::Failure;
   }
 
+  // The new isolate sends its semantics tree in full.
+  semantics_update_differ_.Reset();
+
   last_entry_point_ = configuration.GetEntrypoint();
   last_entry_point_library_ = configuration.GetEntrypointLibrary();
 
@@ -235,6 +253,14 @@ void Engine::NotifyIdle(int64_t deadline) {
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                trace_event.c_str());
   runtime_controller_->NotifyIdle(deadline);
+
+  // Fallback fonts matched during the last frames are saved while the UI
+  // thread is idle, so the next launch can skip the search for them.
+  auto collection = font_collection_->GetFontCollection();
+  if (collection->HasNewFallbackFontHints()) {
+    PersistentCache::GetCacheForProcess()->StoreFontFallbackHints(
+        collection->SerializeFallbackFontHints());
+  }
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -434,6 +460,9 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The platform builds its semantics tree anew whenever it enables
+  // semantics.
+  semantics_update_differ_.Reset();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
@@ -478,6 +507,12 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  if (settings_.enable_semantics_update_diffing) {
+    semantics_update_differ_.RemoveUnchangedNodes(update);
+    if (update.empty() && actions.empty()) {
+      return;
+    }
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
@@ -524,6 +559,10 @@ void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
 }
 
+fml::TimePoint Engine::GetLastVsyncTargetTime() {
+  return animator_->GetLastVsyncTargetTime();
+}
+
 void Engine::HandleAssetPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
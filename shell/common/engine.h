@@ -31,6 +31,7 @@
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/semantics_update_differ.h"
 #include "flutter/shell/common/shell_io_manager.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -438,6 +439,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Installs a default font manager that was created ahead of
+  ///             time, for example on a concurrent worker during shell setup.
+  ///
+  /// @param[in]  font_manager  The platform default font manager.
+  ///
+  void SetupDefaultFontManager(sk_sp<SkFontMgr> font_manager);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -802,8 +811,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
-  // Return the asset manager associated with the current engine, or nullptr.
-  std::shared_ptr<AssetManager> GetAssetManager();
+  // |RuntimeDelegate|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
 
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -813,6 +822,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  fml::TimePoint GetLastVsyncTargetTime() override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
@@ -911,6 +923,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // is destructed first.
   std::unique_ptr<PointerDataDispatcher> pointer_data_dispatcher_;
 
+  // Only used if |Settings::enable_semantics_update_diffing| is set.
+  SemanticsUpdateDiffer semantics_update_differ_;
+
   std::string last_entry_point_;
   std::string last_entry_point_library_;
   std::string initial_route_;
@@ -970,6 +985,10 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
+  // Loads the fallback fonts matched to characters by an earlier launch from
+  // the persistent cache, so that they are found without a search.
+  void LoadFallbackFontHints();
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
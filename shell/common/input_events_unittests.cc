@@ -412,5 +412,81 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, CoalescesPointerPacketsWhileUIThreadIsBusy) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings, true);
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onPointerDataPacketMain");
+  fml::AutoResetWaitableEvent reportLatch;
+  std::vector<std::vector<int64_t>> packets;
+  auto nativeOnPointerDataPacket = [&reportLatch,
+                                    &packets](Dart_NativeArguments args) {
+    Dart_Handle exception = nullptr;
+    packets.push_back(
+        tonic::DartConverter<std::vector<int64_t>>::FromArguments(args, 0,
+                                                                  exception));
+    if (packets.back().back() ==
+        static_cast<int64_t>(PointerData::Change::kRemove)) {
+      reportLatch.Signal();
+    }
+  };
+  AddNativeCallback("NativeOnPointerDataPacket",
+                    CREATE_NATIVE_ENTRY(nativeOnPointerDataPacket));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+
+  // Keeps the UI thread busy while the packets are dispatched, so that they
+  // all end up in the packet of the first dispatch.
+  fml::AutoResetWaitableEvent ui_thread_blocked;
+  fml::AutoResetWaitableEvent unblock_ui_thread;
+  shell->GetTaskRunners().GetUITaskRunner()->PostTask([&]() {
+    ui_thread_blocked.Signal();
+    unblock_ui_thread.Wait();
+  });
+  ui_thread_blocked.Wait();
+
+  const std::vector<std::vector<std::pair<PointerData::Change, double>>>
+      dispatches = {
+          {{PointerData::Change::kAdd, 0.0}},
+          {{PointerData::Change::kHover, 1.0}},
+          // Merged into the hover above.
+          {{PointerData::Change::kHover, 2.0},
+           {PointerData::Change::kDown, 2.0}},
+          {{PointerData::Change::kMove, 3.0}},
+          // Both merged into the move above.
+          {{PointerData::Change::kMove, 4.0},
+           {PointerData::Change::kMove, 5.0}},
+          {{PointerData::Change::kUp, 5.0},
+           {PointerData::Change::kRemove, 5.0}},
+      };
+  for (const auto& events : dispatches) {
+    auto packet = std::make_unique<PointerDataPacket>(events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+      PointerData data;
+      CreateSimulatedPointerData(data, events[i].first, events[i].second, 0.0);
+      packet->SetPointerData(i, data);
+    }
+    ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+  }
+  unblock_ui_thread.Signal();
+  bool will_draw_new_frame;
+  ShellTest::VSyncFlush(shell.get(), will_draw_new_frame);
+
+  reportLatch.Wait();
+  ASSERT_EQ(packets.size(), 1u);
+  const std::vector<int64_t> expected = {
+      static_cast<int64_t>(PointerData::Change::kAdd),
+      static_cast<int64_t>(PointerData::Change::kHover),
+      static_cast<int64_t>(PointerData::Change::kDown),
+      static_cast<int64_t>(PointerData::Change::kMove),
+      static_cast<int64_t>(PointerData::Change::kUp),
+      static_cast<int64_t>(PointerData::Change::kRemove),
+  };
+  ASSERT_EQ(packets[0], expected);
+
+  DestroyShell(std::move(shell));
+}
+
 }  // namespace testing
 }  // namespace flutter
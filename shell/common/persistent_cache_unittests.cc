@@ -362,5 +362,87 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, PrioritizesSkSLsByRecordedUsage) {
+  // Avoid polluting unit tests output with the missing worker warnings.
+  fml::LogSettings error_only = {fml::LOG_ERROR};
+  fml::ScopedSetLogSettings scoped_set_log_settings(error_only);
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(false);
+
+  sk_sp<SkData> rare_key = SkData::MakeWithCString("rare");
+  sk_sp<SkData> frequent_key = SkData::MakeWithCString("frequent");
+  sk_sp<SkData> unknown_key = SkData::MakeWithCString("unknown");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+
+  // Without worker task runners, the entries and their usage are written on
+  // this thread.
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *rare_key, *value);
+  StorePersistentCache(persistent_cache, *frequent_key, *value);
+  ASSERT_NE(persistent_cache->load(*frequent_key), nullptr);
+  ASSERT_NE(persistent_cache->load(*frequent_key), nullptr);
+
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*rare_key).use_count, 1u);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*frequent_key).use_count, 3u);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*unknown_key).use_count, 0u);
+  ASSERT_GT(persistent_cache->GetSkSLUsage(*frequent_key).last_used_millis, 0);
+
+  std::vector<PersistentCache::SkSLCache> sksls = {
+      {unknown_key, value}, {rare_key, value}, {frequent_key, value}};
+  persistent_cache->PrioritizeSkSLs(sksls);
+  ASSERT_EQ(sksls[0].first, frequent_key);
+  ASSERT_EQ(sksls[1].first, rare_key);
+  ASSERT_EQ(sksls[2].first, unknown_key);
+
+  // The usage survives a restart.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*frequent_key).use_count, 3u);
+  ASSERT_FALSE(persistent_cache->HasPendingSkSLs());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, ShellLoadsFontFallbackHintsOfEarlierLaunch) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  // The hints an earlier launch stored.
+  std::vector<std::string> components = {
+      "flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion()};
+  auto cache_dir = fml::CreateDirectory(base_dir.fd(), components,
+                                        fml::FilePermission::kReadWrite);
+  const std::string hints = "ja\tNoto Sans JP\t4e00-4e02\n";
+  ASSERT_TRUE(fml::WriteAtomically(cache_dir,
+                                   PersistentCache::kFontFallbackHintsFileName,
+                                   fml::DataMapping(hints)));
+
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  // The default font manager is installed on the UI thread once the engine is
+  // set up, which is before this task runs.
+  std::string loaded_hints;
+  fml::AutoResetWaitableEvent latch;
+  shell->GetTaskRunners().GetUITaskRunner()->PostTask([&]() {
+    loaded_hints = GetFontCollection(shell.get())->SerializeFallbackFontHints();
+    latch.Signal();
+  });
+  latch.Wait();
+  EXPECT_EQ(loaded_hints, hints);
+
+  DestroyShell(std::move(shell));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,13 +5,14 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
-#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
-#include <mutex>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
-#include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -26,33 +27,51 @@ size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer.
+///
+/// Resources are kept in a lock-free ring buffer, so handing a resource from
+/// the producer to the consumer neither takes a lock nor allocates.
+///
+/// The depth of the pipeline is the number of resources that may be in flight
+/// at once, from the moment the producer reserves a spot with |Produce| until
+/// the consumer is done with the resource. If a maximum depth larger than the
+/// depth is given, the depth is adaptive: it grows by one, up to the maximum,
+/// whenever the producer finds the pipeline full because the consumer falls
+/// behind, and shrinks back after the consumer has kept up for
+/// |kDepthDecayFrames| consecutive resources.
 template <class R>
 class Pipeline {
  public:
   using Resource = R;
   using ResourcePtr = std::unique_ptr<Resource>;
 
+  /// The number of consecutive resources for which the extra depth must go
+  /// unused before an adaptive pipeline shrinks.
+  static constexpr uint32_t kDepthDecayFrames = 60;
+
   /// Denotes a spot in the pipeline reserved for the producer to finish
   /// preparing a completed pipeline resource.
   class ProducerContinuation {
    public:
-    ProducerContinuation() : trace_id_(0) {}
+    ProducerContinuation() : pipeline_(nullptr), trace_id_(0) {}
 
     ProducerContinuation(ProducerContinuation&& other)
-        : continuation_(other.continuation_), trace_id_(other.trace_id_) {
-      other.continuation_ = nullptr;
+        : pipeline_(other.pipeline_),
+          if_empty_(other.if_empty_),
+          trace_id_(other.trace_id_) {
+      other.pipeline_ = nullptr;
       other.trace_id_ = 0;
     }
 
     ProducerContinuation& operator=(ProducerContinuation&& other) {
-      std::swap(continuation_, other.continuation_);
+      std::swap(pipeline_, other.pipeline_);
+      std::swap(if_empty_, other.if_empty_);
       std::swap(trace_id_, other.trace_id_);
       return *this;
     }
 
     ~ProducerContinuation() {
-      if (continuation_) {
-        continuation_(nullptr, trace_id_);
+      if (pipeline_) {
+        pipeline_->ProducerCommit(nullptr, trace_id_, if_empty_);
         TRACE_EVENT_ASYNC_END0("flutter", "PipelineProduce", trace_id_);
         // The continuation is being dropped on the floor. End the flow.
         TRACE_FLOW_END("flutter", "PipelineItem", trace_id_);
@@ -62,26 +81,28 @@ class Pipeline {
 
     [[nodiscard]] bool Complete(ResourcePtr resource) {
       bool result = false;
-      if (continuation_) {
-        result = continuation_(std::move(resource), trace_id_);
-        continuation_ = nullptr;
+      if (pipeline_) {
+        result = pipeline_->ProducerCommit(std::move(resource), trace_id_,
+                                           if_empty_);
+        pipeline_ = nullptr;
         TRACE_EVENT_ASYNC_END0("flutter", "PipelineProduce", trace_id_);
         TRACE_FLOW_STEP("flutter", "PipelineItem", trace_id_);
       }
       return result;
     }
 
-    operator bool() const { return continuation_ != nullptr; }
+    operator bool() const { return pipeline_ != nullptr; }
 
    private:
     friend class Pipeline;
-    using Continuation = std::function<bool(ResourcePtr, size_t)>;
 
-    Continuation continuation_;
+    Pipeline* pipeline_;
+    // Whether the resource is only committed if the pipeline is empty.
+    bool if_empty_ = false;
     size_t trace_id_;
 
-    ProducerContinuation(const Continuation& continuation, size_t trace_id)
-        : continuation_(continuation), trace_id_(trace_id) {
+    ProducerContinuation(Pipeline* pipeline, bool if_empty, size_t trace_id)
+        : pipeline_(pipeline), if_empty_(if_empty), trace_id_(trace_id) {
       TRACE_FLOW_BEGIN("flutter", "PipelineItem", trace_id_);
       TRACE_EVENT_ASYNC_BEGIN0("flutter", "PipelineItem", trace_id_);
       TRACE_EVENT_ASYNC_BEGIN0("flutter", "PipelineProduce", trace_id_);
@@ -90,27 +111,33 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth) : Pipeline(depth, depth) {}
+
+  Pipeline(uint32_t depth, uint32_t max_depth)
+      : min_depth_(std::max(depth, 1u)),
+        max_depth_(std::max(max_depth, min_depth_)),
+        slots_(new Slot[max_depth_]),
+        depth_(min_depth_),
+        inflight_(0),
+        write_position_(0),
+        read_position_(0) {
+    for (uint32_t i = 0; i < max_depth_; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
 
   ~Pipeline() = default;
 
-  bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
+  bool IsValid() const { return slots_ != nullptr; }
+
+  /// The number of resources that may currently be in flight.
+  uint32_t GetDepth() const { return depth_.load(std::memory_order_relaxed); }
 
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!Reserve()) {
       return {};
     }
-    ++inflight_;
-    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
-                      reinterpret_cast<int64_t>(this),      //
-                      "frames in flight", inflight_.load()  //
-    );
-
-    return ProducerContinuation{
-        std::bind(&Pipeline::ProducerCommit, this, std::placeholders::_1,
-                  std::placeholders::_2),  // continuation
-        GetNextPipelineTraceID()};         // trace id
+    return ProducerContinuation{this, false, GetNextPipelineTraceID()};
   }
 
   // Create a `ProducerContinuation` that will only push the task if the queue
@@ -118,19 +145,10 @@ class Pipeline {
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!Reserve()) {
       return {};
     }
-    ++inflight_;
-    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
-                      reinterpret_cast<int64_t>(this),      //
-                      "frames in flight", inflight_.load()  //
-    );
-
-    return ProducerContinuation{
-        std::bind(&Pipeline::ProducerCommitIfEmpty, this, std::placeholders::_1,
-                  std::placeholders::_2),  // continuation
-        GetNextPipelineTraceID()};         // trace id
+    return ProducerContinuation{this, true, GetNextPipelineTraceID()};
   }
 
   using Consumer = std::function<void(ResourcePtr)>;
@@ -141,28 +159,30 @@ class Pipeline {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    if (!available_.TryWait()) {
+    // Only the consumer moves the read position.
+    const size_t position = read_position_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[position % max_depth_];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      // Empty, or the producer that reserved the slot hasn't filled it yet.
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    ResourcePtr resource;
-    size_t trace_id = 0;
-    size_t items_count = 0;
-
-    {
-      std::scoped_lock lock(queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
-      queue_.pop_front();
-      items_count = queue_.size();
-    }
+    ResourcePtr resource = std::move(slot.resource);
+    const size_t trace_id = slot.trace_id;
+    // Hand the slot back to the producer for the next lap of the ring.
+    slot.sequence.store(position + max_depth_, std::memory_order_release);
+    read_position_.store(position + 1, std::memory_order_release);
+    const size_t items_count =
+        write_position_.load(std::memory_order_acquire) - (position + 1);
 
     {
       TRACE_EVENT0("flutter", "PipelineConsume");
       consumer(std::move(resource));
     }
 
-    empty_.Signal();
-    --inflight_;
+    const uint32_t inflight =
+        inflight_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    MaybeShrink(inflight);
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
     TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
@@ -172,38 +192,88 @@ class Pipeline {
   }
 
  private:
-  const uint32_t depth_;
-  fml::Semaphore empty_;
-  fml::Semaphore available_;
-  std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
-
-  bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      queue_.emplace_back(std::move(resource), trace_id);
-    }
+  struct Slot {
+    // The position of the resource in this slot plus one once it has been
+    // committed, or the position that may be committed to it next.
+    std::atomic<size_t> sequence;
+    ResourcePtr resource;
+    size_t trace_id = 0;
+  };
 
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+  const uint32_t min_depth_;
+  const uint32_t max_depth_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint32_t> depth_;
+  // The number of reserved spots, committed or not, that haven't been
+  // consumed yet.
+  std::atomic<uint32_t> inflight_;
+  std::atomic<size_t> write_position_;
+  std::atomic<size_t> read_position_;
+  // Only accessed by the consumer.
+  uint32_t frames_below_depth_ = 0;
+
+  // Reserves a spot for a resource, growing an adaptive pipeline if it is
+  // full.
+  bool Reserve() {
+    uint32_t inflight = inflight_.load(std::memory_order_relaxed);
+    uint32_t depth;
+    do {
+      depth = depth_.load(std::memory_order_relaxed);
+      if (inflight >= depth) {
+        if (depth < max_depth_) {
+          // The consumer is falling behind. Give it more room from the next
+          // frame on.
+          depth_.compare_exchange_strong(depth, depth + 1,
+                                         std::memory_order_relaxed);
+        }
+        return false;
+      }
+    } while (!inflight_.compare_exchange_weak(inflight, inflight + 1,
+                                              std::memory_order_acq_rel));
+    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
+                      reinterpret_cast<int64_t>(this),   //
+                      "frames in flight", inflight + 1,  //
+                      "depth", depth                     //
+    );
     return true;
   }
 
-  bool ProducerCommitIfEmpty(ResourcePtr resource, size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      if (!queue_.empty()) {
+  void MaybeShrink(uint32_t inflight) {
+    const uint32_t depth = depth_.load(std::memory_order_relaxed);
+    if (depth == min_depth_ || inflight + 1 >= depth) {
+      frames_below_depth_ = 0;
+      return;
+    }
+    if (++frames_below_depth_ >= kDepthDecayFrames) {
+      frames_below_depth_ = 0;
+      uint32_t expected = depth;
+      depth_.compare_exchange_strong(expected, depth - 1,
+                                     std::memory_order_relaxed);
+    }
+  }
+
+  bool ProducerCommit(ResourcePtr resource, size_t trace_id, bool if_empty) {
+    size_t position = write_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (if_empty &&
+          position != read_position_.load(std::memory_order_acquire)) {
         // Bail if the queue is not empty, opens up spaces to produce other
         // frames.
-        empty_.Signal();
+        inflight_.fetch_sub(1, std::memory_order_acq_rel);
         return false;
       }
-      queue_.emplace_back(std::move(resource), trace_id);
+      if (write_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_acq_rel)) {
+        break;
+      }
     }
 
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+    // Reserving a spot guarantees that the slot has been consumed.
+    Slot& slot = slots_[position % max_depth_];
+    FML_DCHECK(slot.sequence.load(std::memory_order_acquire) == position);
+    slot.resource = std::move(resource);
+    slot.trace_id = trace_id;
+    slot.sequence.store(position + 1, std::memory_order_release);
     return true;
   }
 
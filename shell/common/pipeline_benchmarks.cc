@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline.h"
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/semaphore.h"
+
+namespace flutter {
+
+namespace {
+
+// The pipeline as it was before it used a ring buffer: two semaphores, a
+// locked deque and a std::function continuation per resource. Kept to
+// compare against.
+class MutexPipeline {
+ public:
+  using ResourcePtr = std::unique_ptr<int>;
+  using Continuation = std::function<bool(ResourcePtr, size_t)>;
+
+  explicit MutexPipeline(uint32_t depth) : empty_(depth), available_(0) {}
+
+  Continuation Produce() {
+    if (!empty_.TryWait()) {
+      return nullptr;
+    }
+    return std::bind(&MutexPipeline::ProducerCommit, this,
+                     std::placeholders::_1, std::placeholders::_2);
+  }
+
+  bool Consume(const std::function<void(ResourcePtr)>& consumer) {
+    if (!available_.TryWait()) {
+      return false;
+    }
+    ResourcePtr resource;
+    {
+      std::scoped_lock lock(queue_mutex_);
+      resource = std::move(queue_.front().first);
+      queue_.pop_front();
+    }
+    consumer(std::move(resource));
+    empty_.Signal();
+    return true;
+  }
+
+ private:
+  fml::Semaphore empty_;
+  fml::Semaphore available_;
+  std::mutex queue_mutex_;
+  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+
+  bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
+    {
+      std::scoped_lock lock(queue_mutex_);
+      queue_.emplace_back(std::move(resource), trace_id);
+    }
+    available_.Signal();
+    return true;
+  }
+};
+
+constexpr int kItemCount = 1000;
+
+}  // namespace
+
+// Hands resources over one at a time on the same thread, which measures the
+// overhead of the handoff itself.
+static void BM_PipelineHandoff(benchmark::State& state) {
+  Pipeline<int> pipeline(2);
+  auto consumer = [](std::unique_ptr<int> resource) {
+    benchmark::DoNotOptimize(resource);
+  };
+  while (state.KeepRunning()) {
+    auto continuation = pipeline.Produce();
+    bool result = continuation.Complete(std::make_unique<int>(0));
+    benchmark::DoNotOptimize(result);
+    auto consume_result = pipeline.Consume(consumer);
+    benchmark::DoNotOptimize(consume_result);
+  }
+}
+BENCHMARK(BM_PipelineHandoff);
+
+static void BM_MutexPipelineHandoff(benchmark::State& state) {
+  MutexPipeline pipeline(2);
+  auto consumer = [](std::unique_ptr<int> resource) {
+    benchmark::DoNotOptimize(resource);
+  };
+  while (state.KeepRunning()) {
+    auto continuation = pipeline.Produce();
+    bool result = continuation(std::make_unique<int>(0), 0);
+    benchmark::DoNotOptimize(result);
+    result = pipeline.Consume(consumer);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_MutexPipelineHandoff);
+
+// Passes |kItemCount| resources from a producer thread to a consumer thread
+// that both yield while the pipeline is full or empty.
+static void BM_PipelineProducerConsumer(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    Pipeline<int> pipeline(2);
+    std::thread producer([&pipeline]() {
+      for (int i = 0; i < kItemCount;) {
+        auto continuation = pipeline.Produce();
+        if (continuation) {
+          bool result = continuation.Complete(std::make_unique<int>(i++));
+          benchmark::DoNotOptimize(result);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for (int consumed = 0; consumed < kItemCount;) {
+      auto consume_result = pipeline.Consume(
+          [&consumed](std::unique_ptr<int> resource) { consumed++; });
+      if (consume_result == PipelineConsumeResult::NoneAvailable) {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * kItemCount);
+}
+BENCHMARK(BM_PipelineProducerConsumer)->UseRealTime();
+
+static void BM_MutexPipelineProducerConsumer(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    MutexPipeline pipeline(2);
+    std::thread producer([&pipeline]() {
+      for (int i = 0; i < kItemCount;) {
+        auto continuation = pipeline.Produce();
+        if (continuation) {
+          bool result = continuation(std::make_unique<int>(i++), 0);
+          benchmark::DoNotOptimize(result);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for (int consumed = 0; consumed < kItemCount;) {
+      if (!pipeline.Consume(
+              [&consumed](std::unique_ptr<int> resource) { consumed++; })) {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * kItemCount);
+}
+BENCHMARK(BM_MutexPipelineProducerConsumer)->UseRealTime();
+
+}  // namespace flutter
@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -131,5 +132,99 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DroppedContinuationCommitsNull) {
+  const int depth = 1;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  { Continuation continuation = pipeline->Produce(); }
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(v, nullptr); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+
+  // The spot was given back.
+  Continuation continuation = pipeline->Produce();
+  ASSERT_TRUE(continuation);
+}
+
+TEST(PipelineTest, AdaptiveDepthGrowsWhenFull) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(1, 3);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  // The pipeline is full, which grows it for the next attempt.
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->GetDepth(), 2u);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+  ASSERT_TRUE(continuation_3.Complete(std::make_unique<int>(3)));
+  for (int i = 1; i <= 3; i++) {
+    PipelineConsumeResult consume_result = pipeline->Consume(
+        [i](std::unique_ptr<int> v) { ASSERT_EQ(*v, i); });
+    ASSERT_EQ(consume_result, i < 3 ? PipelineConsumeResult::MoreAvailable
+                                    : PipelineConsumeResult::Done);
+  }
+}
+
+TEST(PipelineTest, AdaptiveDepthShrinksWhenTheConsumerKeepsUp) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(1, 2);
+  Continuation continuation = pipeline->Produce();
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->GetDepth(), 2u);
+  ASSERT_TRUE(continuation.Complete(std::make_unique<int>(0)));
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::Done);
+
+  // The consumer has kept up once already.
+  for (uint32_t i = 1; i < IntPipeline::kDepthDecayFrames; i++) {
+    ASSERT_EQ(pipeline->GetDepth(), 2u);
+    ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(i)));
+    ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+              PipelineConsumeResult::Done);
+  }
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+}
+
+TEST(PipelineTest, ConsumesInOrderAcrossThreads) {
+  const int count = 10000;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2, 3);
+
+  std::thread producer([pipeline]() {
+    for (int i = 0; i < count;) {
+      Continuation continuation = pipeline->Produce();
+      if (!continuation) {
+        std::this_thread::yield();
+        continue;
+      }
+      ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i++)));
+    }
+  });
+
+  int expected = 0;
+  while (expected < count) {
+    PipelineConsumeResult consume_result =
+        pipeline->Consume([&expected](std::unique_ptr<int> v) {
+          ASSERT_EQ(*v, expected);
+          expected++;
+        });
+    if (consume_result == PipelineConsumeResult::NoneAvailable) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -524,7 +524,10 @@ class PlatformView {
   ///             context previously obtained via a call to
   ///             `CreateResourceContext()` is being collected. The embedder is
   ///             free to collect an platform specific resources associated with
-  ///             this context.
+  ///             this context. It is only called on the platform view that
+  ///             created the context, and only if it wasn't `nullptr`. When
+  ///             spawned shells share the context, the platform view is kept
+  ///             alive for this call after its own shell is destroyed.
   ///
   /// @attention  Unlike all other methods on the platform view, this will be
   ///             called on IO task runner.
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <cstring>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,16 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate,
+    fml::TimeDelta prediction_window,
+    fml::TimeDelta sampling_offset)
+    : DefaultPointerDataDispatcher(delegate),
+      prediction_window_us_(prediction_window.ToMicroseconds()),
+      sampling_offset_us_(sampling_offset.ToMicroseconds()),
+      weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +80,216 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+namespace {
+
+constexpr size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
+
+bool IsResampled(const PointerData& data) {
+  return data.change == PointerData::Change::kMove &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+// Returns the position of the pointer at |time| from its samples.
+PointerData Resample(const std::deque<PointerData>& samples,
+                     int64_t time,
+                     int64_t prediction_window_us) {
+  FML_DCHECK(!samples.empty());
+  if (time <= samples.front().time_stamp) {
+    return samples.front();
+  }
+
+  // Extrapolate from the two newest samples, or interpolate between the two
+  // samples around |time|.
+  size_t next = 1;
+  while (next < samples.size() - 1 && samples[next].time_stamp <= time) {
+    next++;
+  }
+  const PointerData& newest = samples.back();
+  if (time >= newest.time_stamp) {
+    if (samples.size() < 2 ||
+        time - newest.time_stamp > prediction_window_us) {
+      return newest;
+    }
+    next = samples.size() - 1;
+  }
+  const PointerData& a = samples[next - 1];
+  const PointerData& b = samples[next];
+  PointerData result = time < b.time_stamp ? a : b;
+  const int64_t span = b.time_stamp - a.time_stamp;
+  if (span > 0) {
+    const double t = static_cast<double>(time - a.time_stamp) / span;
+    result.physical_x = a.physical_x + (b.physical_x - a.physical_x) * t;
+    result.physical_y = a.physical_y + (b.physical_y - a.physical_y) * t;
+  }
+  result.time_stamp = time;
+  return result;
+}
+
+}  // namespace
+
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const std::vector<uint8_t>& buffer = packet->data();
+  std::vector<PointerData> data;
+  bool buffered = false;
+  for (size_t offset = 0; offset + kBytesPerPointerData <= buffer.size();
+       offset += kBytesPerPointerData) {
+    PointerData pointer_data;
+    memcpy(&pointer_data, &buffer[offset], sizeof(PointerData));
+    PointerSamples& pointer = pointers_[pointer_data.device];
+    if (IsResampled(pointer_data)) {
+      auto it = pointer.samples.end();
+      while (it != pointer.samples.begin() &&
+             (it - 1)->time_stamp > pointer_data.time_stamp) {
+        --it;
+      }
+      pointer.samples.insert(it, pointer_data);
+      if (pointer.samples.size() > kMaxSamples) {
+        pointer.samples.pop_front();
+      }
+      buffered = true;
+      continue;
+    }
+
+    FlushSamples(pointer, data);
+    data.push_back(pointer_data);
+    if (pointer_data.change == PointerData::Change::kUp ||
+        pointer_data.change == PointerData::Change::kCancel ||
+        pointer_data.change == PointerData::Change::kRemove) {
+      pointers_.erase(pointer_data.device);
+    } else {
+      pointer.has_dispatched = true;
+      pointer.dispatched_x = pointer_data.physical_x;
+      pointer.dispatched_y = pointer_data.physical_y;
+    }
+  }
+
+  if (!data.empty()) {
+    Dispatch(data, trace_flow_id);
+  } else if (buffered) {
+    pending_trace_flow_ids_.push_back(trace_flow_id);
+  }
+  if (buffered) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_vsync_scheduled_) {
+    return;
+  }
+  is_vsync_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->is_vsync_scheduled_ = false;
+          dispatcher->DispatchResampledMoves();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchResampledMoves() {
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchResampledMoves");
+  const int64_t time =
+      delegate_.GetLastVsyncTargetTime().ToEpochDelta().ToMicroseconds() -
+      sampling_offset_us_;
+
+  std::vector<PointerData> data;
+  bool has_samples = false;
+  for (auto& entry : pointers_) {
+    PointerSamples& pointer = entry.second;
+    std::deque<PointerData>& samples = pointer.samples;
+    if (samples.empty()) {
+      continue;
+    }
+    if (samples.front().time_stamp - time > kMaxClockSkew.ToMicroseconds()) {
+      // The samples are not on the clock of the vsync and would never be
+      // reached by the sample time.
+      FlushSamples(pointer, data);
+      continue;
+    }
+    PointerData sample = Resample(samples, time, prediction_window_us_);
+    if (time - samples.back().time_stamp > prediction_window_us_) {
+      // The pointer stopped at the newest sample, which |sample| is.
+      samples.clear();
+    } else {
+      // Keep the sample right before |time| to interpolate from.
+      while (samples.size() > 1 && samples[1].time_stamp <= time) {
+        samples.pop_front();
+      }
+      has_samples = true;
+    }
+    if (!pointer.has_dispatched || sample.physical_x != pointer.dispatched_x ||
+        sample.physical_y != pointer.dispatched_y) {
+      AppendMove(pointer, sample, data);
+    }
+  }
+
+  if (!pending_trace_flow_ids_.empty()) {
+    const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+    pending_trace_flow_ids_.pop_back();
+    // The moves of the other packets are merged into this one.
+    for (uint64_t merged_trace_flow_id : pending_trace_flow_ids_) {
+      TRACE_FLOW_END("flutter", "PointerEvent", merged_trace_flow_id);
+    }
+    pending_trace_flow_ids_.clear();
+    if (data.empty()) {
+      TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
+    } else {
+      Dispatch(data, trace_flow_id);
+    }
+  } else if (!data.empty()) {
+    Dispatch(data, fml::tracing::TraceNonce());
+  }
+
+  if (has_samples) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void ResamplingPointerDataDispatcher::FlushSamples(
+    PointerSamples& pointer,
+    std::vector<PointerData>& data) {
+  if (pointer.samples.empty()) {
+    return;
+  }
+  const PointerData& newest = pointer.samples.back();
+  if (!pointer.has_dispatched || newest.physical_x != pointer.dispatched_x ||
+      newest.physical_y != pointer.dispatched_y) {
+    AppendMove(pointer, newest, data);
+  }
+  pointer.samples.clear();
+}
+
+void ResamplingPointerDataDispatcher::AppendMove(
+    PointerSamples& pointer,
+    PointerData sample,
+    std::vector<PointerData>& data) {
+  if (pointer.has_dispatched) {
+    sample.physical_delta_x = sample.physical_x - pointer.dispatched_x;
+    sample.physical_delta_y = sample.physical_y - pointer.dispatched_y;
+  }
+  pointer.has_dispatched = true;
+  pointer.dispatched_x = sample.physical_x;
+  pointer.dispatched_y = sample.physical_y;
+  data.push_back(sample);
+}
+
+void ResamplingPointerDataDispatcher::Dispatch(
+    const std::vector<PointerData>& data,
+    uint64_t trace_flow_id) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
 }  // namespace flutter
@@ -5,6 +5,12 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -64,6 +70,15 @@ class PointerDataDispatcher {
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
         const fml::closure& callback) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief    The target time of the frame for the last vsync, that is the
+    ///           time at which it is expected to be presented.
+    ///
+    ///           Called from a secondary vsync callback, this is the target
+    ///           time of the vsync that the callback is run for. This is used
+    ///           by `ResamplingPointerDataDispatcher`.
+    virtual fml::TimePoint GetLastVsyncTargetTime() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -164,6 +179,105 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that resamples the moves of each pointer once per frame, so
+/// that the framework receives one evenly timed sample per pointer and frame no
+/// matter how fast or how regularly the platform samples the input.
+///
+/// It works as follows:
+///
+/// The moves of each device are held back in a buffer rather than dispatched.
+/// At every vsync, the position of each device at the sample time of the
+/// frame is interpolated between the buffered samples around it and
+/// dispatched as a single move, with its delta computed from the last
+/// position that was dispatched for the device. Samples that are older than
+/// the one right before the sample time are dropped.
+///
+/// The sample time is the target time of the frame minus the sampling offset.
+/// The newest sample can't be later than the vsync, which comes a frame period
+/// before the target time, so the offset has to cover a frame period for the
+/// position to be interpolated between real samples rather than extrapolated.
+///
+/// If the sample time is past the newest sample, the position is extrapolated
+/// from the velocity of the two newest samples, as long as the sample time is
+/// within the prediction window of the newest sample. Past that, the pointer
+/// is assumed to have stopped and the newest sample is dispatched as is, which
+/// also ends the resampling of the device until it moves again.
+///
+/// Any other event of a device, such as a down, up or hover, is dispatched
+/// right away. Its buffered moves are flushed first by dispatching the newest
+/// one, so that the event is not reported before a move that preceded it.
+///
+/// The time stamps of the pointer data are assumed to be in microseconds on
+/// the same clock as `fml::TimePoint`, which is the case for the monotonic
+/// clocks that the embedders use. If the buffered samples of a device are
+/// more than `kMaxClockSkew` ahead of the sample time, the clocks are taken to
+/// disagree and the newest sample is dispatched as is instead. At most
+/// `kMaxSamples` samples are buffered per device, dropping the oldest ones.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  static constexpr fml::TimeDelta kDefaultPredictionWindow =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  // A 60Hz frame period, plus the 5ms that Android resamples its own input
+  // events behind the start of the frame.
+  static constexpr fml::TimeDelta kDefaultSamplingOffset =
+      fml::TimeDelta::FromMicroseconds(21667);
+
+  static constexpr fml::TimeDelta kMaxClockSkew =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  static constexpr size_t kMaxSamples = 16;
+
+  ResamplingPointerDataDispatcher(
+      Delegate& delegate,
+      fml::TimeDelta prediction_window = kDefaultPredictionWindow,
+      fml::TimeDelta sampling_offset = kDefaultSamplingOffset);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  struct PointerSamples {
+    // Buffered moves ordered by time stamp.
+    std::deque<PointerData> samples;
+    // The position that was last dispatched for the device.
+    bool has_dispatched = false;
+    double dispatched_x = 0;
+    double dispatched_y = 0;
+  };
+
+  const int64_t prediction_window_us_;
+  const int64_t sampling_offset_us_;
+  // The buffered samples of each device.
+  std::map<int64_t, PointerSamples> pointers_;
+  // The trace flow ids of the packets that only contained buffered moves.
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_vsync_scheduled_ = false;
+
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+
+  void ScheduleSecondaryVsyncCallback();
+
+  void DispatchResampledMoves();
+
+  // Appends the newest buffered move of a device to |data| if it hasn't been
+  // dispatched, and drops the buffered moves.
+  void FlushSamples(PointerSamples& pointer, std::vector<PointerData>& data);
+
+  // Appends |sample| to |data| as a move from the last dispatched position.
+  static void AppendMove(PointerSamples& pointer,
+                         PointerData sample,
+                         std::vector<PointerData>& data);
+
+  void Dispatch(const std::vector<PointerData>& data, uint64_t trace_flow_id);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,278 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+constexpr size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
+
+// A frame presented this long after a time resamples the pointers at it.
+constexpr int64_t kSamplingOffsetUs =
+    ResamplingPointerDataDispatcher::kDefaultSamplingOffset.ToMicroseconds();
+
+// Records the dispatched pointer data and runs the secondary vsync callback
+// when told to.
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    const std::vector<uint8_t>& buffer = packet->data();
+    for (size_t offset = 0; offset < buffer.size();
+         offset += kBytesPerPointerData) {
+      PointerData data;
+      memcpy(&data, &buffer[offset], sizeof(PointerData));
+      dispatched.push_back(data);
+    }
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  fml::TimePoint GetLastVsyncTargetTime() override {
+    return fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromMicroseconds(target_time_us));
+  }
+
+  // Fires the scheduled vsync callback for a frame presented at |time_us|.
+  void Vsync(int64_t time_us) {
+    target_time_us = time_us;
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<PointerData> dispatched;
+  fml::closure vsync_callback;
+  int64_t target_time_us = 0;
+};
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t time_us,
+                              double x,
+                              double y,
+                              int64_t device = 0) {
+  PointerData data;
+  memset(&data, 0, sizeof(PointerData));
+  data.time_stamp = time_us;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  return data;
+}
+
+void DispatchPointerData(PointerDataDispatcher& dispatcher,
+                         const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  dispatcher.DispatchPacket(std::move(packet), 0);
+}
+
+}  // namespace
+
+TEST(ResamplingPointerDataDispatcherTest, DispatchesDownsRightAway) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 1, 2)});
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].change, PointerData::Change::kDown);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, InterpolatesMovesAtTheSampleTime) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  // Moves sampled at 240Hz.
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kMove, 4000, 40, 0)});
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kMove, 8000, 80, 0)});
+  DispatchPointerData(
+      dispatcher,
+      {CreatePointerData(PointerData::Change::kMove, 12000, 120, 0)});
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+
+  delegate.Vsync(kSamplingOffsetUs + 10000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  const PointerData& move = delegate.dispatched[1];
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, 10000);
+  EXPECT_DOUBLE_EQ(move.physical_x, 100);
+  EXPECT_DOUBLE_EQ(move.physical_delta_x, 100);
+}
+
+TEST(ResamplingPointerDataDispatcherTest,
+     InterpolatesBetweenSamplesDeliveredUntilTheVsync) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  // Touch samples at 120Hz on a 60Hz display. Each vsync comes after the
+  // samples up to it, and its frame is presented one period later.
+  constexpr int64_t kFramePeriodUs = 16667;
+  constexpr int64_t kSamplePeriodUs = 8333;
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  int64_t sample_time = 0;
+  double last_x = 0;
+  for (int64_t vsync_time = 5 * kFramePeriodUs;
+       vsync_time <= 10 * kFramePeriodUs; vsync_time += kFramePeriodUs) {
+    double newest_x = 0;
+    while (sample_time + kSamplePeriodUs <= vsync_time) {
+      sample_time += kSamplePeriodUs;
+      newest_x = sample_time / 100.0;
+      DispatchPointerData(dispatcher,
+                          {CreatePointerData(PointerData::Change::kMove,
+                                             sample_time, newest_x, 0)});
+    }
+    const size_t dispatched = delegate.dispatched.size();
+    ASSERT_TRUE(delegate.vsync_callback);
+    delegate.Vsync(vsync_time + kFramePeriodUs);
+    ASSERT_EQ(delegate.dispatched.size(), dispatched + 1);
+
+    // The pointer moves at a constant speed, so the position between any two
+    // samples is exact.
+    const PointerData& move = delegate.dispatched.back();
+    const int64_t resample_time =
+        vsync_time + kFramePeriodUs - kSamplingOffsetUs;
+    EXPECT_EQ(move.time_stamp, resample_time);
+    EXPECT_NEAR(move.physical_x, resample_time / 100.0, 1e-6);
+    EXPECT_LT(move.physical_x, newest_x);
+    EXPECT_GT(move.physical_x, last_x);
+    last_x = move.physical_x;
+  }
+}
+
+TEST(ResamplingPointerDataDispatcherTest,
+     ExtrapolatesWithinThePredictionWindow) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(
+      delegate, fml::TimeDelta::FromMilliseconds(8));
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kMove, 4000, 40, 0),
+                   CreatePointerData(PointerData::Change::kMove, 8000, 80, 0)});
+
+  delegate.Vsync(kSamplingOffsetUs + 12000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, 120);
+
+  // Past the prediction window, the pointer is assumed to have stopped at
+  // its last sample.
+  ASSERT_TRUE(delegate.vsync_callback);
+  delegate.Vsync(kSamplingOffsetUs + 28000);
+  ASSERT_EQ(delegate.dispatched.size(), 3u);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[2].physical_x, 80);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[2].physical_delta_x, -40);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, FlushesMovesBeforeOtherEvents) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kMove, 4000, 40, 0)});
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kUp, 5000, 40, 0)});
+
+  ASSERT_EQ(delegate.dispatched.size(), 3u);
+  EXPECT_EQ(delegate.dispatched[1].change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, 40);
+  EXPECT_EQ(delegate.dispatched[2].change, PointerData::Change::kUp);
+
+  // Nothing is left to resample.
+  delegate.Vsync(kSamplingOffsetUs + 10000);
+  EXPECT_EQ(delegate.dispatched.size(), 3u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, ResamplesEachPointer) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(
+      dispatcher, {CreatePointerData(PointerData::Change::kDown, 0, 0, 0, 1),
+                   CreatePointerData(PointerData::Change::kDown, 0, 0, 0, 2)});
+  DispatchPointerData(
+      dispatcher,
+      {CreatePointerData(PointerData::Change::kMove, 4000, 0, 40, 1),
+       CreatePointerData(PointerData::Change::kMove, 4000, 0, -40, 2),
+       CreatePointerData(PointerData::Change::kMove, 8000, 0, 80, 1),
+       CreatePointerData(PointerData::Change::kMove, 8000, 0, -80, 2)});
+
+  delegate.Vsync(kSamplingOffsetUs + 6000);
+  ASSERT_EQ(delegate.dispatched.size(), 4u);
+  EXPECT_EQ(delegate.dispatched[2].device, 1);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[2].physical_y, 60);
+  EXPECT_EQ(delegate.dispatched[3].device, 2);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[3].physical_y, -60);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, FlushesSamplesOnClockSkew) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  // The time stamps are on a clock that is 10 seconds ahead of the vsync.
+  DispatchPointerData(
+      dispatcher,
+      {CreatePointerData(PointerData::Change::kMove, 10004000, 40, 0),
+       CreatePointerData(PointerData::Change::kMove, 10008000, 80, 0)});
+
+  delegate.Vsync(kSamplingOffsetUs + 10000);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, 80);
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_delta_x, 80);
+  // Nothing is left buffered.
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, LimitsBufferedSamples) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+
+  DispatchPointerData(dispatcher,
+                      {CreatePointerData(PointerData::Change::kDown, 0, 0, 0)});
+  const size_t move_count = ResamplingPointerDataDispatcher::kMaxSamples + 4;
+  for (size_t i = 1; i <= move_count; i++) {
+    DispatchPointerData(dispatcher, {CreatePointerData(
+                                        PointerData::Change::kMove, i * 1000,
+                                        static_cast<double>(i), 0)});
+  }
+
+  // The sample time is before all samples, so the oldest buffered one is
+  // dispatched, and the ones before it were dropped.
+  delegate.Vsync(kSamplingOffsetUs);
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  const size_t oldest_kept =
+      move_count - ResamplingPointerDataDispatcher::kMaxSamples + 1;
+  EXPECT_DOUBLE_EQ(delegate.dispatched[1].physical_x, oldest_kept);
+}
+
+}  // namespace testing
+}  // namespace flutter
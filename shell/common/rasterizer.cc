@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "flow/frame_timings.h"
@@ -17,6 +18,7 @@
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRegion.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/core/SkSurfaceCharacterization.h"
@@ -117,6 +119,10 @@ void Rasterizer::NotifyLowMemoryWarning() const {
         << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
     return;
   }
+  // The cached shadows are raster images, so they are released with or
+  // without a GrContext. Releasing them first also lets the cleanup below
+  // purge the textures they were uploaded to.
+  compositor_context_->shadow_cache().Clear();
   auto context = surface_->GetContext();
   if (!context) {
     FML_DLOG(INFO)
@@ -481,6 +487,32 @@ RasterStatus Rasterizer::DrawToSurface(
   auto root_surface_canvas =
       embedder_root_canvas ? embedder_root_canvas : frame->SkiaCanvas();
 
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+  // Surfaces that still hold the previous frame only need the parts of the
+  // frame that changed since then to be repainted. Backdrop blurs also need
+  // the diff to tell whether the backdrop they filtered last frame changed,
+  // so trees following one with a reusable backdrop are diffed on every
+  // surface.
+  std::optional<SkAutoCanvasRestore> damage_clip;
+  const bool partial_repaint = frame->supports_partial_repaint() &&
+                               !external_view_embedder_ && root_surface_canvas;
+  const bool reusable_backdrop = !external_view_embedder_ &&
+                                 last_layer_tree_ &&
+                                 last_layer_tree_->has_reusable_backdrop();
+  if (partial_repaint || reusable_backdrop) {
+    auto damage = layer_tree.ComputeDamage(last_layer_tree_.get());
+    if (partial_repaint) {
+      SkRegion damage_region;
+      for (const auto& rect : damage.buffer_damage_rects) {
+        damage_region.op(rect, SkRegion::kUnion_Op);
+      }
+      damage_clip.emplace(root_surface_canvas, true);
+      root_surface_canvas->clipRegion(damage_region);
+      frame->set_damage(std::move(damage.frame_damage_rects));
+    }
+  }
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
+
   auto compositor_frame = compositor_context_->AcquireFrame(
       surface_->GetContext(),         // skia GrContext
       root_surface_canvas,            // root surface canvas
@@ -519,6 +551,11 @@ RasterStatus Rasterizer::DrawToSurface(
     }
 
     frame_timings_recorder.RecordRasterEnd();
+    compositor_context_->frame_statistics()->RecordFrame(
+        frame_timings_recorder,
+        compositor_context_->raster_cache().GetRasterizeTimeThisFrame(),
+        compositor_frame->layer_paint_times(),
+        fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
     FireNextFrameCallbackIfPresent();
 
     if (surface_->GetContext()) {
@@ -138,8 +138,9 @@ class Rasterizer final : public SnapshotDelegate {
   //----------------------------------------------------------------------------
   /// @brief      Notifies the rasterizer that there is a low memory situation
   ///             and it must purge as many unnecessary resources as possible.
-  ///             Currently, the Skia context associated with onscreen rendering
-  ///             is told to free GPU resources.
+  ///             Currently, the cached shadows are discarded and the Skia
+  ///             context associated with onscreen rendering is told to free
+  ///             GPU resources.
   ///
   void NotifyLowMemoryWarning() const;
 
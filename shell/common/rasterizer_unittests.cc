@@ -7,16 +7,23 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 
 #include "gmock/gmock.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 using testing::_;
 using testing::ByMove;
+using testing::Invoke;
 using testing::Return;
 using testing::ReturnRef;
 
@@ -70,6 +77,17 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
                     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger));
   MOCK_METHOD0(SupportsDynamicThreadMerging, bool());
 };
+
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+std::shared_ptr<PictureLayer> MakeRectPictureLayer(const SkRect& rect) {
+  SkPictureRecorder recorder;
+  recorder.beginRecording(rect)->drawRect(rect, SkPaint());
+  return std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<SkPicture>(recorder.finishRecordingAsPicture(), nullptr),
+      /*is_complex=*/false, /*will_change=*/false);
+}
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 }  // namespace
 
 TEST(RasterizerTest, create) {
@@ -78,6 +96,36 @@ TEST(RasterizerTest, create) {
   EXPECT_TRUE(rasterizer != nullptr);
 }
 
+TEST(RasterizerTest, lowMemoryWarningWithoutGrContextClearsShadowCache) {
+  MockDelegate delegate;
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+  EXPECT_CALL(*surface, GetContext()).WillRepeatedly(Return(nullptr));
+  rasterizer->Setup(std::move(surface));
+
+  ShadowCache& shadow_cache = rasterizer->compositor_context()->shadow_cache();
+  auto canvas_surface = SkSurface::MakeRasterN32Premul(200, 200);
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(30, 40, 60, 30));
+  const SkPoint3 light = SkPoint3::Make(60, -560, 1200);
+  auto draw_shadow = [&]() {
+    return shadow_cache.Draw(
+        canvas_surface->getCanvas(), path, SK_ColorBLACK, 4, false, 2, light,
+        path.getBounds().makeOutset(20, 20),
+        [](SkCanvas* canvas, const SkPoint3&) {
+          canvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+        });
+  };
+  for (int i = 0; i < ShadowCache::kAccessThreshold; i++) {
+    draw_shadow();
+  }
+  ASSERT_EQ(shadow_cache.GetCachedImageCount(), 1u);
+
+  rasterizer->NotifyLowMemoryWarning();
+  EXPECT_EQ(shadow_cache.GetCachedImageCount(), 0u);
+}
+
 static std::unique_ptr<FrameTimingsRecorder> CreateFinishedBuildRecorder() {
   std::unique_ptr<FrameTimingsRecorder> recorder =
       std::make_unique<FrameTimingsRecorder>();
@@ -322,4 +370,79 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
   });
   latch.Wait();
 }
+
+// Partial repaint follows the diff context, which is only built in debug mode.
+#ifdef FLUTTER_ENABLE_DIFF_CONTEXT
+TEST(RasterizerTest, drawToPartialRepaintSurfaceSetsFrameDamage) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(2);
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+
+  const SkISize frame_size = SkISize::Make(100, 100);
+  std::vector<std::optional<std::vector<SkIRect>>> submitted_damage;
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](const SkISize& size) {
+        auto frame = std::make_unique<SurfaceFrame>(
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            /*supports_readback=*/true,
+            /*submit_callback=*/[&](const SurfaceFrame& frame, SkCanvas*) {
+              submitted_damage.push_back(frame.damage());
+              return true;
+            });
+        frame->set_supports_partial_repaint(true);
+        return frame;
+      }));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .Times(2)
+      .WillRepeatedly(Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+
+  rasterizer->Setup(std::move(surface));
+  auto unchanged = MakeRectPictureLayer(SkRect::MakeLTRB(10, 10, 20, 20));
+  auto added = MakeRectPictureLayer(SkRect::MakeLTRB(50, 50, 60, 60));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto draw = [&](std::vector<std::shared_ptr<Layer>> layers) {
+      auto root = std::make_shared<ContainerLayer>();
+      for (auto& layer : layers) {
+        root->Add(std::move(layer));
+      }
+      auto layer_tree = std::make_unique<LayerTree>(
+          frame_size, /*device_pixel_ratio=*/1.0f);
+      layer_tree->set_root_layer(std::move(root));
+      auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+      EXPECT_TRUE(pipeline->Produce().Complete(std::move(layer_tree)));
+      auto no_discard = [](LayerTree&) { return false; };
+      rasterizer->Draw(CreateFinishedBuildRecorder(), pipeline, no_discard);
+    };
+    draw({unchanged});
+    draw({unchanged, added});
+    latch.Signal();
+  });
+  latch.Wait();
+
+  // The first frame has nothing to diff against, the second one only damages
+  // the picture that was added.
+  ASSERT_EQ(submitted_damage.size(), 2u);
+  ASSERT_TRUE(submitted_damage[0].has_value());
+  EXPECT_EQ(*submitted_damage[0],
+            std::vector<SkIRect>{SkIRect::MakeSize(frame_size)});
+  ASSERT_TRUE(submitted_damage[1].has_value());
+  EXPECT_EQ(*submitted_damage[1],
+            std::vector<SkIRect>{SkIRect::MakeLTRB(50, 50, 60, 60)});
+}
+#endif  // FLUTTER_ENABLE_DIFF_CONTEXT
 }  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/semantics_update_differ.h"
+
+#include <cmath>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+// Scroll positions and extents are NaN for nodes that don't scroll.
+bool DoublesEqual(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool StringAttributesEqual(const StringAttributes& a,
+                           const StringAttributes& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i] == b[i]) {
+      continue;
+    }
+    if (a[i]->start != b[i]->start || a[i]->end != b[i]->end ||
+        a[i]->type != b[i]->type) {
+      return false;
+    }
+    if (a[i]->type == StringAttributeType::kLocale &&
+        std::static_pointer_cast<LocaleStringAttribute>(a[i])->locale !=
+            std::static_pointer_cast<LocaleStringAttribute>(b[i])->locale) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NodesEqual(const SemanticsNode& a, const SemanticsNode& b) {
+  return a.flags == b.flags && a.actions == b.actions &&
+         a.maxValueLength == b.maxValueLength &&
+         a.currentValueLength == b.currentValueLength &&
+         a.textSelectionBase == b.textSelectionBase &&
+         a.textSelectionExtent == b.textSelectionExtent &&
+         a.platformViewId == b.platformViewId &&
+         a.scrollChildren == b.scrollChildren &&
+         a.scrollIndex == b.scrollIndex &&
+         DoublesEqual(a.scrollPosition, b.scrollPosition) &&
+         DoublesEqual(a.scrollExtentMax, b.scrollExtentMax) &&
+         DoublesEqual(a.scrollExtentMin, b.scrollExtentMin) &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.textDirection == b.textDirection && a.rect == b.rect &&
+         a.transform == b.transform && a.label == b.label &&
+         a.hint == b.hint && a.value == b.value &&
+         a.increasedValue == b.increasedValue &&
+         a.decreasedValue == b.decreasedValue &&
+         a.childrenInTraversalOrder == b.childrenInTraversalOrder &&
+         a.childrenInHitTestOrder == b.childrenInHitTestOrder &&
+         a.customAccessibilityActions == b.customAccessibilityActions &&
+         StringAttributesEqual(a.labelAttributes, b.labelAttributes) &&
+         StringAttributesEqual(a.hintAttributes, b.hintAttributes) &&
+         StringAttributesEqual(a.valueAttributes, b.valueAttributes) &&
+         StringAttributesEqual(a.increasedValueAttributes,
+                               b.increasedValueAttributes) &&
+         StringAttributesEqual(a.decreasedValueAttributes,
+                               b.decreasedValueAttributes);
+}
+
+}  // namespace
+
+SemanticsUpdateDiffer::SemanticsUpdateDiffer() = default;
+
+SemanticsUpdateDiffer::~SemanticsUpdateDiffer() = default;
+
+void SemanticsUpdateDiffer::RemoveUnchangedNodes(
+    SemanticsNodeUpdates& updates) {
+  // The children of the nodes that are sent, and the children that the
+  // changed nodes had before. Both orders list the same children, so only the
+  // traversal order is looked at.
+  std::unordered_set<int32_t> adopted;
+  std::vector<int32_t> orphaned;
+  for (auto iter = updates.begin(); iter != updates.end();) {
+    const SemanticsNode& node = iter->second;
+    auto sent = nodes_.find(iter->first);
+    if (sent != nodes_.end()) {
+      if (NodesEqual(sent->second, node)) {
+        iter = updates.erase(iter);
+        continue;
+      }
+      const std::vector<int32_t>& children =
+          sent->second.childrenInTraversalOrder;
+      orphaned.insert(orphaned.end(), children.begin(), children.end());
+      sent->second = node;
+    } else {
+      nodes_.emplace(iter->first, node);
+    }
+    adopted.insert(node.childrenInTraversalOrder.begin(),
+                   node.childrenInTraversalOrder.end());
+    ++iter;
+  }
+
+  for (int32_t id : orphaned) {
+    if (adopted.find(id) == adopted.end()) {
+      ForgetSubtree(id, adopted);
+    }
+  }
+}
+
+void SemanticsUpdateDiffer::Reset() {
+  nodes_.clear();
+}
+
+void SemanticsUpdateDiffer::ForgetSubtree(
+    int32_t id,
+    const std::unordered_set<int32_t>& adopted) {
+  std::vector<int32_t> pending = {id};
+  while (!pending.empty()) {
+    auto iter = nodes_.find(pending.back());
+    pending.pop_back();
+    if (iter == nodes_.end()) {
+      continue;
+    }
+    for (int32_t child : iter->second.childrenInTraversalOrder) {
+      // Children that were moved to a node in the same update stay.
+      if (adopted.find(child) == adopted.end()) {
+        pending.push_back(child);
+      }
+    }
+    nodes_.erase(iter);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_DIFFER_H_
+#define FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_DIFFER_H_
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Keeps a copy of the semantics tree as it was last sent to the platform, and
+/// leaves the nodes that wouldn't change it out of semantics updates.
+///
+/// The framework sends every node it marked dirty, and while a large list
+/// scrolls that includes many nodes whose semantics are the same as before.
+/// The platform converts each node it receives into its accessibility tree, so
+/// dropping those nodes on the UI thread saves work on the platform thread.
+///
+/// Nodes that are no longer reachable from the node they were last a child of
+/// are forgotten along with their subtrees, the same way the platforms remove
+/// them, so that a node that comes back is sent again.
+///
+class SemanticsUpdateDiffer {
+ public:
+  SemanticsUpdateDiffer();
+
+  ~SemanticsUpdateDiffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the nodes from |updates| that are the same as they
+  ///             were last sent, and remembers the others as sent.
+  ///
+  /// @param      updates  The update about to be sent to the platform.
+  ///
+  void RemoveUnchangedNodes(SemanticsNodeUpdates& updates);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets the sent tree, so that the next update is sent in
+  ///             full. Called whenever the platform may have discarded its
+  ///             tree, for example when semantics are enabled again.
+  ///
+  void Reset();
+
+  /// The number of nodes that the platform is known to have.
+  size_t GetNodeCount() const { return nodes_.size(); }
+
+ private:
+  std::unordered_map<int32_t, SemanticsNode> nodes_;
+
+  void ForgetSubtree(int32_t id, const std::unordered_set<int32_t>& adopted);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsUpdateDiffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_DIFFER_H_
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/semantics_update_differ.h"
+
+#include <memory>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+// Nodes are moved in and out of the updates and the differ's copy of the
+// tree, and containers only move elements that can't throw.
+static_assert(std::is_nothrow_move_constructible_v<SemanticsNode>);
+static_assert(std::is_nothrow_move_assignable_v<SemanticsNode>);
+
+SemanticsNode CreateNode(int32_t id,
+                         std::string label,
+                         std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = std::move(label);
+  node.childrenInTraversalOrder = children;
+  node.childrenInHitTestOrder = children;
+  return node;
+}
+
+void AddNode(SemanticsNodeUpdates& updates, SemanticsNode node) {
+  int32_t id = node.id;
+  updates[id] = std::move(node);
+}
+
+}  // namespace
+
+TEST(SemanticsUpdateDifferTest, SendsNewNodes) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  AddNode(updates, CreateNode(0, "root", {1, 2}));
+  AddNode(updates, CreateNode(1, "a"));
+  AddNode(updates, CreateNode(2, "b"));
+
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 3u);
+  EXPECT_EQ(differ.GetNodeCount(), 3u);
+}
+
+TEST(SemanticsUpdateDifferTest, RemovesUnchangedNodes) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  AddNode(updates, CreateNode(0, "root", {1, 2}));
+  AddNode(updates, CreateNode(1, "a"));
+  AddNode(updates, CreateNode(2, "b"));
+  differ.RemoveUnchangedNodes(updates);
+
+  updates.clear();
+  AddNode(updates, CreateNode(0, "root", {1, 2}));
+  AddNode(updates, CreateNode(1, "a"));
+  AddNode(updates, CreateNode(2, "changed"));
+  differ.RemoveUnchangedNodes(updates);
+  ASSERT_EQ(updates.size(), 1u);
+  EXPECT_EQ(updates.begin()->second.label, "changed");
+}
+
+TEST(SemanticsUpdateDifferTest, ComparesStringAttributes) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  SemanticsNode node = CreateNode(0, "root");
+  auto attribute = std::make_shared<LocaleStringAttribute>();
+  attribute->type = StringAttributeType::kLocale;
+  attribute->locale = "en-US";
+  node.labelAttributes.push_back(attribute);
+  AddNode(updates, node);
+  differ.RemoveUnchangedNodes(updates);
+
+  // An equal attribute that is a different object.
+  auto equal_attribute = std::make_shared<LocaleStringAttribute>(*attribute);
+  node.labelAttributes = {equal_attribute};
+  AddNode(updates, node);
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_TRUE(updates.empty());
+
+  auto other_attribute = std::make_shared<LocaleStringAttribute>(*attribute);
+  other_attribute->locale = "en-GB";
+  node.labelAttributes = {other_attribute};
+  AddNode(updates, node);
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 1u);
+}
+
+TEST(SemanticsUpdateDifferTest, SendsNodesAgainAfterTheyWereRemoved) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  AddNode(updates, CreateNode(0, "root", {1}));
+  AddNode(updates, CreateNode(1, "a", {2}));
+  AddNode(updates, CreateNode(2, "b"));
+  differ.RemoveUnchangedNodes(updates);
+
+  // Removes node 1 and its child from the tree.
+  updates.clear();
+  AddNode(updates, CreateNode(0, "root"));
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 1u);
+  EXPECT_EQ(differ.GetNodeCount(), 1u);
+
+  updates.clear();
+  AddNode(updates, CreateNode(0, "root", {1}));
+  AddNode(updates, CreateNode(1, "a", {2}));
+  AddNode(updates, CreateNode(2, "b"));
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 3u);
+}
+
+TEST(SemanticsUpdateDifferTest, KeepsReparentedNodes) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  AddNode(updates, CreateNode(0, "root", {1, 2}));
+  AddNode(updates, CreateNode(1, "a", {3}));
+  AddNode(updates, CreateNode(2, "b"));
+  AddNode(updates, CreateNode(3, "c"));
+  differ.RemoveUnchangedNodes(updates);
+
+  // Moves node 3 from node 1 to node 2.
+  updates.clear();
+  AddNode(updates, CreateNode(1, "a"));
+  AddNode(updates, CreateNode(2, "b", {3}));
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 2u);
+  EXPECT_EQ(differ.GetNodeCount(), 4u);
+
+  updates.clear();
+  AddNode(updates, CreateNode(3, "c"));
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_TRUE(updates.empty());
+}
+
+TEST(SemanticsUpdateDifferTest, SendsEverythingAfterReset) {
+  SemanticsUpdateDiffer differ;
+  SemanticsNodeUpdates updates;
+  AddNode(updates, CreateNode(0, "root"));
+  differ.RemoveUnchangedNodes(updates);
+
+  differ.Reset();
+  differ.RemoveUnchangedNodes(updates);
+  EXPECT_EQ(updates.size(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
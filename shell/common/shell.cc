@@ -19,6 +19,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
@@ -31,6 +32,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -39,6 +41,16 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+// Names of the phases reported by |Shell::GetStartupPhaseDurations|.
+constexpr char kSnapshotsStartupPhase[] = "Snapshots";
+constexpr char kVMStartupPhase[] = "DartVM";
+constexpr char kRasterStartupPhase[] = "Rasterizer";
+constexpr char kPlatformViewStartupPhase[] = "PlatformView";
+constexpr char kIOStartupPhase[] = "IOManager";
+constexpr char kUIStartupPhase[] = "Engine";
+constexpr char kFontManagerStartupPhase[] = "DefaultFontManager";
+constexpr char kSetupStartupPhase[] = "Setup";
+
 namespace {
 
 std::unique_ptr<Engine> CreateEngine(
@@ -100,6 +112,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.enable_trace_recorder) {
+      fml::tracing::TraceRecorder::Enable();
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -118,6 +134,29 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  if (settings.sksl_precompile_budget_ms >= 0) {
+    PersistentCache::SetPrecompileBudget(
+        fml::TimeDelta::FromMilliseconds(settings.sksl_precompile_budget_ms));
+  }
+}
+
+// Returns a callback for the IO manager to release its resource context through
+// |platform_view|, which created it. The IO manager may outlive the shell of
+// the platform view when it is shared with spawns, so the callback keeps the
+// platform view alive until it is run and then collects it on the platform
+// thread.
+fml::closure MakeResourceContextReleaser(
+    std::shared_ptr<PlatformView> platform_view,
+    fml::RefPtr<fml::TaskRunner> platform_task_runner) {
+  return [platform_view = std::move(platform_view),
+          platform_task_runner = std::move(platform_task_runner)]() mutable {
+    platform_view->ReleaseResourceContext();
+    fml::TaskRunner::RunNowOrPostTask(
+        platform_task_runner,
+        fml::MakeCopyable([platform_view = std::move(platform_view)]() mutable {
+          platform_view.reset();
+        }));
+  };
 }
 
 }  // namespace
@@ -136,25 +175,55 @@ std::unique_ptr<Shell> Shell::Create(
 
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
-  // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  // arguments are ignored, so the VM snapshot is not mapped at all. The
+  // isolate snapshot is resolved on the IO thread while the VM snapshot is
+  // mapped on this one.
+  const auto snapshots_start = fml::TimePoint::Now();
+  std::promise<fml::RefPtr<const DartSnapshot>> isolate_snapshot_promise;
+  auto isolate_snapshot_future = isolate_snapshot_promise.get_future();
+  auto resolve_isolate_snapshot = [&isolate_snapshot_promise, &settings]() {
+    TRACE_EVENT0("flutter", "Shell::IsolateSnapshotFromSettings");
+    isolate_snapshot_promise.set_value(
+        DartSnapshot::IsolateSnapshotFromSettings(settings));
+  };
+  if (auto io_task_runner = task_runners.GetIOTaskRunner()) {
+    fml::TaskRunner::RunNowOrPostTask(io_task_runner, resolve_isolate_snapshot);
+  } else {
+    resolve_isolate_snapshot();
+  }
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  if (!DartVMRef::IsInstanceRunning()) {
+    vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+  }
+  auto isolate_snapshot = isolate_snapshot_future.get();
+  const auto snapshots_duration = fml::TimePoint::Now() - snapshots_start;
+
+  const auto vm_start = fml::TimePoint::Now();
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const auto vm_duration = fml::TimePoint::Now() - vm_start;
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
   if (!isolate_snapshot) {
     isolate_snapshot = vm->GetVMData()->GetIsolateSnapshot();
   }
-  return CreateWithSnapshot(std::move(platform_data),            //
-                            std::move(task_runners),             //
-                            std::move(settings),                 //
-                            std::move(vm),                       //
-                            std::move(isolate_snapshot),         //
-                            std::move(on_create_platform_view),  //
-                            std::move(on_create_rasterizer),     //
-                            CreateEngine, is_gpu_disabled);
+  auto shell = CreateWithSnapshot(std::move(platform_data),            //
+                                  std::move(task_runners),             //
+                                  std::move(settings),                 //
+                                  std::move(vm),                       //
+                                  std::move(isolate_snapshot),         //
+                                  std::move(on_create_platform_view),  //
+                                  std::move(on_create_rasterizer),     //
+                                  CreateEngine,
+                                  std::make_shared<fml::SyncSwitch>(
+                                      is_gpu_disabled),
+                                  /*spawner_io_manager=*/nullptr);
+  if (shell) {
+    shell->RecordStartupPhase(kSnapshotsStartupPhase, snapshots_duration);
+    shell->RecordStartupPhase(kVMStartupPhase, vm_duration);
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
@@ -166,18 +235,40 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     const Shell::EngineCreateCallback& on_create_engine,
-    bool is_gpu_disabled) {
+    const std::shared_ptr<fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    std::shared_ptr<ShellIOManager> spawner_io_manager) {
   if (!task_runners.IsValid()) {
     FML_LOG(ERROR) << "Task runners to run the shell were invalid.";
     return nullptr;
   }
 
+  // Creating the default font manager scans the system fonts and doesn't
+  // depend on any other subsystem. Start it on the concurrent workers right
+  // away and install it on the UI thread once the engine is set up. Spawned
+  // engines share the font collection of their spawner, which already has
+  // one.
+  using FontManagerResult = std::pair<sk_sp<SkFontMgr>, fml::TimeDelta>;
+  std::shared_future<FontManagerResult> font_manager_future;
+  if (!spawner_io_manager) {
+    auto font_manager_promise =
+        std::make_shared<std::promise<FontManagerResult>>();
+    font_manager_future = font_manager_promise->get_future();
+    vm->GetConcurrentWorkerTaskRunner()->PostTask([font_manager_promise]() {
+      TRACE_EVENT0("flutter", "ShellSetupDefaultFontManager");
+      const auto start = fml::TimePoint::Now();
+      auto font_manager = txt::GetDefaultFontManager();
+      font_manager_promise->set_value(
+          {std::move(font_manager), fml::TimePoint::Now() - start});
+    });
+  }
+
   auto shell = std::unique_ptr<Shell>(
       new Shell(std::move(vm), task_runners, settings,
                 std::make_shared<VolatilePathTracker>(
                     task_runners.GetUITaskRunner(),
                     !settings.skia_deterministic_rendering_on_cpu),
-                is_gpu_disabled));
+                is_gpu_disabled_sync_switch));
+  shell->default_font_manager_ = std::move(font_manager_future);
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -191,29 +282,28 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                                            shell = shell.get()    //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        shell->RecordStartupPhase(kRasterStartupPhase,
+                                  fml::TimePoint::Now() - start);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  const auto platform_view_start = fml::TimePoint::Now();
+  std::shared_ptr<PlatformView> platform_view =
+      on_create_platform_view(*shell.get());
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
-  }
-
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
-  // other subsystems.
-  std::promise<std::unique_ptr<ShellIOManager>> io_manager_promise;
+  // other subsystems. Its resource context only depends on the platform view,
+  // so this is kicked off before the platform view does any more work.
+  std::promise<std::shared_ptr<ShellIOManager>> io_manager_promise;
   auto io_manager_future = io_manager_promise.get_future();
   std::promise<fml::WeakPtr<ShellIOManager>> weak_io_manager_promise;
   auto weak_io_manager_future = weak_io_manager_promise.get_future();
@@ -221,33 +311,67 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   auto unref_queue_future = unref_queue_promise.get_future();
   auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
 
-  // TODO(gw280): The WeakPtr here asserts that we are derefing it on the
-  // same thread as it was created on. We are currently on the IO thread
-  // inside this lambda but we need to deref the PlatformView, which was
-  // constructed on the platform thread.
-  //
-  // https://github.com/flutter/flutter/issues/42948
-  fml::TaskRunner::RunNowOrPostTask(
-      io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
-       platform_view = platform_view->GetWeakPtr(),                       //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
-  ]() {
-        TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
-        auto io_manager = std::make_unique<ShellIOManager>(
-            platform_view.getUnsafe()->CreateResourceContext(),
-            is_backgrounded_sync_switch, io_task_runner);
-        weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
-        unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
-        io_manager_promise.set_value(std::move(io_manager));
-      });
+  if (spawner_io_manager) {
+    // Spawned shells run on the task runners of their spawner and their engine
+    // loads resources through the spawner's IO manager. Share it, and with it
+    // the resource context and unref queue, instead of creating another one.
+    weak_io_manager_promise.set_value(spawner_io_manager->GetWeakPtr());
+    unref_queue_promise.set_value(spawner_io_manager->GetSkiaUnrefQueue());
+    io_manager_promise.set_value(std::move(spawner_io_manager));
+  } else {
+    // TODO(gw280): The WeakPtr here asserts that we are derefing it on the
+    // same thread as it was created on. We are currently on the IO thread
+    // inside this lambda but we need to deref the PlatformView, which was
+    // constructed on the platform thread.
+    //
+    // https://github.com/flutter/flutter/issues/42948
+    fml::TaskRunner::RunNowOrPostTask(
+        io_task_runner,
+        [&io_manager_promise,                          //
+         &weak_io_manager_promise,                     //
+         &unref_queue_promise,                         //
+         platform_view = platform_view->GetWeakPtr(),  //
+         io_task_runner,                               //
+         is_backgrounded_sync_switch =                 //
+         shell->GetIsGpuDisabledSyncSwitch(),          //
+         shell = shell.get()                           //
+    ]() {
+          TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+          const auto start = fml::TimePoint::Now();
+          auto io_manager = std::make_shared<ShellIOManager>(
+              platform_view.getUnsafe()->CreateResourceContext(),
+              is_backgrounded_sync_switch, io_task_runner);
+          shell->RecordStartupPhase(kIOStartupPhase,
+                                    fml::TimePoint::Now() - start);
+          weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
+          unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+          io_manager_promise.set_value(std::move(io_manager));
+        });
+  }
+
+  // Ask the platform view for the vsync waiter. This will be used by the engine
+  // to create the animator.
+  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  if (!vsync_waiter) {
+    // The IO task refers to state on this stack frame.
+    io_manager_future.wait();
+    return nullptr;
+  }
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
-  auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  PointerDataDispatcherMaker dispatcher_maker =
+      platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_resampling) {
+    dispatcher_maker = [prediction_window = fml::TimeDelta::FromMilliseconds(
+                            settings.pointer_resampling_prediction_window_ms)](
+                           PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(
+          delegate, prediction_window);
+    };
+  }
+  shell->RecordStartupPhase(kPlatformViewStartupPhase,
+                            fml::TimePoint::Now() - platform_view_start);
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -265,6 +389,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &unref_queue_future,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        const auto start = fml::TimePoint::Now();
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
@@ -272,21 +397,24 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
 
-        engine_promise.set_value(
-            on_create_engine(*shell,                          //
-                             dispatcher_maker,                //
-                             *shell->GetDartVM(),             //
-                             std::move(isolate_snapshot),     //
-                             task_runners,                    //
-                             platform_data,                   //
-                             shell->GetSettings(),            //
-                             std::move(animator),             //
-                             weak_io_manager_future.get(),    //
-                             unref_queue_future.get(),        //
-                             snapshot_delegate_future.get(),  //
-                             shell->volatile_path_tracker_));
+        auto engine = on_create_engine(*shell,                          //
+                                       dispatcher_maker,                //
+                                       *shell->GetDartVM(),             //
+                                       std::move(isolate_snapshot),     //
+                                       task_runners,                    //
+                                       platform_data,                   //
+                                       shell->GetSettings(),            //
+                                       std::move(animator),             //
+                                       weak_io_manager_future.get(),    //
+                                       unref_queue_future.get(),        //
+                                       snapshot_delegate_future.get(),  //
+                                       shell->volatile_path_tracker_);
+        shell->RecordStartupPhase(kUIStartupPhase,
+                                  fml::TimePoint::Now() - start);
+        engine_promise.set_value(std::move(engine));
       }));
 
+  const auto setup_start = fml::TimePoint::Now();
   if (!shell->Setup(std::move(platform_view),  //
                     engine_future.get(),       //
                     rasterizer_future.get(),   //
@@ -294,6 +422,20 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   ) {
     return nullptr;
   }
+  shell->RecordStartupPhase(kSetupStartupPhase,
+                            fml::TimePoint::Now() - setup_start);
+
+  if (!spawner_io_manager) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetIOTaskRunner(),
+        [io_manager = shell->io_manager_,
+         releaser = MakeResourceContextReleaser(
+             shell->platform_view_, task_runners.GetPlatformTaskRunner())]() {
+          if (io_manager->GetResourceContext()) {
+            io_manager->SetResourceContextReleaser(releaser);
+          }
+        });
+  }
 
   return shell;
 }
@@ -307,7 +449,8 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     const Shell::EngineCreateCallback& on_create_engine,
-    bool is_gpu_disabled) {
+    const std::shared_ptr<fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    std::shared_ptr<ShellIOManager> spawner_io_manager) {
   // This must come first as it initializes tracing.
   PerformInitializationTasks(settings);
 
@@ -334,7 +477,8 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
            on_create_platform_view = std::move(on_create_platform_view),  //
            on_create_rasterizer = std::move(on_create_rasterizer),        //
            on_create_engine = std::move(on_create_engine),
-           is_gpu_disabled]() mutable {
+           spawner_io_manager = std::move(spawner_io_manager),
+           is_gpu_disabled_sync_switch]() mutable {
             shell = CreateShellOnPlatformThread(
                 std::move(vm),                       //
                 std::move(task_runners),             //
@@ -343,7 +487,8 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                 std::move(isolate_snapshot),         //
                 std::move(on_create_platform_view),  //
                 std::move(on_create_rasterizer),     //
-                std::move(on_create_engine), is_gpu_disabled);
+                std::move(on_create_engine), is_gpu_disabled_sync_switch,
+                std::move(spawner_io_manager));
             latch.Signal();
           }));
   latch.Wait();
@@ -354,11 +499,11 @@ Shell::Shell(DartVMRef vm,
              TaskRunners task_runners,
              Settings settings,
              std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-             bool is_gpu_disabled)
+             std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch)
     : task_runners_(std::move(task_runners)),
       settings_(std::move(settings)),
       vm_(std::move(vm)),
-      is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
+      is_gpu_disabled_sync_switch_(std::move(is_gpu_disabled_sync_switch)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
@@ -415,6 +560,11 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -445,15 +595,15 @@ Shell::~Shell() {
 
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetIOTaskRunner(),
-      fml::MakeCopyable([io_manager = std::move(io_manager_),
-                         platform_view = platform_view_.get(),
-                         &io_latch]() mutable {
-        io_manager.reset();
-        if (platform_view) {
-          platform_view->ReleaseResourceContext();
-        }
-        io_latch.Signal();
-      }));
+      fml::MakeCopyable(
+          [io_manager = std::move(io_manager_), &io_latch]() mutable {
+            // Spawned shells share the IO manager, and with it the resource
+            // context, of their spawner. The last of them to drop the IO
+            // manager releases the resource context, through the platform
+            // view that created it.
+            io_manager.reset();
+            io_latch.Signal();
+          }));
 
   io_latch.Wait();
 
@@ -475,35 +625,28 @@ std::unique_ptr<Shell> Shell::Spawn(
     const CreateCallback<PlatformView>& on_create_platform_view,
     const CreateCallback<Rasterizer>& on_create_rasterizer) const {
   FML_DCHECK(task_runners_.IsValid());
-  auto shell_maker = [&](bool is_gpu_disabled) {
-    std::unique_ptr<Shell> result(CreateWithSnapshot(
-        PlatformData{}, task_runners_, GetSettings(), vm_,
-        vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
-        on_create_rasterizer,
-        [engine = this->engine_.get()](
-            Engine::Delegate& delegate,
-            const PointerDataDispatcherMaker& dispatcher_maker, DartVM& vm,
-            fml::RefPtr<const DartSnapshot> isolate_snapshot,
-            TaskRunners task_runners, const PlatformData& platform_data,
-            Settings settings, std::unique_ptr<Animator> animator,
-            fml::WeakPtr<IOManager> io_manager,
-            fml::RefPtr<SkiaUnrefQueue> unref_queue,
-            fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
-            std::shared_ptr<VolatilePathTracker> volatile_path_tracker) {
-          return engine->Spawn(/*delegate=*/delegate,
-                               /*dispatcher_maker=*/dispatcher_maker,
-                               /*settings=*/settings,
-                               /*animator=*/std::move(animator));
-        },
-        is_gpu_disabled));
-    return result;
-  };
-  std::unique_ptr<Shell> result;
-  GetIsGpuDisabledSyncSwitch()->Execute(
-      fml::SyncSwitch::Handlers()
-          .SetIfFalse([&] { result = shell_maker(false); })
-          .SetIfTrue([&] { result = shell_maker(true); }));
-  result->shared_resource_context_ = io_manager_->GetSharedResourceContext();
+  // The spawned shell shares the GPU availability of its spawner, which the IO
+  // manager they share checks.
+  std::unique_ptr<Shell> result(CreateWithSnapshot(
+      PlatformData{}, task_runners_, GetSettings(), vm_,
+      vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
+      on_create_rasterizer,
+      [engine = this->engine_.get()](
+          Engine::Delegate& delegate,
+          const PointerDataDispatcherMaker& dispatcher_maker, DartVM& vm,
+          fml::RefPtr<const DartSnapshot> isolate_snapshot,
+          TaskRunners task_runners, const PlatformData& platform_data,
+          Settings settings, std::unique_ptr<Animator> animator,
+          fml::WeakPtr<IOManager> io_manager,
+          fml::RefPtr<SkiaUnrefQueue> unref_queue,
+          fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
+          std::shared_ptr<VolatilePathTracker> volatile_path_tracker) {
+        return engine->Spawn(/*delegate=*/delegate,
+                             /*dispatcher_maker=*/dispatcher_maker,
+                             /*settings=*/settings,
+                             /*animator=*/std::move(animator));
+      },
+      is_gpu_disabled_sync_switch_, io_manager_));
   result->RunEngine(std::move(run_configuration));
 
   task_runners_.GetRasterTaskRunner()->PostTask(
@@ -614,10 +757,25 @@ bool Shell::IsSetup() const {
   return is_setup_;
 }
 
-bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
+std::map<std::string, fml::TimeDelta> Shell::GetStartupPhaseDurations() const {
+  std::scoped_lock lock(startup_phases_mutex_);
+  return startup_phase_durations_;
+}
+
+std::shared_ptr<const FrameStatistics> Shell::GetFrameStatistics() const {
+  return frame_statistics_;
+}
+
+void Shell::RecordStartupPhase(const std::string& phase,
+                               fml::TimeDelta duration) {
+  std::scoped_lock lock(startup_phases_mutex_);
+  startup_phase_durations_[phase] = duration;
+}
+
+bool Shell::Setup(std::shared_ptr<PlatformView> platform_view,
                   std::unique_ptr<Engine> engine,
                   std::unique_ptr<Rasterizer> rasterizer,
-                  std::unique_ptr<ShellIOManager> io_manager) {
+                  std::shared_ptr<ShellIOManager> io_manager) {
   if (is_setup_) {
     return false;
   }
@@ -630,6 +788,19 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   engine_ = std::move(engine);
   rasterizer_ = std::move(rasterizer);
   io_manager_ = std::move(io_manager);
+  frame_statistics_ = rasterizer_->compositor_context()->frame_statistics();
+  if (settings_.enable_parallel_preroll) {
+    rasterizer_->compositor_context()->SetConcurrentPrerollTaskRunner(
+        vm_->GetConcurrentWorkerTaskRunner());
+  }
+  rasterizer_->compositor_context()->SetBackdropBlurMaxDownsampling(
+      settings_.backdrop_blur_max_downsampling);
+  rasterizer_->compositor_context()->SetLayerPaintTimesEnabled(
+      settings_.enable_layer_paint_times);
+  rasterizer_->compositor_context()
+      ->raster_cache()
+      .SetUseDisplayListContentKeys(
+          settings_.enable_display_list_content_cache_keys);
 
   // Set the external view embedder for the rasterizer.
   auto view_embedder = platform_view_->CreateExternalViewEmbedder();
@@ -641,19 +812,31 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
-  // Setup the time-consuming default font manager right after engine created.
-  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                    [engine = weak_engine_] {
-                                      if (engine) {
-                                        engine->SetupDefaultFontManager();
-                                      }
-                                    });
+  // Install the default font manager, which is created concurrently with the
+  // other subsystems, right after engine created. Spawned shells don't create
+  // one as they share the font collection of their spawner.
+  if (default_font_manager_.valid()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, shell = this,
+         font_manager = default_font_manager_] {
+          if (!engine) {
+            return;
+          }
+          const auto& [manager, duration] = font_manager.get();
+          shell->RecordStartupPhase(kFontManagerStartupPhase, duration);
+          engine->SetupDefaultFontManager(manager);
+        });
+  }
 
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
+  PersistentCache::GetCacheForProcess()->SetConcurrentTaskRunner(
+      vm_->GetConcurrentWorkerTaskRunner());
+
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
 
@@ -778,16 +961,15 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
   FML_DCHECK(platform_view);
 
   auto io_task = [io_manager = io_manager_->GetWeakPtr(), platform_view,
-                  ui_task_runner = task_runners_.GetUITaskRunner(), ui_task,
-                  shared_resource_context = shared_resource_context_] {
+                  releaser = MakeResourceContextReleaser(
+                      platform_view_, task_runners_.GetPlatformTaskRunner()),
+                  ui_task_runner = task_runners_.GetUITaskRunner(), ui_task] {
     if (io_manager && !io_manager->GetResourceContext()) {
-      sk_sp<GrDirectContext> resource_context;
-      if (shared_resource_context) {
-        resource_context = shared_resource_context;
-      } else {
-        resource_context = platform_view->CreateResourceContext();
+      auto resource_context = platform_view->CreateResourceContext();
+      if (resource_context) {
+        io_manager->SetResourceContextReleaser(releaser);
       }
-      io_manager->NotifyResourceContextAvailable(resource_context);
+      io_manager->NotifyResourceContextAvailable(std::move(resource_context));
     }
     // Step 1: Next, post a task on the UI thread to tell the engine that it has
     // an output surface.
@@ -953,16 +1135,32 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
 void Shell::OnPlatformViewDispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
   TRACE_EVENT0("flutter", "Shell::OnPlatformViewDispatchPointerDataPacket");
-  TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  {
+    std::scoped_lock lock(pending_pointer_data_->mutex);
+    if (pending_pointer_data_->packet) {
+      // The UI thread hasn't dispatched the previous packet yet. Rather than
+      // queueing another task behind it, let it dispatch these events too.
+      TRACE_EVENT_INSTANT0("flutter", "CoalescePointerDataPacket");
+      pending_pointer_data_->packet->AppendCoalescingMoves(*packet);
+      return;
+    }
+    pending_pointer_data_->packet = std::move(packet);
+  }
+  TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   task_runners_.GetUITaskRunner()->PostTask(
-      fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
-                         flow_id = next_pointer_flow_id_]() mutable {
-        if (engine) {
+      [engine = weak_engine_, pending = pending_pointer_data_,
+       flow_id = next_pointer_flow_id_]() {
+        std::unique_ptr<PointerDataPacket> packet;
+        {
+          std::scoped_lock lock(pending->mutex);
+          packet = std::move(pending->packet);
+        }
+        if (engine && packet) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      });
   next_pointer_flow_id_++;
 }
 
@@ -1696,6 +1894,61 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& statistics = frame_statistics_;
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", statistics->GetFrameCount(),
+                                allocator);
+  response->AddMember<uint64_t>("jankyFrameCount",
+                                statistics->GetJankyFrameCount(), allocator);
+
+  // All durations are in microseconds.
+  rapidjson::Value phases(rapidjson::kObjectType);
+  for (size_t i = 0; i < kFramePhaseCount; i++) {
+    const auto phase = static_cast<FramePhase>(i);
+    const auto summary = statistics->GetPhaseSummary(phase);
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember<uint64_t>("count", summary.count, allocator);
+    value.AddMember<int64_t>("p50", summary.p50.ToMicroseconds(), allocator);
+    value.AddMember<int64_t>("p90", summary.p90.ToMicroseconds(), allocator);
+    value.AddMember<int64_t>("p99", summary.p99.ToMicroseconds(), allocator);
+    value.AddMember<int64_t>("max", summary.max.ToMicroseconds(), allocator);
+    value.AddMember<int64_t>("mean", summary.mean.ToMicroseconds(), allocator);
+    value.AddMember<uint64_t>("jankyFrames", summary.janky_frames, allocator);
+    phases.AddMember(rapidjson::StringRef(FramePhaseToString(phase)), value,
+                     allocator);
+  }
+  response->AddMember("phases", phases, allocator);
+
+  rapidjson::Value janky_frames(rapidjson::kArrayType);
+  for (const auto& frame : statistics->GetJankyFrames()) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember<uint64_t>("frameNumber", frame.frame_number, allocator);
+    value.AddMember<int64_t>("total", frame.total.ToMicroseconds(), allocator);
+    value.AddMember("phase",
+                    rapidjson::StringRef(FramePhaseToString(frame.phase)),
+                    allocator);
+    rapidjson::Value layers(rapidjson::kArrayType);
+    for (const auto& layer : frame.slowest_layers) {
+      rapidjson::Value layer_value(rapidjson::kObjectType);
+      layer_value.AddMember<uint64_t>("id", layer.layer_id, allocator);
+      layer_value.AddMember<int64_t>("paint", layer.duration.ToMicroseconds(),
+                                     allocator);
+      layers.PushBack(layer_value, allocator);
+    }
+    value.AddMember("slowestLayers", layers, allocator);
+    janky_frames.PushBack(value, allocator);
+  }
+  response->AddMember("jankyFrames", janky_frames, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
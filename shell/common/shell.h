@@ -6,6 +6,8 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <future>
+#include <map>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -14,6 +16,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_statistics.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -368,6 +371,22 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The time spent in each phase of the shell bring-up, keyed by
+  ///             phase name. Phases run concurrently on different threads
+  ///             where they don't depend on each other, so the durations do
+  ///             not add up to the total startup time. The default font
+  ///             manager phase is reported once the UI thread has installed
+  ///             it.
+  ///
+  std::map<std::string, fml::TimeDelta> GetStartupPhaseDurations() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Per-phase timing histograms and jank attribution of the frames
+  ///             rasterized by this shell. This may be read from any thread.
+  ///
+  std::shared_ptr<const FrameStatistics> GetFrameStatistics() const;
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -378,10 +397,10 @@ class Shell final : public PlatformView::Delegate,
   DartVMRef vm_;
   mutable std::mutex time_recorder_mutex_;
   std::optional<fml::TimePoint> latest_frame_target_time_;
-  std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
+  std::shared_ptr<PlatformView> platform_view_;  // on platform task runner
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on raster task runner
-  std::unique_ptr<ShellIOManager> io_manager_;   // on IO task runner
+  std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
 
@@ -401,6 +420,18 @@ class Shell final : public PlatformView::Delegate,
   bool is_added_to_service_protocol_ = false;
   uint64_t next_pointer_flow_id_ = 0;
 
+  // Pointer data dispatched on the platform thread that the UI thread hasn't
+  // picked up yet. While there is some, the UI thread is behind, and later
+  // packets are appended to it with their moves and hovers coalesced instead
+  // of being posted as tasks of their own. Shared with the posted task, which
+  // may outlive the shell.
+  struct PendingPointerData {
+    std::mutex mutex;
+    std::unique_ptr<PointerDataPacket> packet;
+  };
+  std::shared_ptr<PendingPointerData> pending_pointer_data_ =
+      std::make_shared<PendingPointerData>();
+
   bool first_frame_rasterized_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
@@ -433,13 +464,20 @@ class Shell final : public PlatformView::Delegate,
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
-  sk_sp<GrDirectContext> shared_resource_context_;
+  // The default font manager and the time it took to create it. It is created
+  // on the concurrent workers while the other subsystems are set up.
+  std::shared_future<std::pair<sk_sp<SkFontMgr>, fml::TimeDelta>>
+      default_font_manager_;
+
+  mutable std::mutex startup_phases_mutex_;
+  std::map<std::string, fml::TimeDelta> startup_phase_durations_;
+  std::shared_ptr<const FrameStatistics> frame_statistics_;
 
   Shell(DartVMRef vm,
         TaskRunners task_runners,
         Settings settings,
         std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-        bool is_gpu_disabled);
+        std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch);
 
   static std::unique_ptr<Shell> CreateShellOnPlatformThread(
       DartVMRef vm,
@@ -450,7 +488,8 @@ class Shell final : public PlatformView::Delegate,
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
       const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
       const EngineCreateCallback& on_create_engine,
-      bool is_gpu_disabled);
+      const std::shared_ptr<fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      std::shared_ptr<ShellIOManager> spawner_io_manager);
   static std::unique_ptr<Shell> CreateWithSnapshot(
       const PlatformData& platform_data,
       TaskRunners task_runners,
@@ -460,15 +499,18 @@ class Shell final : public PlatformView::Delegate,
       const CreateCallback<PlatformView>& on_create_platform_view,
       const CreateCallback<Rasterizer>& on_create_rasterizer,
       const EngineCreateCallback& on_create_engine,
-      bool is_gpu_disabled);
+      const std::shared_ptr<fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      std::shared_ptr<ShellIOManager> spawner_io_manager);
 
-  bool Setup(std::unique_ptr<PlatformView> platform_view,
+  bool Setup(std::shared_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
              std::unique_ptr<Rasterizer> rasterizer,
-             std::unique_ptr<ShellIOManager> io_manager);
+             std::shared_ptr<ShellIOManager> io_manager);
 
   void ReportTimings();
 
+  void RecordStartupPhase(const std::string& phase, fml::TimeDelta duration);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -646,6 +688,14 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports the per-phase frame time percentiles and the most recent janky
+  // frames along with what they are attributed to.
+  bool OnServiceProtocolGetFrameStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
@@ -79,6 +79,16 @@ static void StartupAndShutdownShell(benchmark::State& state,
     latch.Wait();
   }
 
+  if (measure_startup) {
+    // Report the per-phase breakdown in milliseconds, averaged over the
+    // iterations. Phases overlap since they run on different threads.
+    for (const auto& [phase, duration] : shell->GetStartupPhaseDurations()) {
+      benchmark::Counter& counter = state.counters[phase + "Ms"];
+      counter.flags = benchmark::Counter::kAvgIterations;
+      counter.value += duration.ToMillisecondsF();
+    }
+  }
+
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_shutdown);
     // Shutdown must occur synchronously on the platform thread.
@@ -63,6 +63,13 @@ ShellIOManager::~ShellIOManager() {
   // underlying OpenGL context may be going away.
   is_gpu_disabled_sync_switch_->Execute(
       fml::SyncSwitch::Handlers().SetIfFalse([&] { unref_queue_->Drain(); }));
+
+  if (resource_context_releaser_) {
+    // The resource context has to be collected while it is still current.
+    resource_context_weak_factory_.reset();
+    resource_context_.reset();
+    resource_context_releaser_();
+  }
 }
 
 void ShellIOManager::NotifyResourceContextAvailable(
@@ -85,6 +92,10 @@ void ShellIOManager::UpdateResourceContext(
           : nullptr;
 }
 
+void ShellIOManager::SetResourceContextReleaser(fml::closure releaser) {
+  resource_context_releaser_ = std::move(releaser);
+}
+
 fml::WeakPtr<ShellIOManager> ShellIOManager::GetWeakPtr() {
   return weak_factory_.GetWeakPtr();
 }
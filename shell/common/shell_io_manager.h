@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
@@ -42,6 +43,13 @@ class ShellIOManager final : public IOManager {
   // resource context, but may be called if the Dart VM is restarted.
   void UpdateResourceContext(sk_sp<GrDirectContext> resource_context);
 
+  // Sets the callback that releases the resource context on the IO thread once
+  // this IO manager and its resource context are destroyed. The IO manager is
+  // shared by a shell and its spawns, so the callback has to release the
+  // context through the platform view that created it, whichever shell is
+  // destroyed last.
+  void SetResourceContextReleaser(fml::closure releaser);
+
   fml::WeakPtr<ShellIOManager> GetWeakPtr();
 
   // |IOManager|
@@ -65,6 +73,7 @@ class ShellIOManager final : public IOManager {
   sk_sp<GrDirectContext> resource_context_;
   std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>>
       resource_context_weak_factory_;
+  fml::closure resource_context_releaser_;
 
   // Unref queue management.
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
@@ -36,6 +36,7 @@
 #include "gmock/gmock.h"
 #include "third_party/rapidjson/include/rapidjson/writer.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 #ifdef SHELL_ENABLE_VULKAN
@@ -118,6 +119,8 @@ class MockPlatformView : public PlatformView {
   MockPlatformView(MockPlatformViewDelegate& delegate, TaskRunners task_runners)
       : PlatformView(delegate, task_runners) {}
   MOCK_METHOD0(CreateRenderingSurface, std::unique_ptr<Surface>());
+  MOCK_CONST_METHOD0(CreateResourceContext, sk_sp<GrDirectContext>());
+  MOCK_CONST_METHOD0(ReleaseResourceContext, void());
 };
 }  // namespace
 
@@ -259,6 +262,36 @@ TEST_F(ShellTest, InitializeWithDifferentThreads) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, ReportsStartupPhaseDurations) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(std::move(settings), task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  // Wait for the default font manager to be installed on the UI thread.
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetUITaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  auto durations = shell->GetStartupPhaseDurations();
+  for (const auto* phase :
+       {"Snapshots", "DartVM", "Rasterizer", "PlatformView", "IOManager",
+        "Engine", "DefaultFontManager", "Setup"}) {
+    ASSERT_EQ(durations.count(phase), 1u) << phase;
+    ASSERT_GE(durations[phase], fml::TimeDelta::Zero()) << phase;
+  }
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -2545,6 +2578,9 @@ TEST_F(ShellTest, Spawn) {
 
         PostSync(
             spawner->GetTaskRunners().GetIOTaskRunner(), [&spawner, &spawn] {
+              // Spawned shells share the IO manager of their spawner.
+              ASSERT_EQ(spawner->GetIOManager().get(),
+                        spawn->GetIOManager().get());
               ASSERT_EQ(spawner->GetIOManager()->GetResourceContext().get(),
                         spawn->GetIOManager()->GetResourceContext().get());
             });
@@ -2560,6 +2596,86 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, SpawnOutlivesSpawner) {
+  auto settings = CreateSettingsForFixture();
+  auto task_runners = GetTaskRunnersForFixture();
+  MockPlatformViewDelegate platform_view_delegate;
+  MockPlatformView* spawner_platform_view = nullptr;
+  auto spawner = Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [&](Shell& shell) {
+        auto result = std::make_unique<MockPlatformView>(
+            platform_view_delegate, shell.GetTaskRunners());
+        ON_CALL(*result, CreateResourceContext())
+            .WillByDefault(::testing::Invoke(
+                [] { return GrDirectContext::MakeMock(nullptr); }));
+        spawner_platform_view = result.get();
+        return result;
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  ASSERT_TRUE(ValidateShell(spawner.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(spawner.get(), std::move(configuration));
+
+  std::unique_ptr<Shell> spawns[2];
+  MockPlatformView* spawn_platform_views[2] = {};
+  PostSync(spawner->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+    for (size_t i = 0; i < 2; i++) {
+      auto spawn_configuration = RunConfiguration::InferFromSettings(settings);
+      spawn_configuration.SetEntrypoint("emptyMain");
+      spawns[i] = spawner->Spawn(
+          std::move(spawn_configuration),
+          [&](Shell& shell) {
+            auto result = std::make_unique<MockPlatformView>(
+                platform_view_delegate, shell.GetTaskRunners());
+            spawn_platform_views[i] = result.get();
+            return result;
+          },
+          [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+      ASSERT_TRUE(ValidateShell(spawns[i].get()));
+    }
+  });
+
+  PostSync(task_runners.GetIOTaskRunner(), [&spawner, &spawns]() {
+    ASSERT_TRUE(spawner->GetIOManager()->GetResourceContext());
+    ASSERT_EQ(spawner->GetIOManager().get(), spawns[0]->GetIOManager().get());
+  });
+
+  // The spawns didn't create the resource context of the shared IO manager,
+  // so they never release it.
+  EXPECT_CALL(*spawn_platform_views[0], ReleaseResourceContext()).Times(0);
+  EXPECT_CALL(*spawn_platform_views[1], ReleaseResourceContext()).Times(0);
+  // The platform view of the spawner outlives it, until the last spawn is
+  // gone.
+  EXPECT_CALL(*spawner_platform_view, ReleaseResourceContext()).Times(0);
+  DestroyShell(std::move(spawner), task_runners);
+
+  // The IO manager checks the GPU availability the spawns set.
+  spawns[0]->SetGpuAvailability(GpuAvailability::kUnavailable);
+  PostSync(spawns[0]->GetTaskRunners().GetIOTaskRunner(), [&spawns]() {
+    auto io_manager = spawns[1]->GetIOManager();
+    ASSERT_TRUE(io_manager);
+    ASSERT_EQ(spawns[0]->GetIOManager().get(), io_manager.get());
+    bool is_gpu_disabled = false;
+    io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers().SetIfTrue(
+            [&is_gpu_disabled] { is_gpu_disabled = true; }));
+    ASSERT_TRUE(is_gpu_disabled);
+  });
+  spawns[1]->SetGpuAvailability(GpuAvailability::kAvailable);
+
+  DestroyShell(std::move(spawns[0]), task_runners);
+  ::testing::Mock::VerifyAndClearExpectations(spawner_platform_view);
+
+  // The last spawn releases the resource context through the platform view of
+  // the spawner, which is then collected on the platform thread.
+  EXPECT_CALL(*spawner_platform_view, ReleaseResourceContext()).Times(1);
+  DestroyShell(std::move(spawns[1]), task_runners);
+  PostSync(task_runners.GetPlatformTaskRunner(), []() {});
+}
+
 TEST_F(ShellTest, UpdateAssetResolverByTypeReplaces) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
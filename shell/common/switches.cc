@@ -290,6 +290,35 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_parallel_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParallelPreroll));
+
+  settings.enable_layer_paint_times =
+      command_line.HasOption(FlagForSwitch(Switch::EnableLayerPaintTimes));
+
+  int backdrop_blur_max_downsampling = 1;
+  if (GetSwitchValue(command_line, Switch::BackdropBlurMaxDownsampling,
+                     &backdrop_blur_max_downsampling)) {
+    settings.backdrop_blur_max_downsampling =
+        std::max(1, backdrop_blur_max_downsampling);
+  }
+
+  settings.enable_display_list_content_cache_keys = command_line.HasOption(
+      FlagForSwitch(Switch::EnableDisplayListContentCacheKeys));
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+
+  int64_t prediction_window_ms;
+  if (GetSwitchValue(command_line, Switch::PointerResamplingPredictionWindow,
+                     &prediction_window_ms)) {
+    settings.pointer_resampling_prediction_window_ms =
+        std::max<int64_t>(0, prediction_window_ms);
+  }
+
+  settings.enable_semantics_update_diffing = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSemanticsUpdateDiffing));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -317,6 +346,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.enable_trace_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTraceRecorder));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -430,6 +462,14 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  if (command_line.HasOption(FlagForSwitch(Switch::SkSLPrecompileBudget))) {
+    if (!GetSwitchValue(command_line, Switch::SkSLPrecompileBudget,
+                        &settings.sksl_precompile_budget_ms)) {
+      FML_LOG(INFO) << "SkSL precompile budget specified was malformed. "
+                       "Shaders will be precompiled without a budget.";
+    }
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
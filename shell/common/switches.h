@@ -101,6 +101,38 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableParallelPreroll,
+           "enable-parallel-preroll",
+           "Preroll large sibling subtrees of the layer tree in parallel on "
+           "worker threads. Raster cache preparation and platform views are "
+           "still handled on the raster thread, in tree order.")
+DEF_SWITCH(BackdropBlurMaxDownsampling,
+           "backdrop-blur-max-downsampling",
+           "The largest factor by which the backdrops of blurring backdrop "
+           "filters may be downsampled before they are blurred. Defaults to "
+           "1, which disables downsampling.")
+DEF_SWITCH(EnableLayerPaintTimes,
+           "enable-layer-paint-times",
+           "Measure the paint time of every layer, so that the janky frames "
+           "reported in the frame statistics list their slowest layers.")
+DEF_SWITCH(EnableDisplayListContentCacheKeys,
+           "enable-display-list-content-cache-keys",
+           "Key the raster cache entries of display lists on their content "
+           "rather than their identity, so that display lists recorded again "
+           "without changes keep their cached images.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Resample the moves of each pointer once per frame, so that the "
+           "framework receives one evenly timed sample per pointer and "
+           "frame.")
+DEF_SWITCH(PointerResamplingPredictionWindow,
+           "pointer-resampling-prediction-window",
+           "How far past the newest sample of a pointer its resampled "
+           "position may be extrapolated, in milliseconds. Defaults to 8.")
+DEF_SWITCH(EnableSemanticsUpdateDiffing,
+           "enable-semantics-update-diffing",
+           "Leave the semantics nodes that didn't change since they were last "
+           "sent to the platform out of semantics updates.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
@@ -152,6 +184,11 @@ DEF_SWITCH(CacheSkSL,
            "should only be used during development phases. The generated SkSLs "
            "can later be used in the release build for shader precompilation "
            "at launch in order to eliminate the shader-compile jank.")
+DEF_SWITCH(SkSLPrecompileBudget,
+           "sksl-precompile-budget",
+           "The time in milliseconds that may be spent precompiling known "
+           "SkSLs at startup. Shaders that don't fit in the budget are "
+           "precompiled on subsequent frames, most used ones first.")
 DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
@@ -162,6 +199,12 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(EnableTraceRecorder,
+           "enable-trace-recorder",
+           "Keep the most recent trace events of each thread in memory so "
+           "that they can be dumped on demand, for instance when a frame is "
+           "janky. Unlike the timeline, this is also available in release "
+           "mode.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -32,6 +32,10 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// The target time of the frame for the last vsync that callbacks were
+  /// fired for, or the epoch if there hasn't been one yet.
+  fml::TimePoint GetLastFrameTargetTime();
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -73,6 +77,7 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  fml::TimePoint last_frame_target_time_;
 
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
@@ -225,6 +225,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
         });
   }
 
+  // Continue with the known SkSLs that did not fit in the startup budget.
+  PersistentCache::GetCacheForProcess()->PrecompilePendingSkSLs(
+      context_.get(), PersistentCache::kPendingSkSLsFrameBudget);
+
   const auto root_surface_transformation = GetRootTransformation();
 
   sk_sp<SkSurface> surface =
@@ -39,7 +39,10 @@ bool GPUSurfaceMetal::IsValid() {
 void GPUSurfaceMetal::PrecompileKnownSkSLsIfNecessary() {
   auto* current_context = GetContext();
   if (current_context == precompiled_sksl_context_) {
-    // Known SkSLs have already been prepared in this context.
+    // Known SkSLs have already been prepared in this context. Continue with
+    // the ones that did not fit in the startup budget, if any.
+    flutter::PersistentCache::GetCacheForProcess()->PrecompilePendingSkSLs(
+        current_context, flutter::PersistentCache::kPendingSkSLsFrameBudget);
     return;
   }
   precompiled_sksl_context_ = current_context;
@@ -66,10 +66,17 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->flush();
 
+    if (surface_frame.damage().has_value()) {
+      return self->delegate_->PresentBackingStoreDamage(
+          surface_frame.SkiaSurface(), surface_frame.damage().value());
+    }
     return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
   };
 
-  return std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
+  auto frame = std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
+  frame->set_supports_partial_repaint(
+      delegate_->RetainsBackingStoreContents());
+  return frame;
 }
 
 // |Surface|
@@ -8,4 +8,14 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::RetainsBackingStoreContents() const {
+  return false;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::vector<SkIRect>& damage) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
 }  // namespace flutter
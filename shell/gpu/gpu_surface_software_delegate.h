@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <vector>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -48,6 +50,32 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the backing store returned by `AcquireBackingStore`
+  ///             still holds the previously presented frame when its size
+  ///             doesn't change. If it does, the rasterizer only repaints the
+  ///             parts of each frame that changed and presents the frame with
+  ///             `PresentBackingStoreDamage`.
+  ///
+  /// @return     Returns false unless overridden.
+  ///
+  virtual bool RetainsBackingStoreContents() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Same as `PresentBackingStore` but also passes the parts of the
+  ///             backing store that changed since the previously presented
+  ///             frame.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  damage         The non-overlapping rects of the backing
+  ///                            store that changed.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen. Calls `PresentBackingStore` unless overridden.
+  ///
+  virtual bool PresentBackingStoreDamage(sk_sp<SkSurface> backing_store,
+                                         const std::vector<SkIRect>& damage);
 };
 
 }  // namespace flutter
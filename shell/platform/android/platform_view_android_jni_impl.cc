@@ -1337,12 +1337,11 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
   jobject mutatorsStack = env->NewObject(g_mutators_stack_class->obj(),
                                          g_mutators_stack_init_method);
 
-  std::vector<std::shared_ptr<Mutator>>::const_iterator iter =
-      mutators_stack.Begin();
+  MutatorsStack::const_iterator iter = mutators_stack.Begin();
   while (iter != mutators_stack.End()) {
-    switch ((*iter)->GetType()) {
+    switch (iter->GetType()) {
       case transform: {
-        const SkMatrix& matrix = (*iter)->GetMatrix();
+        const SkMatrix& matrix = iter->GetMatrix();
         SkScalar matrix_array[9];
         matrix.get9(matrix_array);
         fml::jni::ScopedJavaLocalRef<jfloatArray> transformMatrix(
@@ -1355,7 +1354,7 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
         break;
       }
       case clip_rect: {
-        const SkRect& rect = (*iter)->GetRect();
+        const SkRect& rect = iter->GetRect();
         env->CallVoidMethod(
             mutatorsStack, g_mutators_stack_push_cliprect_method,
             static_cast<int>(rect.left()), static_cast<int>(rect.top()),
@@ -1363,7 +1362,7 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
         break;
       }
       case clip_rrect: {
-        const SkRRect& rrect = (*iter)->GetRRect();
+        const SkRRect& rrect = iter->GetRRect();
         const SkRect& rect = rrect.rect();
         const SkVector& upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
         const SkVector& upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
@@ -4,6 +4,7 @@
 
 #include "accessibility_bridge.h"
 
+#include <cmath>
 #include <functional>
 #include <utility>
 
@@ -43,6 +44,7 @@ void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
 }
 
 void AccessibilityBridge::CommitUpdates() {
+  RemoveUnchangedUpdates();
   ui::AXTreeUpdate update{.tree_data = tree_.data()};
   // Figure out update order, ui::AXTree only accepts update in tree order,
   // where parent node must come before the child node in
@@ -54,15 +56,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
+    SemanticsNode target = std::move(begin->second);
+    pending_semantics_node_updates_.erase(begin);
     std::vector<SemanticsNode> sub_tree_list;
     GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFluterUpdate(node, update);
     }
   }
@@ -74,8 +76,18 @@ void AccessibilityBridge::CommitUpdates() {
   std::string error = tree_.error();
   if (!error.empty()) {
     BASE_LOG() << "Failed to update ui::AXTree, error: " << error;
+    committed_semantics_nodes_.clear();
     return;
   }
+  for (auto& result : results) {
+    for (SemanticsNode& node : result) {
+      // Only the nodes that made it into the tree are remembered.
+      if (tree_.GetFromId(node.id)) {
+        int32_t id = node.id;
+        committed_semantics_nodes_[id] = std::move(node);
+      }
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -156,6 +168,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -178,15 +191,32 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
+void AccessibilityBridge::RemoveUnchangedUpdates() {
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    const SemanticsNode& node = iter->second;
+    auto committed = committed_semantics_nodes_.find(node.id);
+    // The descriptions of custom actions come with the custom action updates,
+    // so nodes with custom actions are always updated.
+    if (committed != committed_semantics_nodes_.end() &&
+        node.custom_accessibility_actions.empty() &&
+        IsSameSemanticsNode(node, committed->second)) {
+      iter = pending_semantics_node_updates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
                                          std::vector<SemanticsNode>& result) {
   result.push_back(target);
   for (int32_t child : target.children_in_traversal_order) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(node, result);
     }
   }
 }
@@ -454,6 +484,40 @@ void AccessibilityBridge::SetTreeData(const SemanticsNode& node,
   }
 }
 
+bool AccessibilityBridge::IsSameSemanticsNode(const SemanticsNode& a,
+                                              const SemanticsNode& b) {
+  // Scroll positions and extents are NaN for nodes that don't scroll.
+  auto same_double = [](double x, double y) {
+    return x == y || (std::isnan(x) && std::isnan(y));
+  };
+  return a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         same_double(a.scroll_position, b.scroll_position) &&
+         same_double(a.scroll_extent_max, b.scroll_extent_max) &&
+         same_double(a.scroll_extent_min, b.scroll_extent_min) &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value &&
+         a.text_direction == b.text_direction &&
+         a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         a.transform.scaleX == b.transform.scaleX &&
+         a.transform.skewX == b.transform.skewX &&
+         a.transform.transX == b.transform.transX &&
+         a.transform.skewY == b.transform.skewY &&
+         a.transform.scaleY == b.transform.scaleY &&
+         a.transform.transY == b.transform.transY &&
+         a.transform.pers0 == b.transform.pers0 &&
+         a.transform.pers1 == b.transform.pers1 &&
+         a.transform.pers2 == b.transform.pers2 &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions;
+}
+
 AccessibilityBridge::SemanticsNode
 AccessibilityBridge::FromFlutterSemanticsNode(
     const FlutterSemanticsNode* flutter_node) {
@@ -209,13 +209,18 @@ class AccessibilityBridge
   ui::AXTree tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The nodes as they were last committed to the tree, used to leave the
+  // nodes that didn't change out of the tree updates.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
   std::unique_ptr<AccessibilityBridgeDelegate> delegate_;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
-  void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
+  void RemoveUnchangedUpdates();
+  void GetSubTreeList(const SemanticsNode& target,
+                      std::vector<SemanticsNode>& result);
   void ConvertFluterUpdate(const SemanticsNode& node,
                            ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -237,6 +242,8 @@ class AccessibilityBridge
   void SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
                                  const SemanticsNode& node);
   void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
+  static bool IsSameSemanticsNode(const SemanticsNode& a,
+                                  const SemanticsNode& b);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode* flutter_node);
   SemanticsCustomAction FromFlutterSemanticsCustomAction(
@@ -289,5 +289,61 @@ TEST(AccessibilityBridgeTest, doesNotAssignEditableRootToSelectableText) {
       ax::mojom::BoolAttribute::kEditableRoot));
 }
 
+TEST(AccessibilityBridgeTest, canAddNodesAgainAfterTheyWereRemoved) {
+  TestAccessibilityBridgeDelegate* delegate =
+      new TestAccessibilityBridgeDelegate();
+  std::unique_ptr<TestAccessibilityBridgeDelegate> ptr(delegate);
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(std::move(ptr));
+  FlutterSemanticsNode root = {};
+  root.id = 0;
+  root.label = "root";
+  root.hint = "";
+  root.value = "";
+  root.increased_value = "";
+  root.decreased_value = "";
+  root.child_count = 1;
+  int32_t children[] = {1};
+  root.children_in_traversal_order = children;
+  root.custom_accessibility_actions_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+
+  FlutterSemanticsNode child1 = {};
+  child1.id = 1;
+  child1.label = "child 1";
+  child1.hint = "";
+  child1.value = "";
+  child1.increased_value = "";
+  child1.decreased_value = "";
+  child1.child_count = 0;
+  child1.custom_accessibility_actions_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  bridge->CommitUpdates();
+  delegate->accessibilitiy_events.clear();
+
+  // Sending the same nodes again doesn't change the tree.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(delegate->accessibilitiy_events.empty());
+  EXPECT_FALSE(bridge->GetFlutterPlatformNodeDelegateFromID(1).expired());
+
+  // Removes the child.
+  root.child_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(1).expired());
+
+  // Adds the child back, unchanged.
+  root.child_count = 1;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+  bridge->CommitUpdates();
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  ASSERT_TRUE(child1_node);
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -36,7 +36,7 @@ TextInputModel::~TextInputModel() = default;
 void TextInputModel::SetText(const std::string& text) {
   std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       utf16_converter;
-  text_ = utf16_converter.from_bytes(text);
+  text_ = TextRope(utf16_converter.from_bytes(text));
   selection_ = TextRange(0);
   composing_range_ = TextRange(0);
 }
@@ -73,7 +73,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  text_.Replace(composing_range_.start(), composing_range_.length(), text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -103,7 +103,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  text_.Erase(start, selection_.length());
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -130,12 +130,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    text_.Erase(composing_range_.start(), composing_range_.length());
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  text_.Insert(position, text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -153,7 +153,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    text_.Erase(position - count, count);
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -171,7 +171,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    text_.Erase(position, count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -209,7 +209,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  text_.Erase(start, deleted_length);
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -290,18 +290,11 @@ bool TextInputModel::MoveCursorBack() {
 }
 
 std::string TextInputModel::GetText() const {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(text_);
+  return text_.ToUtf8();
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(leading_text).size();
+  return text_.Utf8Offset(selection_.extent());
 }
 
 }  // namespace flutter
@@ -9,11 +9,15 @@
 #include <string>
 
 #include "flutter/shell/platform/common/text_range.h"
+#include "flutter/shell/platform/common/text_rope.h"
 
 namespace flutter {
 
 // Handles underlying text input state, using a simple ASCII model.
 //
+// The text is kept in a |TextRope|, so that edits and conversions to UTF-8
+// stay cheap for long texts.
+//
 // Ignores special states like "insert mode" for now.
 class TextInputModel {
  public:
@@ -207,7 +211,7 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
-  std::u16string text_;
+  TextRope text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
@@ -0,0 +1,287 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_rope.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns true if |code_unit| is a leading surrogate of a surrogate pair.
+bool IsLeadingSurrogate(char32_t code_unit) {
+  return (code_unit & 0xFFFFFC00) == 0xD800;
+}
+
+// Returns true if |code_unit| is a trailing surrogate of a surrogate pair.
+bool IsTrailingSurrogate(char32_t code_unit) {
+  return (code_unit & 0xFFFFFC00) == 0xDC00;
+}
+
+// Decodes the code point at |text[*index]| and advances |*index| past it.
+char32_t NextCodePoint(const char16_t* text, size_t length, size_t* index) {
+  char32_t code_point = text[(*index)++];
+  if (IsLeadingSurrogate(code_point) && *index < length &&
+      IsTrailingSurrogate(text[*index])) {
+    char32_t trailing = text[(*index)++];
+    return 0x10000 + ((code_point - 0xD800) << 10) + (trailing - 0xDC00);
+  }
+  if (IsLeadingSurrogate(code_point) || IsTrailingSurrogate(code_point)) {
+    return 0xFFFD;
+  }
+  return code_point;
+}
+
+size_t Utf8Length(char32_t code_point) {
+  if (code_point < 0x80) {
+    return 1;
+  }
+  if (code_point < 0x800) {
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    return 3;
+  }
+  return 4;
+}
+
+size_t Utf8Length(const char16_t* text, size_t length) {
+  size_t utf8_length = 0;
+  for (size_t index = 0; index < length;) {
+    utf8_length += Utf8Length(NextCodePoint(text, length, &index));
+  }
+  return utf8_length;
+}
+
+void AppendUtf8(const std::u16string& text, std::string& utf8) {
+  for (size_t index = 0; index < text.size();) {
+    char32_t code_point = NextCodePoint(text.data(), text.size(), &index);
+    switch (Utf8Length(code_point)) {
+      case 1:
+        utf8.push_back(static_cast<char>(code_point));
+        break;
+      case 2:
+        utf8.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        utf8.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        break;
+      case 3:
+        utf8.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        utf8.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        utf8.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        break;
+      default:
+        utf8.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        utf8.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        utf8.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        utf8.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+TextRope::Chunk::Chunk(std::u16string text) : text(std::move(text)) {}
+
+const std::string& TextRope::Chunk::utf8() const {
+  if (!utf8_valid) {
+    utf8_cache.clear();
+    AppendUtf8(text, utf8_cache);
+    utf8_valid = true;
+  }
+  return utf8_cache;
+}
+
+TextRope::TextRope() = default;
+
+TextRope::TextRope(const std::u16string& text) {
+  Insert(0, text);
+}
+
+TextRope::~TextRope() = default;
+
+TextRope::TextRope(TextRope&&) = default;
+
+TextRope& TextRope::operator=(TextRope&&) = default;
+
+char16_t TextRope::at(size_t position) const {
+  FML_DCHECK(position < length_);
+  size_t index = FindChunk(position);
+  return chunks_[index].text[position - offsets_[index]];
+}
+
+void TextRope::Insert(size_t position, const std::u16string& text) {
+  FML_DCHECK(position <= length_);
+  if (text.empty()) {
+    return;
+  }
+  size_t index;
+  size_t offset;
+  if (chunks_.empty()) {
+    chunks_.emplace_back(std::u16string());
+    offsets_.push_back(0);
+    index = 0;
+    offset = 0;
+  } else if (position >= length_) {
+    index = chunks_.size() - 1;
+    offset = chunks_[index].text.size();
+  } else {
+    index = FindChunk(position);
+    offset = position - offsets_[index];
+  }
+  Chunk& chunk = chunks_[index];
+  chunk.text.insert(offset, text);
+  chunk.utf8_valid = false;
+  length_ += text.size();
+  size_t count = SplitChunk(index);
+  Normalize(index, index + count - 1);
+}
+
+void TextRope::Erase(size_t position, size_t count) {
+  if (position >= length_ || count == 0) {
+    return;
+  }
+  count = std::min(count, length_ - position);
+  const size_t first = FindChunk(position);
+  size_t offset = position - offsets_[first];
+  size_t index = first;
+  for (size_t remaining = count; remaining > 0; index++) {
+    Chunk& chunk = chunks_[index];
+    size_t erased = std::min(remaining, chunk.text.size() - offset);
+    chunk.text.erase(offset, erased);
+    chunk.utf8_valid = false;
+    remaining -= erased;
+    offset = 0;
+  }
+  length_ -= count;
+  Normalize(first, index - 1);
+}
+
+void TextRope::Replace(size_t position,
+                       size_t count,
+                       const std::u16string& text) {
+  Erase(position, count);
+  Insert(position, text);
+}
+
+std::u16string TextRope::ToUtf16() const {
+  std::u16string text;
+  text.reserve(length_);
+  for (const Chunk& chunk : chunks_) {
+    text += chunk.text;
+  }
+  return text;
+}
+
+std::string TextRope::ToUtf8() const {
+  size_t utf8_length = 0;
+  for (const Chunk& chunk : chunks_) {
+    utf8_length += chunk.utf8().size();
+  }
+  std::string text;
+  text.reserve(utf8_length);
+  for (const Chunk& chunk : chunks_) {
+    text += chunk.utf8_cache;
+  }
+  return text;
+}
+
+size_t TextRope::Utf8Offset(size_t position) const {
+  size_t index = position < length_ ? FindChunk(position) : chunks_.size();
+  size_t utf8_offset = 0;
+  for (size_t i = 0; i < index; i++) {
+    utf8_offset += chunks_[i].utf8().size();
+  }
+  if (index < chunks_.size()) {
+    utf8_offset +=
+        Utf8Length(chunks_[index].text.data(), position - offsets_[index]);
+  }
+  return utf8_offset;
+}
+
+size_t TextRope::FindChunk(size_t position) const {
+  FML_DCHECK(position < length_);
+  auto iter = std::upper_bound(offsets_.begin(), offsets_.end(), position);
+  return std::distance(offsets_.begin(), iter) - 1;
+}
+
+size_t TextRope::SplitChunk(size_t index) {
+  if (chunks_[index].text.size() <= kMaxChunkLength) {
+    return 1;
+  }
+  const std::u16string text = std::move(chunks_[index].text);
+  std::vector<Chunk> pieces;
+  for (size_t start = 0; start < text.size();) {
+    size_t end = std::min(start + kMaxChunkLength / 2, text.size());
+    if (end < text.size() && IsLeadingSurrogate(text[end - 1]) &&
+        IsTrailingSurrogate(text[end])) {
+      end++;
+    }
+    pieces.emplace_back(text.substr(start, end - start));
+    start = end;
+  }
+  chunks_.erase(chunks_.begin() + index);
+  chunks_.insert(chunks_.begin() + index,
+                 std::make_move_iterator(pieces.begin()),
+                 std::make_move_iterator(pieces.end()));
+  return pieces.size();
+}
+
+void TextRope::Normalize(size_t first, size_t last) {
+  const size_t begin = first > 0 ? first - 1 : 0;
+  size_t end = std::min(last + 2, chunks_.size());
+
+  // Erasures can empty any number of chunks, so they are removed at once.
+  auto removed =
+      std::remove_if(chunks_.begin() + begin, chunks_.begin() + end,
+                     [](const Chunk& chunk) { return chunk.text.empty(); });
+  size_t removed_count = std::distance(removed, chunks_.begin() + end);
+  chunks_.erase(removed, chunks_.begin() + end);
+  end -= removed_count;
+
+  for (size_t i = begin; i + 1 < end;) {
+    Chunk& chunk = chunks_[i];
+    Chunk& next = chunks_[i + 1];
+    // Merging only up to half the maximum length keeps the number of chunks
+    // proportional to the length of the text, without merging chunks that
+    // were just split.
+    if (chunk.text.size() + next.text.size() <= kMaxChunkLength / 2) {
+      chunk.text += next.text;
+      chunk.utf8_valid = false;
+      chunks_.erase(chunks_.begin() + i + 1);
+      end--;
+      continue;
+    }
+    if (IsLeadingSurrogate(chunk.text.back()) &&
+        IsTrailingSurrogate(next.text.front())) {
+      chunk.text.push_back(next.text.front());
+      chunk.utf8_valid = false;
+      next.text.erase(0, 1);
+      next.utf8_valid = false;
+      if (next.text.empty()) {
+        chunks_.erase(chunks_.begin() + i + 1);
+        end--;
+        continue;
+      }
+    }
+    i++;
+  }
+  UpdateOffsets(begin);
+}
+
+void TextRope::UpdateOffsets(size_t index) {
+  offsets_.resize(chunks_.size());
+  size_t offset =
+      index > 0 ? offsets_[index - 1] + chunks_[index - 1].text.size() : 0;
+  for (size_t i = index; i < chunks_.size(); i++) {
+    offsets_[i] = offset;
+    offset += chunks_[i].text.size();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_ROPE_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_ROPE_H_
+
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+// A UTF-16 string that is stored as a sequence of short chunks, so that
+// editing a long text doesn't move all of it.
+//
+// Positions are found with a binary search over the offsets of the chunks.
+// An edit only copies the chunks it touches and then updates the offsets of
+// the chunks after it. Each chunk caches its UTF-8 encoding, so converting
+// the text to UTF-8 after an edit only encodes the chunks that changed.
+//
+// Chunk boundaries never split a surrogate pair.
+class TextRope {
+ public:
+  // The maximum number of UTF-16 code units in a chunk.
+  static constexpr size_t kMaxChunkLength = 1024;
+
+  TextRope();
+  explicit TextRope(const std::u16string& text);
+  ~TextRope();
+
+  TextRope(TextRope&&);
+  TextRope& operator=(TextRope&&);
+
+  // The number of UTF-16 code units in the text.
+  size_t length() const { return length_; }
+
+  bool empty() const { return length_ == 0; }
+
+  // Returns the code unit at |position|, which must be less than |length|.
+  char16_t at(size_t position) const;
+
+  // Inserts |text| before |position|.
+  void Insert(size_t position, const std::u16string& text);
+
+  // Erases up to |count| code units starting at |position|.
+  void Erase(size_t position, size_t count);
+
+  // Replaces up to |count| code units starting at |position| with |text|.
+  void Replace(size_t position, size_t count, const std::u16string& text);
+
+  // Returns the text as UTF-16.
+  std::u16string ToUtf16() const;
+
+  // Returns the text as UTF-8. Unpaired surrogates are encoded as U+FFFD.
+  std::string ToUtf8() const;
+
+  // Returns the offset in |ToUtf8| that corresponds to the UTF-16 offset
+  // |position|.
+  size_t Utf8Offset(size_t position) const;
+
+  // The number of chunks the text is stored in.
+  size_t chunk_count() const { return chunks_.size(); }
+
+ private:
+  struct Chunk {
+    explicit Chunk(std::u16string text);
+
+    const std::string& utf8() const;
+
+    std::u16string text;
+
+    // The UTF-8 encoding of |text|, filled in when first needed and cleared
+    // whenever |text| changes.
+    mutable std::string utf8_cache;
+    mutable bool utf8_valid = false;
+  };
+
+  // Returns the index of the chunk that contains |position|, which must be
+  // less than |length|.
+  size_t FindChunk(size_t position) const;
+
+  // Splits chunk |index| into chunks of at most half the maximum length if it
+  // grew past the maximum length. Returns the number of chunks it became.
+  size_t SplitChunk(size_t index);
+
+  // Removes empty chunks, merges short neighbors and moves trailing
+  // surrogates that were separated from their leading surrogates, for the
+  // chunks in [first, last] and their neighbors, then updates the offsets.
+  void Normalize(size_t first, size_t last);
+
+  // Recomputes the offsets of the chunks from |index| on.
+  void UpdateOffsets(size_t index);
+
+  std::vector<Chunk> chunks_;
+  // The offset of each chunk in the text.
+  std::vector<size_t> offsets_;
+  size_t length_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_ROPE_H_
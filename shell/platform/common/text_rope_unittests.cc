@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_rope.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextRope, Empty) {
+  TextRope rope;
+  EXPECT_TRUE(rope.empty());
+  EXPECT_EQ(rope.length(), 0u);
+  EXPECT_EQ(rope.ToUtf8(), "");
+  EXPECT_EQ(rope.Utf8Offset(0), 0u);
+  EXPECT_EQ(rope.chunk_count(), 0u);
+}
+
+TEST(TextRope, InsertAndErase) {
+  TextRope rope(u"ACE");
+  rope.Insert(1, u"B");
+  rope.Insert(3, u"D");
+  rope.Insert(5, u"F");
+  EXPECT_EQ(rope.ToUtf16(), u"ABCDEF");
+  EXPECT_EQ(rope.at(2), u'C');
+
+  rope.Erase(1, 2);
+  EXPECT_EQ(rope.ToUtf16(), u"ADEF");
+  rope.Erase(2, 10);
+  EXPECT_EQ(rope.ToUtf16(), u"AD");
+  rope.Replace(0, 1, u"XY");
+  EXPECT_EQ(rope.ToUtf16(), u"XYD");
+}
+
+TEST(TextRope, ConvertsToUtf8) {
+  TextRope rope(u"aé中\U0001F604");
+  EXPECT_EQ(rope.ToUtf8(), "aé中\U0001F604");
+  EXPECT_EQ(rope.Utf8Offset(1), 1u);
+  EXPECT_EQ(rope.Utf8Offset(2), 3u);
+  EXPECT_EQ(rope.Utf8Offset(3), 6u);
+  EXPECT_EQ(rope.Utf8Offset(5), 10u);
+}
+
+TEST(TextRope, EncodesUnpairedSurrogatesAsReplacementCharacters) {
+  std::u16string text = u"a";
+  text.push_back(0xD83D);
+  text.push_back(u'b');
+  TextRope rope(text);
+  EXPECT_EQ(rope.ToUtf8(), "a�b");
+}
+
+TEST(TextRope, SplitsLongTextIntoChunks) {
+  std::u16string text(TextRope::kMaxChunkLength * 4, u'x');
+  TextRope rope(text);
+  EXPECT_GT(rope.chunk_count(), 4u);
+  EXPECT_EQ(rope.ToUtf16(), text);
+
+  rope.Erase(0, rope.length());
+  EXPECT_TRUE(rope.empty());
+  EXPECT_EQ(rope.chunk_count(), 0u);
+}
+
+TEST(TextRope, KeepsSurrogatePairsInOneChunk) {
+  // Puts a surrogate pair where the text would be split.
+  std::u16string text(TextRope::kMaxChunkLength / 2 - 1, u'x');
+  text += u"\U0001F604";
+  text += std::u16string(TextRope::kMaxChunkLength, u'x');
+  TextRope rope(text);
+  EXPECT_EQ(rope.ToUtf8().substr(TextRope::kMaxChunkLength / 2 - 1, 4),
+            "\U0001F604");
+
+  // Joins a leading and a trailing surrogate from different chunks.
+  std::u16string joined(TextRope::kMaxChunkLength, u'y');
+  joined.push_back(0xD83D);
+  joined += std::u16string(TextRope::kMaxChunkLength, u'z');
+  joined.push_back(0xDE04);
+  TextRope joined_rope(joined);
+  joined_rope.Erase(TextRope::kMaxChunkLength + 1, TextRope::kMaxChunkLength);
+  EXPECT_EQ(joined_rope.ToUtf8(),
+            std::string(TextRope::kMaxChunkLength, 'y') + "\U0001F604");
+}
+
+TEST(TextRope, MatchesStringEdits) {
+  std::mt19937 random(42);
+  std::u16string expected;
+  TextRope rope;
+  for (int i = 0; i < 2000; i++) {
+    size_t position = expected.empty() ? 0 : random() % (expected.size() + 1);
+    if (random() % 3 == 0 && !expected.empty()) {
+      size_t count = random() % 3000;
+      rope.Erase(position, count);
+      if (position < expected.size()) {
+        expected.erase(position, count);
+      }
+    } else {
+      std::u16string text(random() % 700, static_cast<char16_t>(u'a' + i % 26));
+      rope.Insert(position, text);
+      expected.insert(position, text);
+    }
+    ASSERT_EQ(rope.length(), expected.size());
+    if (!expected.empty()) {
+      size_t index = random() % expected.size();
+      ASSERT_EQ(rope.at(index), expected[index]);
+      ASSERT_EQ(rope.Utf8Offset(index), index);
+    }
+  }
+  EXPECT_EQ(rope.ToUtf16(), expected);
+  EXPECT_LE(rope.chunk_count(),
+            expected.size() * 4 / TextRope::kMaxChunkLength + 1);
+}
+
+}  // namespace flutter
@@ -38,6 +38,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_statistics.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
@@ -386,9 +387,32 @@ InferSoftwarePlatformViewCreationCallback(
     return ptr(user_data, allocation, row_bytes, height);
   };
 
+  std::function<bool(const void*, size_t, size_t,
+                     const std::vector<SkIRect>&)>
+      software_present_backing_store_damage;
+  if (auto ptr = SAFE_ACCESS(&config->software,
+                             surface_present_damage_callback, nullptr)) {
+    software_present_backing_store_damage =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height,
+                         const std::vector<SkIRect>& damage) -> bool {
+      std::vector<FlutterRect> rects;
+      rects.reserve(damage.size());
+      for (const auto& rect : damage) {
+        rects.push_back({static_cast<double>(rect.left()),
+                         static_cast<double>(rect.top()),
+                         static_cast<double>(rect.right()),
+                         static_cast<double>(rect.bottom())});
+      }
+      return ptr(user_data, allocation, row_bytes, height, rects.data(),
+                 rects.size());
+    };
+  }
+
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,         // required
+          software_present_backing_store_damage,  // optional
       };
 
   return fml::MakeCopyable(
@@ -1249,6 +1273,28 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   external_texture_resolver = std::make_unique<ExternalTextureResolver>(
       external_texture_metal_callback);
 #endif
+  if (config->type == kSoftware) {
+    flutter::EmbedderExternalTextureSoftware::ExternalTextureCallback
+        external_texture_software_callback;
+    const FlutterSoftwareRendererConfig* software_config = &config->software;
+    if (SAFE_ACCESS(software_config, external_texture_frame_callback,
+                    nullptr)) {
+      external_texture_software_callback =
+          [ptr = software_config->external_texture_frame_callback, user_data](
+              int64_t texture_identifier, size_t width, size_t height)
+          -> std::unique_ptr<FlutterSoftwareExternalTexture> {
+        std::unique_ptr<FlutterSoftwareExternalTexture> texture =
+            std::make_unique<FlutterSoftwareExternalTexture>();
+        texture->struct_size = sizeof(FlutterSoftwareExternalTexture);
+        if (!ptr(user_data, texture_identifier, width, height, texture.get())) {
+          return nullptr;
+        }
+        return texture;
+      };
+    }
+    external_texture_resolver = std::make_unique<ExternalTextureResolver>(
+        external_texture_software_callback);
+  }
 
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
@@ -2279,6 +2325,65 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
   }
 }
 
+static bool PopulateFramePhaseStatistics(
+    const flutter::FrameStatistics& statistics,
+    flutter::FramePhase phase,
+    FlutterFramePhaseStatistics* out) {
+  if (!STRUCT_HAS_MEMBER(out, janky_frame_count)) {
+    return false;
+  }
+  const auto summary = statistics.GetPhaseSummary(phase);
+  out->frame_count = summary.count;
+  out->p50_nanos = summary.p50.ToNanoseconds();
+  out->p90_nanos = summary.p90.ToNanoseconds();
+  out->p99_nanos = summary.p99.ToNanoseconds();
+  out->max_nanos = summary.max.ToNanoseconds();
+  out->mean_nanos = summary.mean.ToNanoseconds();
+  out->janky_frame_count = summary.janky_frames;
+  return true;
+}
+
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr || !STRUCT_HAS_MEMBER(statistics, raster_cache)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame statistics specified.");
+  }
+
+  auto frame_statistics = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                              ->GetShell()
+                              .GetFrameStatistics();
+  if (!frame_statistics) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Frame statistics are not available.");
+  }
+
+  statistics->frame_count = frame_statistics->GetFrameCount();
+  statistics->janky_frame_count = frame_statistics->GetJankyFrameCount();
+  if (!PopulateFramePhaseStatistics(*frame_statistics,
+                                    flutter::FramePhase::kVsyncLatency,
+                                    &statistics->vsync_latency) ||
+      !PopulateFramePhaseStatistics(*frame_statistics,
+                                    flutter::FramePhase::kBuild,
+                                    &statistics->build) ||
+      !PopulateFramePhaseStatistics(*frame_statistics,
+                                    flutter::FramePhase::kRaster,
+                                    &statistics->raster) ||
+      !PopulateFramePhaseStatistics(*frame_statistics,
+                                    flutter::FramePhase::kRasterCache,
+                                    &statistics->raster_cache)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame phase statistics specified.");
+  }
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -2329,6 +2434,7 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(GetFrameStatistics, FlutterEngineGetFrameStatistics);
 #undef SET_PROC
 
   return kSuccess;
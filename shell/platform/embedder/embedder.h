@@ -540,6 +540,68 @@ typedef struct {
   FlutterMetalTextureFrameCallback external_texture_frame_callback;
 } FlutterMetalRendererConfig;
 
+typedef bool (*SoftwareSurfacePresentDamageCallback)(
+    void* /* user data */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */,
+    const FlutterRect* /* damage rects */,
+    size_t /* damage rect count */);
+
+/// Pixel format of a software external texture.
+typedef enum {
+  /// A single plane of 32-bit pixels, with 8-bit red, green, blue and alpha
+  /// channels in that order in memory. Alpha is premultiplied.
+  kFlutterSoftwarePixelFormatRGBA8888,
+  /// Three planes of 8-bit samples: luma (Y), followed by the blue (U) and red
+  /// (V) chroma planes subsampled by 2 in both directions.
+  kFlutterSoftwarePixelFormatI420,
+  /// Two planes of 8-bit samples: luma (Y), followed by a plane of interleaved
+  /// blue and red (UV) chroma samples subsampled by 2 in both directions.
+  kFlutterSoftwarePixelFormatNV12,
+} FlutterSoftwarePixelFormat;
+
+/// The maximum number of planes of a software external texture.
+#define FLUTTER_SOFTWARE_EXTERNAL_TEXTURE_MAX_PLANES 3
+
+/// A pixel buffer handed over to the engine by the embedder.
+///
+/// RGBA pixel buffers are drawn directly from the embedder's memory without
+/// being copied. YUV pixel buffers are converted to RGBA once per frame. Their
+/// samples are expected in the BT.601 limited range, as usually produced by
+/// video decoders.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareExternalTexture).
+  size_t struct_size;
+  FlutterSoftwarePixelFormat pixel_format;
+  /// Width of the pixel buffer, in pixels.
+  size_t width;
+  /// Height of the pixel buffer, in pixels.
+  size_t height;
+  /// The planes of the pixel buffer, in the order given by the pixel format.
+  /// Unused planes must be null.
+  const uint8_t* planes[FLUTTER_SOFTWARE_EXTERNAL_TEXTURE_MAX_PLANES];
+  /// The number of bytes between the starts of two consecutive rows of each
+  /// plane.
+  size_t row_bytes[FLUTTER_SOFTWARE_EXTERNAL_TEXTURE_MAX_PLANES];
+  /// User data passed to the release callback.
+  void* user_data;
+  /// Called once the engine no longer accesses the pixel buffer. This may be
+  /// called on any thread, including before the frame callback returns if the
+  /// pixel buffer is invalid.
+  VoidCallback release_callback;
+} FlutterSoftwareExternalTexture;
+
+/// Callback to provide the most recent pixel buffer of a software external
+/// texture. The width and height are the size the texture is going to be drawn
+/// at, and are only a hint. Returning false keeps the previous pixel buffer.
+typedef bool (*FlutterSoftwareTextureFrameCallback)(
+    void* /* user data */,
+    int64_t /* texture identifier */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterSoftwareExternalTexture* /* texture out */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -548,6 +610,22 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Optional. If specified, the buffer presented to the embedder keeps the
+  /// contents of the previously presented frame and the engine only repaints
+  /// the parts of the frame that changed. Frames are then presented with this
+  /// callback instead of `surface_present_callback`, along with the
+  /// non-overlapping rects of the buffer that changed since the previous
+  /// frame. The buffer always holds the whole frame. The rects are owned by
+  /// the engine and are only valid for the duration of the callback.
+  ///
+  /// Partial repaint is only available in debug builds of the engine. Other
+  /// builds repaint and present every frame in full with
+  /// `surface_present_callback`.
+  SoftwareSurfacePresentDamageCallback surface_present_damage_callback;
+  /// Optional. When the embedder marks a frame of an external texture as
+  /// available, this callback is invoked the next time the texture is drawn
+  /// to obtain the pixel buffer of the new frame.
+  FlutterSoftwareTextureFrameCallback external_texture_frame_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1202,6 +1280,41 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// Summarizes the time rasterized frames spent in one phase of the frame
+/// pipeline. All durations are in nanoseconds. Percentiles are accurate to
+/// within about 3%.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFramePhaseStatistics).
+  size_t struct_size;
+  /// The number of frames recorded.
+  uint64_t frame_count;
+  uint64_t p50_nanos;
+  uint64_t p90_nanos;
+  uint64_t p99_nanos;
+  uint64_t max_nanos;
+  uint64_t mean_nanos;
+  /// The number of janky frames that spent most of their time in this phase.
+  uint64_t janky_frame_count;
+} FlutterFramePhaseStatistics;
+
+/// Statistics about the frames rasterized by an engine since it was started. A
+/// frame is janky if it took longer than the frame budget from the vsync
+/// signal to the end of its rasterization.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameStatistics).
+  size_t struct_size;
+  uint64_t frame_count;
+  uint64_t janky_frame_count;
+  /// From the vsync signal to the start of the frame build on the UI thread.
+  FlutterFramePhaseStatistics vsync_latency;
+  /// The frame build on the UI thread.
+  FlutterFramePhaseStatistics build;
+  /// The rasterization of the frame, including the raster cache preparation.
+  FlutterFramePhaseStatistics raster;
+  /// The time spent populating the raster cache during rasterization.
+  FlutterFramePhaseStatistics raster_cache;
+} FlutterFrameStatistics;
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -1713,6 +1826,20 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterWindowMetricsEvent* event);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of pointer events to the engine. The events are
+///             converted and handed to the framework together, so embedders
+///             should send the events they receive together, such as the
+///             historical samples of a stylus or mouse, in one call rather
+///             than one call per event. While the UI thread is still busy with
+///             earlier events, moves of the same pointer may be merged.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The pointer events, in the order they happened.
+/// @param[in]  events_count  The number of events in `events`.
+///
+/// @return     The result of the call to send the pointer events.
+///
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2225,6 +2352,21 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the per-phase timing statistics of the frames rasterized by
+///             a running engine instance. This may be called on any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics to fill in. The struct_size of the
+///                         statistics and of each of its phases must be set.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2341,6 +2483,9 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineGetFrameStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2385,6 +2530,7 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineGetFrameStatisticsFnPtr GetFrameStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -8,6 +8,10 @@
 
 namespace flutter {
 
+EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
+    EmbedderExternalTextureSoftware::ExternalTextureCallback software_callback)
+    : software_callback_(software_callback) {}
+
 #ifdef SHELL_ENABLE_GL
 EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
     EmbedderExternalTextureGL::ExternalTextureCallback gl_callback)
@@ -22,6 +26,11 @@ EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
 
 std::unique_ptr<Texture>
 EmbedderExternalTextureResolver::ResolveExternalTexture(int64_t texture_id) {
+  if (software_callback_) {
+    return std::make_unique<EmbedderExternalTextureSoftware>(
+        texture_id, software_callback_);
+  }
+
 #ifdef SHELL_ENABLE_GL
   if (gl_callback_) {
     return std::make_unique<EmbedderExternalTextureGL>(texture_id,
@@ -40,6 +49,10 @@ EmbedderExternalTextureResolver::ResolveExternalTexture(int64_t texture_id) {
 }
 
 bool EmbedderExternalTextureResolver::SupportsExternalTextures() {
+  if (software_callback_) {
+    return true;
+  }
+
 #ifdef SHELL_ENABLE_GL
   if (gl_callback_) {
     return true;
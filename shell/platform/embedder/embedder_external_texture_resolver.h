@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/shell/platform/embedder/embedder_external_texture_software.h"
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
@@ -24,6 +25,10 @@ class EmbedderExternalTextureResolver {
 
   ~EmbedderExternalTextureResolver() = default;
 
+  explicit EmbedderExternalTextureResolver(
+      EmbedderExternalTextureSoftware::ExternalTextureCallback
+          software_callback);
+
 #ifdef SHELL_ENABLE_GL
   explicit EmbedderExternalTextureResolver(
       EmbedderExternalTextureGL::ExternalTextureCallback gl_callback);
@@ -39,6 +44,8 @@ class EmbedderExternalTextureResolver {
   bool SupportsExternalTextures();
 
  private:
+  EmbedderExternalTextureSoftware::ExternalTextureCallback software_callback_;
+
 #ifdef SHELL_ENABLE_GL
   EmbedderExternalTextureGL::ExternalTextureCallback gl_callback_;
 #endif
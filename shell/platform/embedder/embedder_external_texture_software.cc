@@ -0,0 +1,295 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_external_texture_software.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+namespace {
+
+// Calls the release callback of a pixel buffer when it goes out of scope.
+class ScopedPixelBufferRelease {
+ public:
+  explicit ScopedPixelBufferRelease(
+      const FlutterSoftwareExternalTexture& texture)
+      : texture_(texture) {}
+
+  ~ScopedPixelBufferRelease() {
+    if (texture_.release_callback) {
+      texture_.release_callback(texture_.user_data);
+    }
+  }
+
+ private:
+  const FlutterSoftwareExternalTexture& texture_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedPixelBufferRelease);
+};
+
+size_t NumPlanes(FlutterSoftwarePixelFormat pixel_format) {
+  switch (pixel_format) {
+    case kFlutterSoftwarePixelFormatRGBA8888:
+      return 1;
+    case kFlutterSoftwarePixelFormatI420:
+      return 3;
+    case kFlutterSoftwarePixelFormatNV12:
+      return 2;
+  }
+  return 0;
+}
+
+// The minimum number of bytes in a row of the given plane.
+size_t MinRowBytes(FlutterSoftwarePixelFormat pixel_format,
+                   size_t plane,
+                   size_t width) {
+  const size_t chroma_width = (width + 1) / 2;
+  switch (pixel_format) {
+    case kFlutterSoftwarePixelFormatRGBA8888:
+      return width * 4;
+    case kFlutterSoftwarePixelFormatI420:
+      return plane == 0 ? width : chroma_width;
+    case kFlutterSoftwarePixelFormatNV12:
+      return plane == 0 ? width : chroma_width * 2;
+  }
+  return 0;
+}
+
+bool IsValidPixelBuffer(const FlutterSoftwareExternalTexture& texture) {
+  if (texture.struct_size < sizeof(FlutterSoftwareExternalTexture)) {
+    FML_LOG(ERROR) << "Invalid software external texture struct size.";
+    return false;
+  }
+  const size_t num_planes = NumPlanes(texture.pixel_format);
+  if (num_planes == 0) {
+    FML_LOG(ERROR) << "Unknown software external texture pixel format.";
+    return false;
+  }
+  if (texture.width == 0 || texture.height == 0) {
+    FML_LOG(ERROR) << "Software external texture has an empty size.";
+    return false;
+  }
+  for (size_t plane = 0; plane < num_planes; plane++) {
+    if (texture.planes[plane] == nullptr ||
+        texture.row_bytes[plane] <
+            MinRowBytes(texture.pixel_format, plane, texture.width)) {
+      FML_LOG(ERROR) << "Software external texture plane " << plane
+                     << " is missing or too small.";
+      return false;
+    }
+  }
+  return true;
+}
+
+struct RasterReleaseContext {
+  VoidCallback release_callback;
+  void* user_data;
+};
+
+void ReleaseRasterPixels(const void* pixels, void* context) {
+  auto release_context = static_cast<RasterReleaseContext*>(context);
+  if (release_context->release_callback) {
+    release_context->release_callback(release_context->user_data);
+  }
+  delete release_context;
+}
+
+// Fixed point BT.601 limited range coefficients, scaled by 1 << 10.
+constexpr int32_t kYScale = 1192;
+constexpr int32_t kVToR = 1634;
+constexpr int32_t kVToG = 833;
+constexpr int32_t kUToG = 401;
+constexpr int32_t kUToB = 2066;
+
+inline uint8_t ClampToByte(int32_t value) {
+  return static_cast<uint8_t>(
+      std::min(std::max(value + (1 << 9), 0), 255 << 10) >> 10);
+}
+
+inline void WritePixel(int32_t y,
+                       int32_t r_offset,
+                       int32_t g_offset,
+                       int32_t b_offset,
+                       uint8_t* rgba) {
+  const int32_t luma = (y - 16) * kYScale;
+  rgba[0] = ClampToByte(luma + r_offset);
+  rgba[1] = ClampToByte(luma + g_offset);
+  rgba[2] = ClampToByte(luma + b_offset);
+  rgba[3] = 255;
+}
+
+}  // namespace
+
+EmbedderExternalTextureSoftware::EmbedderExternalTextureSoftware(
+    int64_t texture_identifier,
+    const ExternalTextureCallback& callback)
+    : Texture(texture_identifier), external_texture_callback_(callback) {
+  FML_DCHECK(external_texture_callback_);
+}
+
+EmbedderExternalTextureSoftware::~EmbedderExternalTextureSoftware() = default;
+
+// |flutter::Texture|
+void EmbedderExternalTextureSoftware::Paint(SkCanvas& canvas,
+                                            const SkRect& bounds,
+                                            bool freeze,
+                                            GrDirectContext* context,
+                                            const SkSamplingOptions& sampling) {
+  if (!freeze && new_frame_available_) {
+    if (auto image = ResolveTexture(
+            Id(), SkISize::Make(bounds.width(), bounds.height()))) {
+      last_image_ = image;
+      new_frame_available_ = false;
+    }
+  }
+
+  if (last_image_) {
+    if (bounds != SkRect::Make(last_image_->bounds())) {
+      canvas.drawImageRect(last_image_, bounds, sampling);
+    } else {
+      canvas.drawImage(last_image_, bounds.x(), bounds.y(), sampling, nullptr);
+    }
+  }
+}
+
+sk_sp<SkImage> EmbedderExternalTextureSoftware::ResolveTexture(
+    int64_t texture_id,
+    const SkISize& size) {
+  std::unique_ptr<FlutterSoftwareExternalTexture> texture =
+      external_texture_callback_(texture_id, size.width(), size.height());
+
+  if (!texture) {
+    return nullptr;
+  }
+
+  if (!IsValidPixelBuffer(*texture)) {
+    ScopedPixelBufferRelease release(*texture);
+    return nullptr;
+  }
+
+  if (texture->pixel_format == kFlutterSoftwarePixelFormatRGBA8888) {
+    return WrapRGBA(std::move(texture));
+  }
+
+  ScopedPixelBufferRelease release(*texture);
+  return ConvertYUV(*texture);
+}
+
+sk_sp<SkImage> EmbedderExternalTextureSoftware::WrapRGBA(
+    std::unique_ptr<FlutterSoftwareExternalTexture> texture) {
+  const auto info =
+      SkImageInfo::Make(texture->width, texture->height, kRGBA_8888_SkColorType,
+                        kPremul_SkAlphaType);
+  SkPixmap pixmap(info, texture->planes[0], texture->row_bytes[0]);
+  auto release_context =
+      new RasterReleaseContext{texture->release_callback, texture->user_data};
+  auto image =
+      SkImage::MakeFromRaster(pixmap, &ReleaseRasterPixels, release_context);
+  if (!image) {
+    // Skia only takes ownership of the pixels once the image is created.
+    ReleaseRasterPixels(texture->planes[0], release_context);
+    FML_LOG(ERROR) << "Could not wrap the software external texture.";
+  }
+  return image;
+}
+
+sk_sp<SkImage> EmbedderExternalTextureSoftware::ConvertYUV(
+    const FlutterSoftwareExternalTexture& texture) {
+  const auto info = SkImageInfo::Make(texture.width, texture.height,
+                                      kRGBA_8888_SkColorType,
+                                      kOpaque_SkAlphaType);
+  const size_t row_bytes = info.minRowBytes();
+  const size_t byte_size = info.computeByteSize(row_bytes);
+
+  // The buffer is only written to when the previous frame's image, which
+  // this texture holds the last reference to, can be dropped first.
+  last_image_.reset();
+  if (!conversion_buffer_ || !conversion_buffer_->unique() ||
+      conversion_buffer_->size() != byte_size) {
+    conversion_buffer_ = SkData::MakeUninitialized(byte_size);
+  }
+  auto rgba = static_cast<uint8_t*>(conversion_buffer_->writable_data());
+
+  if (texture.pixel_format == kFlutterSoftwarePixelFormatI420) {
+    ConvertYUVToRGBA(texture.planes[0], texture.row_bytes[0],  // Y
+                     texture.planes[1], texture.planes[2],     // U, V
+                     texture.row_bytes[1],                     //
+                     1,                                        //
+                     texture.width, texture.height,            //
+                     rgba, row_bytes);
+  } else {
+    ConvertYUVToRGBA(texture.planes[0], texture.row_bytes[0],     // Y
+                     texture.planes[1], texture.planes[1] + 1,    // UV
+                     texture.row_bytes[1],                        //
+                     2,                                           //
+                     texture.width, texture.height,               //
+                     rgba, row_bytes);
+  }
+
+  return SkImage::MakeRasterData(info, conversion_buffer_, row_bytes);
+}
+
+void EmbedderExternalTextureSoftware::ConvertYUVToRGBA(
+    const uint8_t* y_plane,
+    size_t y_row_bytes,
+    const uint8_t* u_plane,
+    const uint8_t* v_plane,
+    size_t chroma_row_bytes,
+    size_t chroma_pixel_stride,
+    size_t width,
+    size_t height,
+    uint8_t* rgba,
+    size_t rgba_row_bytes) {
+  // Each chroma sample covers two pixels in each direction. The chroma terms
+  // are computed once for each pair of pixels of a row, which keeps the inner
+  // loop free of branches so that compilers can vectorize it.
+  for (size_t row = 0; row < height; row++) {
+    const uint8_t* y = y_plane + row * y_row_bytes;
+    const uint8_t* u = u_plane + (row / 2) * chroma_row_bytes;
+    const uint8_t* v = v_plane + (row / 2) * chroma_row_bytes;
+    uint8_t* out = rgba + row * rgba_row_bytes;
+
+    const size_t pairs = width / 2;
+    for (size_t pair = 0; pair < pairs; pair++) {
+      const int32_t cb = u[pair * chroma_pixel_stride] - 128;
+      const int32_t cr = v[pair * chroma_pixel_stride] - 128;
+      const int32_t r_offset = kVToR * cr;
+      const int32_t g_offset = -kVToG * cr - kUToG * cb;
+      const int32_t b_offset = kUToB * cb;
+      WritePixel(y[pair * 2], r_offset, g_offset, b_offset, out + pair * 8);
+      WritePixel(y[pair * 2 + 1], r_offset, g_offset, b_offset,
+                 out + pair * 8 + 4);
+    }
+
+    if (width % 2 != 0) {
+      const int32_t cb = u[pairs * chroma_pixel_stride] - 128;
+      const int32_t cr = v[pairs * chroma_pixel_stride] - 128;
+      WritePixel(y[width - 1], kVToR * cr, -kVToG * cr - kUToG * cb,
+                 kUToB * cb, out + (width - 1) * 4);
+    }
+  }
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureSoftware::OnGrContextCreated() {}
+
+// |flutter::Texture|
+void EmbedderExternalTextureSoftware::OnGrContextDestroyed() {}
+
+// |flutter::Texture|
+void EmbedderExternalTextureSoftware::MarkNewFrameAvailable() {
+  new_frame_available_ = true;
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureSoftware::OnTextureUnregistered() {
+  last_image_.reset();
+}
+
+}  // namespace flutter
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_SOFTWARE_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_SOFTWARE_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// An external texture backed by pixel buffers in the embedder's memory, for
+// use with the software renderer.
+//
+// RGBA pixel buffers are wrapped without copying them and released once the
+// image drawn from them goes away. YUV pixel buffers are converted to RGBA into
+// a buffer owned by the texture, which is reused across frames whenever no
+// image drawn from it is alive anymore, and released right after conversion.
+class EmbedderExternalTextureSoftware : public flutter::Texture {
+ public:
+  using ExternalTextureCallback = std::function<
+      std::unique_ptr<FlutterSoftwareExternalTexture>(int64_t, size_t, size_t)>;
+
+  EmbedderExternalTextureSoftware(int64_t texture_identifier,
+                                  const ExternalTextureCallback& callback);
+
+  ~EmbedderExternalTextureSoftware();
+
+  // Converts a frame of an I420 or NV12 pixel buffer to premultiplied RGBA.
+  // The chroma planes of NV12 pixel buffers are given as |u_plane| and
+  // |v_plane|, each pointing to the first sample of its kind, with
+  // |chroma_pixel_stride| set to 2.
+  static void ConvertYUVToRGBA(const uint8_t* y_plane,
+                               size_t y_row_bytes,
+                               const uint8_t* u_plane,
+                               const uint8_t* v_plane,
+                               size_t chroma_row_bytes,
+                               size_t chroma_pixel_stride,
+                               size_t width,
+                               size_t height,
+                               uint8_t* rgba,
+                               size_t rgba_row_bytes);
+
+ private:
+  const ExternalTextureCallback& external_texture_callback_;
+  sk_sp<SkImage> last_image_;
+  sk_sp<SkData> conversion_buffer_;
+  bool new_frame_available_ = true;
+
+  sk_sp<SkImage> ResolveTexture(int64_t texture_id, const SkISize& size);
+
+  sk_sp<SkImage> WrapRGBA(
+      std::unique_ptr<FlutterSoftwareExternalTexture> texture);
+
+  sk_sp<SkImage> ConvertYUV(const FlutterSoftwareExternalTexture& texture);
+
+  // |flutter::Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             const SkSamplingOptions& sampling) override;
+
+  // |flutter::Texture|
+  void OnGrContextCreated() override;
+
+  // |flutter::Texture|
+  void OnGrContextDestroyed() override;
+
+  // |flutter::Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |flutter::Texture|
+  void OnTextureUnregistered() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureSoftware);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_SOFTWARE_H_
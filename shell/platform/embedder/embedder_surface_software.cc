@@ -84,26 +84,69 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   }
 
   SkPixmap pixmap;
-  if (!backing_store->peekPixels(&pixmap)) {
+  if (!PeekBackingStorePixels(backing_store, &pixmap)) {
+    return false;
+  }
+
+  return software_dispatch_table_.software_present_backing_store(
+      pixmap.addr(),      //
+      pixmap.rowBytes(),  //
+      pixmap.height()     //
+  );
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::RetainsBackingStoreContents() const {
+  // The backing store is only recreated when its size changes.
+  return static_cast<bool>(
+      software_dispatch_table_.software_present_backing_store_damage);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::vector<SkIRect>& damage) {
+  if (!software_dispatch_table_.software_present_backing_store_damage) {
+    return PresentBackingStore(std::move(backing_store));
+  }
+
+  if (!IsValid()) {
+    FML_LOG(ERROR) << "Tried to present an invalid software surface.";
+    return false;
+  }
+
+  SkPixmap pixmap;
+  if (!PeekBackingStorePixels(backing_store, &pixmap)) {
+    return false;
+  }
+
+  return software_dispatch_table_.software_present_backing_store_damage(
+      pixmap.addr(),      //
+      pixmap.rowBytes(),  //
+      pixmap.height(),    //
+      damage              //
+  );
+}
+
+bool EmbedderSurfaceSoftware::PeekBackingStorePixels(
+    const sk_sp<SkSurface>& backing_store,
+    SkPixmap* pixmap) const {
+  if (!backing_store->peekPixels(pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
     return false;
   }
 
   // Some basic sanity checking.
-  uint64_t expected_pixmap_data_size = pixmap.width() * pixmap.height() * 4;
+  uint64_t expected_pixmap_data_size = pixmap->width() * pixmap->height() * 4;
 
-  const size_t pixmap_size = pixmap.computeByteSize();
+  const size_t pixmap_size = pixmap->computeByteSize();
 
   if (expected_pixmap_data_size != pixmap_size) {
     FML_LOG(ERROR) << "Software backing store had unexpected size.";
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  return true;
 }
 
 }  // namespace flutter
@@ -18,6 +18,11 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
         software_present_backing_store;  // required
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       const std::vector<SkIRect>& damage)>
+        software_present_backing_store_damage;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -47,6 +52,16 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  bool RetainsBackingStoreContents() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreDamage(sk_sp<SkSurface> backing_store,
+                                 const std::vector<SkIRect>& damage) override;
+
+  bool PeekBackingStorePixels(const sk_sp<SkSurface>& backing_store,
+                              SkPixmap* pixmap) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
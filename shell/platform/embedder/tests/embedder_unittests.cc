@@ -10,6 +10,7 @@
 
 #include "embedder.h"
 #include "embedder_engine.h"
+#include "embedder_external_texture_software.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
@@ -26,6 +27,7 @@
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -197,6 +199,90 @@ TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   ASSERT_LT((point2 - point1), fml::TimeDelta::FromMilliseconds(1));
 }
 
+TEST(EmbedderTestNoFixture, ConvertsYUVToRGBA) {
+  // 3x2 pixels, so that the last column has a chroma sample of its own.
+  const uint8_t y_plane[] = {16, 235, 81, 16, 235, 145};
+  // Neutral chroma for the first two columns, red for the last one.
+  const uint8_t u_plane[] = {128, 90};
+  const uint8_t v_plane[] = {128, 240};
+  const uint8_t uv_plane[] = {128, 128, 90, 240};
+
+  uint8_t i420[2 * 3 * 4] = {};
+  EmbedderExternalTextureSoftware::ConvertYUVToRGBA(
+      y_plane, 3, u_plane, v_plane, 2, 1, 3, 2, i420, 3 * 4);
+  uint8_t nv12[2 * 3 * 4] = {};
+  EmbedderExternalTextureSoftware::ConvertYUVToRGBA(
+      y_plane, 3, uv_plane, uv_plane + 1, 4, 2, 3, 2, nv12, 3 * 4);
+
+  ASSERT_EQ(memcmp(i420, nv12, sizeof(i420)), 0);
+  // Black and white.
+  ASSERT_EQ(i420[0], 0);
+  ASSERT_EQ(i420[4], 255);
+  ASSERT_EQ(i420[5], 255);
+  ASSERT_EQ(i420[6], 255);
+  ASSERT_EQ(i420[7], 255);
+  // BT.601 red.
+  ASSERT_NEAR(i420[8], 255, 1);
+  ASSERT_NEAR(i420[9], 0, 1);
+  ASSERT_NEAR(i420[10], 0, 1);
+  ASSERT_EQ(i420[11], 255);
+}
+
+TEST(EmbedderTestNoFixture, SoftwareExternalTextureWrapsRGBAWithoutCopy) {
+  constexpr size_t kSize = 4;
+  std::vector<uint32_t> pixels(kSize * kSize, 0xFF0000FF);  // Opaque red.
+  bool released = false;
+  size_t frames_requested = 0;
+
+  EmbedderExternalTextureSoftware::ExternalTextureCallback callback =
+      [&](int64_t texture_id, size_t width, size_t height) {
+        frames_requested++;
+        auto texture = std::make_unique<FlutterSoftwareExternalTexture>();
+        texture->struct_size = sizeof(FlutterSoftwareExternalTexture);
+        texture->pixel_format = kFlutterSoftwarePixelFormatRGBA8888;
+        texture->width = kSize;
+        texture->height = kSize;
+        texture->planes[0] = reinterpret_cast<const uint8_t*>(pixels.data());
+        texture->row_bytes[0] = kSize * 4;
+        texture->user_data = &released;
+        texture->release_callback = [](void* user_data) {
+          *static_cast<bool*>(user_data) = true;
+        };
+        return texture;
+      };
+
+  std::unique_ptr<Texture> texture =
+      std::make_unique<EmbedderExternalTextureSoftware>(1, callback);
+  auto surface = SkSurface::MakeRasterN32Premul(kSize, kSize);
+  const auto bounds = SkRect::MakeWH(kSize, kSize);
+
+  texture->Paint(*surface->getCanvas(), bounds, false, nullptr, {});
+  ASSERT_EQ(frames_requested, 1u);
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kSize, kSize);
+  ASSERT_TRUE(surface->readPixels(bitmap, 0, 0));
+  ASSERT_EQ(bitmap.getColor(1, 1), SK_ColorRED);
+
+  // The pixel buffer is drawn in place, so changing it changes the output.
+  std::fill(pixels.begin(), pixels.end(), 0xFF00FF00);  // Opaque green.
+  texture->Paint(*surface->getCanvas(), bounds, false, nullptr, {});
+  ASSERT_EQ(frames_requested, 1u);
+  ASSERT_TRUE(surface->readPixels(bitmap, 0, 0));
+  ASSERT_EQ(bitmap.getColor(1, 1), SK_ColorGREEN);
+  ASSERT_FALSE(released);
+
+  // Another frame is only requested once one is marked as available.
+  texture->MarkNewFrameAvailable();
+  texture->Paint(*surface->getCanvas(), bounds, false, nullptr, {});
+  ASSERT_EQ(frames_requested, 2u);
+  ASSERT_TRUE(released);
+
+  released = false;
+  texture->OnTextureUnregistered();
+  ASSERT_TRUE(released);
+}
+
 TEST_F(EmbedderTest, CanReloadSystemFonts) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
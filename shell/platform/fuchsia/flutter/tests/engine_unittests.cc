@@ -33,8 +33,8 @@ class MockTaskRunner : public fml::BasicTaskRunner {
   MockTaskRunner() {}
   virtual ~MockTaskRunner() {}
 
-  void PostTask(const fml::closure& task) override {
-    outstanding_tasks_.push(task);
+  void PostTask(fml::UniqueClosure task) override {
+    outstanding_tasks_.push(std::move(task));
   }
 
   int GetTaskCount() { return task_count_; }
@@ -49,7 +49,7 @@ class MockTaskRunner : public fml::BasicTaskRunner {
 
  private:
   int task_count_ = 0;
-  std::queue<const fml::closure> outstanding_tasks_;
+  std::queue<fml::UniqueClosure> outstanding_tasks_;
 };
 
 class EngineTest : public ::testing::Test {
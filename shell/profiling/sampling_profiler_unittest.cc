@@ -18,11 +18,20 @@ class MockTaskRunner : public fml::TaskRunner {
   inline static RefPtr<MockTaskRunner> Create() {
     return AdoptRef(new MockTaskRunner());
   }
-  MOCK_METHOD1(PostTask, void(const fml::closure& task));
-  MOCK_METHOD2(PostTaskForTime,
-               void(const fml::closure& task, fml::TimePoint target_time));
-  MOCK_METHOD2(PostDelayedTask,
-               void(const fml::closure& task, fml::TimeDelta delay));
+  // Tasks are move-only, so the mocked methods take them by reference.
+  void PostTask(fml::UniqueClosure task) override { MockPostTask(task); }
+  void PostTaskForTime(fml::UniqueClosure task,
+                       fml::TimePoint target_time) override {
+    MockPostTaskForTime(task, target_time);
+  }
+  void PostDelayedTask(fml::UniqueClosure task, fml::TimeDelta delay) override {
+    MockPostDelayedTask(task, delay);
+  }
+  MOCK_METHOD1(MockPostTask, void(fml::UniqueClosure& task));
+  MOCK_METHOD2(MockPostTaskForTime,
+               void(fml::UniqueClosure& task, fml::TimePoint target_time));
+  MOCK_METHOD2(MockPostDelayedTask,
+               void(fml::UniqueClosure& task, fml::TimeDelta delay));
   MOCK_METHOD0(RunsTasksOnCurrentThread, bool());
   MOCK_METHOD0(GetTaskQueueId, TaskQueueId());
 
@@ -42,12 +51,11 @@ TEST(SamplingProfilerTest, DeleteAfterStart) {
 
   // Ignore calls to PostTask since that would require mocking out calls to
   // Dart.
-  EXPECT_CALL(*task_runner, PostDelayedTask(_, _))
-      .WillRepeatedly(
-          Invoke([&](const fml::closure& task, fml::TimeDelta delay) {
-            invoke_count.fetch_add(1);
-            thread->GetTaskRunner()->PostTask(task);
-          }));
+  EXPECT_CALL(*task_runner, MockPostDelayedTask(_, _))
+      .WillRepeatedly(Invoke([&](fml::UniqueClosure& task, fml::TimeDelta) {
+        invoke_count.fetch_add(1);
+        thread->GetTaskRunner()->PostTask(std::move(task));
+      }));
 
   {
     auto profiler = SamplingProfiler(
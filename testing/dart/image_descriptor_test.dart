@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+// FlutterTesterOptions=--flutter-assets-dir=flutter/testing/resources
+
 import 'dart:async';
 import 'dart:io';
 import 'dart:typed_data';
@@ -82,6 +84,36 @@ void main() {
     final Codec codec = await descriptor.instantiateCodec();
     expect(codec.frameCount, 1);
   }, skip: !(Platform.isIOS || Platform.isMacOS || Platform.isWindows));
+
+  test('ImmutableBuffer.fromAsset loads the asset', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromAsset('square.png');
+    expect(buffer.length, bytes.length);
+
+    // The buffer is only readable by decoding it, so compare its pixels with
+    // those of a copy of the file.
+    final ImmutableBuffer copy = await ImmutableBuffer.fromUint8List(bytes);
+    final ByteData? pixels = await _decodeToRgba(buffer);
+    final ByteData? expectedPixels = await _decodeToRgba(copy);
+    expect(pixels, notEquals(null));
+    expect(pixels!.buffer.asUint8List(), equals(expectedPixels!.buffer.asUint8List()));
+  });
+
+  test('ImmutableBuffer.fromAsset fails for missing assets', () async {
+    try {
+      await ImmutableBuffer.fromAsset('does/not/exist.png');
+      fail('exception not thrown');
+    } on Exception catch (e) {
+      expect(e.toString(), contains('Asset not found'));
+    }
+  });
+}
+
+Future<ByteData?> _decodeToRgba(ImmutableBuffer buffer) async {
+  final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+  final Codec codec = await descriptor.instantiateCodec();
+  final FrameInfo frame = await codec.getNextFrame();
+  return frame.image.toByteData();
 }
 
 Future<Uint8List> readFile(String fileName, ) async {
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <minikin/BreakIteratorPool.h>
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace minikin {
+
+namespace {
+
+using Key = std::pair<BreakIteratorPool::Type, std::string>;
+
+struct KeyHasher {
+  size_t operator()(const Key& key) const {
+    return std::hash<std::string>()(key.second) ^
+           static_cast<size_t>(key.first);
+  }
+};
+
+struct ThreadPool {
+  ~ThreadPool();
+
+  std::unordered_map<Key,
+                     std::vector<std::unique_ptr<icu::BreakIterator>>,
+                     KeyHasher>
+      iterators;
+};
+
+// Iterators released while the thread exits, after its pool is gone, are
+// deleted instead. Unlike the pool, this flag has no destructor and stays
+// valid until the thread ends.
+thread_local bool gThreadPoolDestroyed = false;
+
+ThreadPool::~ThreadPool() {
+  gThreadPoolDestroyed = true;
+}
+
+ThreadPool& getThreadPool() {
+  thread_local ThreadPool pool;
+  return pool;
+}
+
+// New iterators are cloned from one iterator per type and locale that is
+// shared by all threads, which is faster than building them from the rules.
+std::mutex gPrototypesMutex;
+
+std::unique_ptr<icu::BreakIterator> createIterator(
+    BreakIteratorPool::Type type,
+    const icu::Locale& locale) {
+  static auto* prototypes =
+      new std::unordered_map<Key, std::unique_ptr<icu::BreakIterator>,
+                             KeyHasher>();
+  std::scoped_lock lock(gPrototypesMutex);
+  std::unique_ptr<icu::BreakIterator>& prototype =
+      (*prototypes)[Key(type, locale.getName())];
+  if (!prototype) {
+    UErrorCode status = U_ZERO_ERROR;
+    switch (type) {
+      case BreakIteratorPool::Type::kLine:
+        prototype.reset(icu::BreakIterator::createLineInstance(locale, status));
+        break;
+      case BreakIteratorPool::Type::kWord:
+        prototype.reset(icu::BreakIterator::createWordInstance(locale, status));
+        break;
+    }
+    if (!U_SUCCESS(status)) {
+      prototype.reset();
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<icu::BreakIterator>(prototype->clone());
+}
+
+}  // namespace
+
+void BreakIteratorPool::Releaser::operator()(
+    icu::BreakIterator* iterator) const {
+  std::unique_ptr<icu::BreakIterator> owned(iterator);
+  if (owned == nullptr || gThreadPoolDestroyed) {
+    return;
+  }
+  std::vector<std::unique_ptr<icu::BreakIterator>>& pooled =
+      getThreadPool().iterators[Key(mType, mLocale)];
+  if (pooled.size() < kMaxPooledPerKey) {
+    pooled.push_back(std::move(owned));
+  }
+}
+
+BreakIteratorPool::Iterator BreakIteratorPool::acquire(
+    Type type,
+    const icu::Locale& locale) {
+  Key key(type, locale.getName());
+  if (!gThreadPoolDestroyed) {
+    std::vector<std::unique_ptr<icu::BreakIterator>>& pooled =
+        getThreadPool().iterators[key];
+    if (!pooled.empty()) {
+      icu::BreakIterator* iterator = pooled.back().release();
+      pooled.pop_back();
+      return Iterator(iterator, Releaser(type, std::move(key.second)));
+    }
+  }
+  return Iterator(createIterator(type, locale).release(),
+                  Releaser(type, std::move(key.second)));
+}
+
+size_t BreakIteratorPool::getPooledCount() {
+  if (gThreadPoolDestroyed) {
+    return 0;
+  }
+  size_t count = 0;
+  for (const auto& entry : getThreadPool().iterators) {
+    count += entry.second.size();
+  }
+  return count;
+}
+
+}  // namespace minikin
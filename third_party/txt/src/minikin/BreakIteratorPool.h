@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * libtxt extension: a per-thread pool of ICU break iterators, since creating
+ * or cloning one costs far more than breaking a short paragraph.
+ */
+
+#ifndef MINIKIN_BREAK_ITERATOR_POOL_H
+#define MINIKIN_BREAK_ITERATOR_POOL_H
+
+#include <memory>
+#include <string>
+
+#include "unicode/brkiter.h"
+#include "unicode/locid.h"
+
+namespace minikin {
+
+class BreakIteratorPool {
+ public:
+  enum class Type { kLine, kWord };
+
+  // Returns an iterator to the pool of the thread that releases it.
+  class Releaser {
+   public:
+    Releaser() = default;
+    Releaser(Type type, std::string locale)
+        : mType(type), mLocale(std::move(locale)) {}
+
+    void operator()(icu::BreakIterator* iterator) const;
+
+   private:
+    Type mType = Type::kLine;
+    std::string mLocale;
+  };
+
+  using Iterator = std::unique_ptr<icu::BreakIterator, Releaser>;
+
+  // Returns an iterator of the given type for locale, reusing one released on
+  // this thread if there is one. The text of a reused iterator is left over
+  // from its last user, so callers always set their own. Returns nullptr if
+  // ICU can't create the iterator.
+  static Iterator acquire(Type type, const icu::Locale& locale);
+
+  // The number of iterators held for reuse on this thread.
+  static size_t getPooledCount();
+
+  // At most this many iterators of each type and locale are held per thread.
+  static const size_t kMaxPooledPerKey = 4;
+};
+
+}  // namespace minikin
+
+#endif  // MINIKIN_BREAK_ITERATOR_POOL_H
@@ -80,4 +80,48 @@ void analyzeAxes(const uint8_t* fvar_data,
     axes->insert(tag);
   }
 }
+
+void analyzeGposLookupTypes(const uint8_t* gpos_data,
+                            size_t gpos_size,
+                            std::vector<uint16_t>* lookupTypes) {
+  const size_t kLookupListOffsetOffset = 8;
+  const uint16_t kExtensionLookupType = 9;
+
+  lookupTypes->clear();
+
+  if (gpos_size < kLookupListOffsetOffset + 2) {
+    return;
+  }
+  const size_t lookupListOffset = readU16(gpos_data, kLookupListOffsetOffset);
+  if (gpos_size < lookupListOffset + 2) {
+    return;  // Invalid table size.
+  }
+  const uint32_t lookupCount = readU16(gpos_data, lookupListOffset);
+  if (gpos_size < lookupListOffset + 2 + lookupCount * 2) {
+    return;  // Invalid table size.
+  }
+  lookupTypes->resize(lookupCount, 0);
+  for (uint32_t i = 0; i < lookupCount; ++i) {
+    const size_t lookupOffset =
+        lookupListOffset + readU16(gpos_data, lookupListOffset + 2 + i * 2);
+    if (gpos_size < lookupOffset + 8) {
+      continue;
+    }
+    uint16_t lookupType = readU16(gpos_data, lookupOffset);
+    if (lookupType == kExtensionLookupType) {
+      // All subtables of an extension lookup wrap lookups of the same type, so
+      // the first one tells the type.
+      if (readU16(gpos_data, lookupOffset + 4) == 0) {
+        continue;
+      }
+      const size_t subtableOffset =
+          lookupOffset + readU16(gpos_data, lookupOffset + 6);
+      lookupType = gpos_size < subtableOffset + 8
+                       ? 0
+                       : readU16(gpos_data, subtableOffset + 2);
+    }
+    (*lookupTypes)[i] = lookupType;
+  }
+}
+
 }  // namespace minikin
@@ -18,6 +18,7 @@
 #define MINIKIN_FONT_UTILS_H
 
 #include <unordered_set>
+#include <vector>
 
 namespace minikin {
 
@@ -29,6 +30,13 @@ void analyzeAxes(const uint8_t* fvar_data,
                  size_t fvar_size,
                  std::unordered_set<uint32_t>* axes);
 
+// Reads the type of each lookup in the LookupList of a GPOS table. The type of
+// an extension lookup is the type of the lookup it wraps. Lookups that can't
+// be read get type 0.
+void analyzeGposLookupTypes(const uint8_t* gpos_data,
+                            size_t gpos_size,
+                            std::vector<uint16_t>* lookupTypes);
+
 }  // namespace minikin
 
 #endif  // MINIKIN_ANALYZE_STYLE_H
@@ -74,6 +74,11 @@ bool GraphemeBreak::isGraphemeBreak(const float* advances,
   if (offset <= start || offset >= start + count) {
     return true;
   }
+  // libtxt extension: between two ASCII characters, only Rule GB3 can prevent
+  // a break, so skip looking up their properties.
+  if (buf[offset - 1] < 0x80 && buf[offset] < 0x80) {
+    return !(buf[offset - 1] == '\r' && buf[offset] == '\n');
+  }
   if (U16_IS_TRAIL(buf[offset])) {
     // Don't break a surrogate pair, but a lonely trailing surrogate pair is a
     // break
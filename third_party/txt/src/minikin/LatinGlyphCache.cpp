@@ -0,0 +1,372 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define LOG_TAG "Minikin"
+
+#include "LatinGlyphCache.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <hb-icu.h>
+#include <hb-ot.h>
+
+#include <utils/JenkinsHash.h>
+#include <utils/LruCache.h>
+
+#include "FontUtils.h"
+#include "MinikinInternal.h"
+
+namespace minikin {
+
+namespace {
+
+// The GSUB and GPOS features HarfBuzz applies to left-to-right horizontal text
+// by default.
+const hb_tag_t kSubstitutionFeatures[] = {
+    HB_TAG('c', 'c', 'm', 'p'), HB_TAG('l', 'o', 'c', 'l'),
+    HB_TAG('r', 'l', 'i', 'g'), HB_TAG('r', 'c', 'l', 't'),
+    HB_TAG('c', 'a', 'l', 't'), HB_TAG('c', 'l', 'i', 'g'),
+    HB_TAG('l', 'i', 'g', 'a'), HB_TAG('l', 't', 'r', 'a'),
+    HB_TAG('l', 't', 'r', 'm'), HB_TAG('r', 'v', 'r', 'n'),
+    HB_TAG_NONE};
+const hb_tag_t kPositioningFeatures[] = {
+    HB_TAG('k', 'e', 'r', 'n'), HB_TAG('m', 'a', 'r', 'k'),
+    HB_TAG('m', 'k', 'm', 'k'), HB_TAG('c', 'u', 'r', 's'),
+    HB_TAG('d', 'i', 's', 't'), HB_TAG('a', 'b', 'v', 'm'),
+    HB_TAG('b', 'l', 'w', 'm'), HB_TAG_NONE};
+const hb_tag_t kKerningFeatures[] = {HB_TAG('k', 'e', 'r', 'n'), HB_TAG_NONE};
+
+const uint16_t kPairPosLookupType = 2;
+const uint16_t kMarkBasePosLookupType = 4;
+const uint16_t kMarkMarkPosLookupType = 6;
+
+// Kerning value of pairs that have to be shaped.
+const hb_position_t kComplexPair = std::numeric_limits<hb_position_t>::min();
+
+// Control characters, and the soft hyphen that HarfBuzz hides, are left to
+// the shaper.
+bool isLatinChar(uint16_t ch) {
+  return (ch >= 0x20 && ch <= 0x7E) || (ch >= 0xA0 && ch <= 0xFF && ch != 0xAD);
+}
+
+bool hasTable(hb_face_t* face, hb_tag_t tag) {
+  HbBlob table(hb_face_reference_table(face, tag));
+  return table.size() != 0;
+}
+
+// Calls f for each lookup of the features in table.
+template <typename F>
+void forEachLookup(hb_face_t* face,
+                   hb_tag_t table,
+                   const hb_tag_t* features,
+                   F f) {
+  hb_set_t* lookups = hb_set_create();
+  hb_ot_layout_collect_lookups(face, table, nullptr, nullptr, features,
+                               lookups);
+  hb_codepoint_t lookup = HB_SET_VALUE_INVALID;
+  while (hb_set_next(lookups, &lookup)) {
+    f(lookup);
+  }
+  hb_set_destroy(lookups);
+}
+
+struct LatinGlyphsKey {
+  float size;
+  float scaleX;
+  float skewX;
+  uint32_t paintFlags;
+  bool fakeBold;
+  bool fakeItalic;
+  hb_script_t script;
+  hb_language_t language;
+
+  bool operator==(const LatinGlyphsKey& other) const {
+    return size == other.size && scaleX == other.scaleX &&
+           skewX == other.skewX && paintFlags == other.paintFlags &&
+           fakeBold == other.fakeBold && fakeItalic == other.fakeItalic &&
+           script == other.script && language == other.language;
+  }
+
+  struct Hasher {
+    size_t operator()(const LatinGlyphsKey& key) const {
+      uint32_t hash = android::JenkinsHashMix(0, android::hash_type(key.size));
+      hash = android::JenkinsHashMix(hash, android::hash_type(key.scaleX));
+      hash = android::JenkinsHashMix(hash, android::hash_type(key.skewX));
+      hash = android::JenkinsHashMix(hash, key.paintFlags);
+      hash = android::JenkinsHashMix(hash, key.fakeBold << 1 | key.fakeItalic);
+      hash = android::JenkinsHashMix(hash, key.script);
+      hash = android::JenkinsHashMix(hash, android::hash_type(key.language));
+      return android::JenkinsHashWhiten(hash);
+    }
+  };
+};
+
+// The Latin-1 glyphs of a font that need no shaping, and the LatinGlyphs
+// created from them for each size.
+struct LatinFontInfo {
+  // Has no more entries than a font usually has sizes and styles on screen.
+  static const size_t kMaxSizes = 32;
+
+  uint16_t glyphs[LatinGlyphs::kCount] = {};
+  std::bitset<LatinGlyphs::kCount> kerned;
+  bool hasGlyphs = false;
+  std::unordered_map<LatinGlyphsKey,
+                     std::unique_ptr<LatinGlyphs>,
+                     LatinGlyphsKey::Hasher>
+      sizes;
+};
+
+// Finds the Latin-1 glyphs of the font of hbFont that take part in no
+// substitution or positioning HarfBuzz applies by default, other than pair
+// kerning. Lookups are collected for all scripts and languages, so a glyph
+// that only some language changes is shaped in all of them.
+LatinFontInfo* createLatinFontInfo(hb_font_t* hbFont,
+                                   const MinikinFont* minikinFont) {
+  LatinFontInfo* info = new LatinFontInfo();
+  hb_face_t* face = hb_font_get_face(hbFont);
+  // Variations and the AAT tables can change any glyph. The legacy kern table
+  // is only used when GPOS has no kerning.
+  if (!minikinFont->GetAxes().empty() ||
+      hasTable(face, HB_TAG('m', 'o', 'r', 'x')) ||
+      hasTable(face, HB_TAG('k', 'e', 'r', 'x')) ||
+      hasTable(face, HB_TAG('t', 'r', 'a', 'k'))) {
+    return info;
+  }
+  if (hasTable(face, HB_TAG('k', 'e', 'r', 'n'))) {
+    bool hasGposKerning = false;
+    forEachLookup(face, HB_OT_TAG_GPOS, kKerningFeatures,
+                  [&](hb_codepoint_t) { hasGposKerning = true; });
+    if (!hasGposKerning) {
+      return info;
+    }
+  }
+
+  hb_set_t* shaped = hb_set_create();
+  hb_set_t* kerned = hb_set_create();
+  hb_set_t* glyphs = hb_set_create();
+  forEachLookup(face, HB_OT_TAG_GSUB, kSubstitutionFeatures,
+                [&](hb_codepoint_t lookup) {
+                  hb_ot_layout_lookup_collect_glyphs(face, HB_OT_TAG_GSUB,
+                                                     lookup, nullptr, shaped,
+                                                     nullptr, nullptr);
+                });
+
+  std::vector<uint16_t> lookupTypes;
+  HbBlob gposTable(hb_face_reference_table(face, HB_OT_TAG_GPOS));
+  analyzeGposLookupTypes(gposTable.get(), gposTable.size(), &lookupTypes);
+  forEachLookup(
+      face, HB_OT_TAG_GPOS, kPositioningFeatures, [&](hb_codepoint_t lookup) {
+        const uint16_t type =
+            lookup < lookupTypes.size() ? lookupTypes[lookup] : 0;
+        hb_set_clear(glyphs);
+        hb_ot_layout_lookup_collect_glyphs(face, HB_OT_TAG_GPOS, lookup,
+                                           nullptr, glyphs, nullptr, nullptr);
+        if (type == kPairPosLookupType) {
+          hb_set_union(kerned, glyphs);
+        } else if (type >= kMarkBasePosLookupType &&
+                   type <= kMarkMarkPosLookupType) {
+          // Mark attachment only moves the marks, but the collected glyphs
+          // include the bases they attach to.
+          hb_codepoint_t glyph = HB_SET_VALUE_INVALID;
+          while (hb_set_next(glyphs, &glyph)) {
+            const hb_ot_layout_glyph_class_t glyphClass =
+                hb_ot_layout_get_glyph_class(face, glyph);
+            if (glyphClass != HB_OT_LAYOUT_GLYPH_CLASS_BASE_GLYPH &&
+                glyphClass != HB_OT_LAYOUT_GLYPH_CLASS_LIGATURE) {
+              hb_set_add(shaped, glyph);
+            }
+          }
+        } else {
+          hb_set_union(shaped, glyphs);
+        }
+      });
+
+  for (uint16_t ch = 0; ch < LatinGlyphs::kCount; ch++) {
+    hb_codepoint_t glyph = 0;
+    if (!isLatinChar(ch) || !hb_font_get_nominal_glyph(hbFont, ch, &glyph) ||
+        glyph == 0 || glyph > 0xFFFF || hb_set_has(shaped, glyph) ||
+        hb_ot_layout_get_glyph_class(face, glyph) ==
+            HB_OT_LAYOUT_GLYPH_CLASS_MARK) {
+      continue;
+    }
+    info->glyphs[ch] = glyph;
+    info->kerned[ch] = hb_set_has(kerned, glyph);
+    info->hasGlyphs = true;
+  }
+  hb_set_destroy(glyphs);
+  hb_set_destroy(kerned);
+  hb_set_destroy(shaped);
+  return info;
+}
+
+class LatinGlyphCache
+    : private android::OnEntryRemoved<int32_t, LatinFontInfo*> {
+ public:
+  LatinGlyphCache() : mCache(kMaxEntries) {
+    mCache.setOnEntryRemovedListener(this);
+  }
+
+  // callback for OnEntryRemoved
+  void operator()(int32_t& /* key */, LatinFontInfo*& value) { delete value; }
+
+  LatinFontInfo* get(int32_t fontId) { return mCache.get(fontId); }
+
+  void put(int32_t fontId, LatinFontInfo* info) { mCache.put(fontId, info); }
+
+  void clear() { mCache.clear(); }
+
+  void remove(int32_t fontId) { mCache.remove(fontId); }
+
+ private:
+  // Matches the size of the HarfBuzz font cache.
+  static const size_t kMaxEntries = 100;
+
+  android::LruCache<int32_t, LatinFontInfo*> mCache;
+};
+
+LatinGlyphCache* getLatinGlyphCacheLocked() {
+  assertMinikinLocked();
+  static LatinGlyphCache* cache = nullptr;
+  if (cache == nullptr) {
+    cache = new LatinGlyphCache();
+  }
+  return cache;
+}
+
+hb_buffer_t* getPairBufferLocked() {
+  assertMinikinLocked();
+  static hb_buffer_t* buffer = nullptr;
+  if (buffer == nullptr) {
+    buffer = hb_buffer_create();
+    hb_buffer_set_unicode_funcs(buffer, hb_icu_get_unicode_funcs());
+  }
+  return buffer;
+}
+
+}  // namespace
+
+LatinGlyphs::LatinGlyphs(const uint16_t* glyphs,
+                         const std::bitset<kCount>& kerned,
+                         hb_script_t script,
+                         hb_language_t language)
+    : mKerned(kerned), mScript(script), mLanguage(language) {
+  std::copy(glyphs, glyphs + kCount, mGlyphs);
+}
+
+hb_position_t LatinGlyphs::getAdvance(hb_font_t* hbFont, uint16_t ch) {
+  if (!mHasAdvance[ch]) {
+    // The same advance HarfBuzz gets from the font functions of hbFont.
+    mAdvances[ch] = hb_font_get_glyph_h_advance(hbFont, mGlyphs[ch]);
+    mHasAdvance[ch] = true;
+  }
+  return mAdvances[ch];
+}
+
+const MinikinRect& LatinGlyphs::getBounds(const MinikinPaint& paint,
+                                          uint16_t ch) {
+  if (!mHasBounds[ch]) {
+    paint.font->GetBounds(&mBounds[ch], mGlyphs[ch], paint);
+    mHasBounds[ch] = true;
+  }
+  return mBounds[ch];
+}
+
+bool LatinGlyphs::getKerning(hb_font_t* hbFont,
+                             uint16_t left,
+                             uint16_t right,
+                             hb_position_t* kerning) {
+  if (!mKerned[left]) {
+    *kerning = 0;
+    return true;
+  }
+  const uint16_t pair = left << 8 | right;
+  auto found = mKerning.find(pair);
+  if (found == mKerning.end()) {
+    found = mKerning.emplace(pair, shapePair(hbFont, left, right)).first;
+  }
+  *kerning = found->second;
+  return found->second != kComplexPair;
+}
+
+// Shapes the pair on its own. With no substitutions and no positioning other
+// than pair kerning, the pair is positioned the same way in any text.
+hb_position_t LatinGlyphs::shapePair(hb_font_t* hbFont,
+                                     uint16_t left,
+                                     uint16_t right) {
+  hb_buffer_t* buffer = getPairBufferLocked();
+  hb_buffer_clear_contents(buffer);
+  hb_buffer_set_script(buffer, mScript);
+  hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
+  hb_buffer_set_language(buffer, mLanguage);
+  const uint16_t chars[] = {left, right};
+  hb_buffer_add_utf16(buffer, chars, 2, 0, 2);
+  hb_shape(hbFont, buffer, nullptr, 0);
+
+  unsigned int numGlyphs;
+  hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, &numGlyphs);
+  hb_glyph_position_t* positions = hb_buffer_get_glyph_positions(buffer, NULL);
+  // Only an adjustment of the first advance can be applied without shaping.
+  // Kerning that moves the second glyph also keeps it from starting a pair.
+  if (numGlyphs != 2 || info[0].codepoint != mGlyphs[left] ||
+      info[1].codepoint != mGlyphs[right] || positions[0].x_offset != 0 ||
+      positions[0].y_offset != 0 || positions[1].x_offset != 0 ||
+      positions[1].y_offset != 0 ||
+      positions[1].x_advance != getAdvance(hbFont, right)) {
+    return kComplexPair;
+  }
+  return positions[0].x_advance - getAdvance(hbFont, left);
+}
+
+LatinGlyphs* getLatinGlyphsLocked(hb_font_t* hbFont,
+                                  const MinikinPaint& paint,
+                                  hb_script_t script,
+                                  hb_language_t language) {
+  LatinGlyphCache* cache = getLatinGlyphCacheLocked();
+  const int32_t fontId = paint.font->GetUniqueId();
+  LatinFontInfo* info = cache->get(fontId);
+  if (info == nullptr) {
+    info = createLatinFontInfo(hbFont, paint.font);
+    cache->put(fontId, info);
+  }
+  if (!info->hasGlyphs) {
+    return nullptr;
+  }
+
+  FontFakery fakery = paint.fakery;
+  LatinGlyphsKey key;
+  key.size = paint.size;
+  key.scaleX = paint.scaleX;
+  key.skewX = paint.skewX;
+  key.paintFlags = paint.paintFlags;
+  key.fakeBold = fakery.isFakeBold();
+  key.fakeItalic = fakery.isFakeItalic();
+  key.script = script;
+  key.language = language;
+  auto found = info->sizes.find(key);
+  if (found == info->sizes.end()) {
+    if (info->sizes.size() >= LatinFontInfo::kMaxSizes) {
+      info->sizes.clear();
+    }
+    found = info->sizes
+                .emplace(key, std::make_unique<LatinGlyphs>(
+                                  info->glyphs, info->kerned, script, language))
+                .first;
+  }
+  return found->second.get();
+}
+
+void purgeLatinGlyphCacheLocked() {
+  assertMinikinLocked();
+  getLatinGlyphCacheLocked()->clear();
+}
+
+void purgeLatinGlyphsLocked(const MinikinFont* minikinFont) {
+  assertMinikinLocked();
+  getLatinGlyphCacheLocked()->remove(minikinFont->GetUniqueId());
+}
+
+}  // namespace minikin
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MINIKIN_LATIN_GLYPH_CACHE_H
+#define MINIKIN_LATIN_GLYPH_CACHE_H
+
+#include <hb.h>
+
+#include <bitset>
+#include <unordered_map>
+
+#include <minikin/MinikinFont.h>
+
+namespace minikin {
+
+// Latin-1 text whose glyphs take part in no glyph substitution and in no
+// positioning other than pair kerning shapes to one glyph per character, each
+// placed at the sum of the advances and kerning before it. LatinGlyphs holds
+// what is needed to lay such text out without HarfBuzz, for one font, size and
+// script. Advances, bounds and kerning are computed on first use.
+class LatinGlyphs {
+ public:
+  static const uint16_t kCount = 0x100;
+
+  LatinGlyphs(const uint16_t* glyphs,
+              const std::bitset<kCount>& kerned,
+              hb_script_t script,
+              hb_language_t language);
+
+  // Returns the glyph of ch, or 0 if text containing ch has to be shaped.
+  uint16_t getGlyph(uint16_t ch) const { return ch < kCount ? mGlyphs[ch] : 0; }
+
+  // Returns the advance of the glyph of ch in HarfBuzz units. hbFont has to be
+  // set up for the paint used to look these glyphs up.
+  hb_position_t getAdvance(hb_font_t* hbFont, uint16_t ch);
+
+  const MinikinRect& getBounds(const MinikinPaint& paint, uint16_t ch);
+
+  // Sets kerning to the adjustment of the advance of the glyph of left when
+  // the glyph of right follows it. Returns false if the pair is positioned in
+  // some other way and has to be shaped.
+  bool getKerning(hb_font_t* hbFont,
+                  uint16_t left,
+                  uint16_t right,
+                  hb_position_t* kerning);
+
+ private:
+  hb_position_t shapePair(hb_font_t* hbFont, uint16_t left, uint16_t right);
+
+  uint16_t mGlyphs[kCount];
+  // Whether the glyph of a character starts a kerning pair.
+  std::bitset<kCount> mKerned;
+  hb_script_t mScript;
+  hb_language_t mLanguage;
+
+  hb_position_t mAdvances[kCount];
+  std::bitset<kCount> mHasAdvance;
+  MinikinRect mBounds[kCount];
+  std::bitset<kCount> mHasBounds;
+  std::unordered_map<uint16_t, hb_position_t> mKerning;
+};
+
+// Returns the glyphs of the font of paint for laying out Latin-1 text with the
+// size and flags of paint, or nullptr if all of its Latin-1 text has to be
+// shaped. hbFont has to be set up for paint.
+LatinGlyphs* getLatinGlyphsLocked(hb_font_t* hbFont,
+                                  const MinikinPaint& paint,
+                                  hb_script_t script,
+                                  hb_language_t language);
+
+void purgeLatinGlyphCacheLocked();
+void purgeLatinGlyphsLocked(const MinikinFont* minikinFont);
+
+}  // namespace minikin
+#endif  // MINIKIN_LATIN_GLYPH_CACHE_H
@@ -38,6 +38,7 @@
 #include "FontLanguage.h"
 #include "FontLanguageListCache.h"
 #include "HbFontCache.h"
+#include "LatinGlyphCache.h"
 #include "LayoutUtils.h"
 #include "MinikinInternal.h"
 
@@ -1001,10 +1002,7 @@ void Layout::doLayoutRun(const uint16_t* buf,
         letterSpaceHalfRight = letterSpace - letterSpaceHalfLeft;
       }
 
-      hb_buffer_clear_contents(buffer);
-      hb_buffer_set_script(buffer, script);
-      hb_buffer_set_direction(buffer,
-                              isRtl ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+      hb_language_t language = HB_LANGUAGE_INVALID;
       const FontLanguages& langList =
           FontLanguageListCache::getById(ctx->style.getLanguageListId());
       if (langList.size() != 0) {
@@ -1015,7 +1013,31 @@ void Layout::doLayoutRun(const uint16_t* buf,
             break;
           }
         }
-        hb_buffer_set_language(buffer, hbLanguage->getHbLanguage());
+        language = hbLanguage->getHbLanguage();
+      }
+
+      // Most text is short runs of Latin-1 in fonts that shape it one glyph
+      // per character, which doesn't need HarfBuzz.
+      if (!isRtl && !is_color_bitmap_font &&
+          buf[start + scriptRunStart] < LatinGlyphs::kCount &&
+          ctx->paint.fontFeatureSettings.empty() &&
+          ctx->paint.hyphenEdit.getHyphen() == HyphenEdit::NO_EDIT) {
+        LatinGlyphs* latinGlyphs =
+            getLatinGlyphsLocked(hbFont, ctx->paint, script, language);
+        if (latinGlyphs != nullptr &&
+            doLatinLayoutRun(buf + start, scriptRunStart, scriptRunEnd,
+                             font_ix, hbFont, latinGlyphs, ctx, letterSpace,
+                             letterSpaceHalfLeft, letterSpaceHalfRight, &x)) {
+          continue;
+        }
+      }
+
+      hb_buffer_clear_contents(buffer);
+      hb_buffer_set_script(buffer, script);
+      hb_buffer_set_direction(buffer,
+                              isRtl ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+      if (language != HB_LANGUAGE_INVALID) {
+        hb_buffer_set_language(buffer, language);
       }
 
       const uint32_t clusterStart =
@@ -1105,6 +1127,61 @@ void Layout::doLayoutRun(const uint16_t* buf,
   mAdvance = x;
 }
 
+bool Layout::doLatinLayoutRun(const uint16_t* buf,
+                              size_t runStart,
+                              size_t runEnd,
+                              int font_ix,
+                              hb_font_t* hbFont,
+                              LatinGlyphs* glyphs,
+                              LayoutContext* ctx,
+                              double letterSpace,
+                              double letterSpaceHalfLeft,
+                              double letterSpaceHalfRight,
+                              float* x) {
+  for (size_t i = runStart; i < runEnd; i++) {
+    hb_position_t kerning;
+    if (glyphs->getGlyph(buf[i]) == 0 ||
+        (i > runStart &&
+         !glyphs->getKerning(hbFont, buf[i - 1], buf[i], &kerning))) {
+      return false;
+    }
+  }
+
+  // Places the glyphs the way doLayoutRun places the glyphs HarfBuzz returns,
+  // with one glyph per cluster.
+  mAdvances[runStart] += letterSpaceHalfLeft;
+  *x += letterSpaceHalfLeft;
+  for (size_t i = runStart; i < runEnd; i++) {
+    if (i > runStart) {
+      mAdvances[i - 1] += letterSpaceHalfRight;
+      mAdvances[i] += letterSpaceHalfLeft;
+      *x += letterSpace;
+    }
+
+    const uint16_t ch = buf[i];
+    hb_position_t advance = glyphs->getAdvance(hbFont, ch);
+    hb_position_t kerning = 0;
+    if (i + 1 < runEnd) {
+      glyphs->getKerning(hbFont, ch, buf[i + 1], &kerning);
+    }
+    LayoutGlyph glyph = {font_ix, glyphs->getGlyph(ch), *x, 0,
+                         static_cast<uint32_t>(i)};
+    mGlyphs.push_back(glyph);
+    float xAdvance = HBFixedToFloat(advance + kerning);
+    if ((ctx->paint.paintFlags & LinearTextFlag) == 0) {
+      xAdvance = roundf(xAdvance);
+    }
+    MinikinRect glyphBounds = glyphs->getBounds(ctx->paint, ch);
+    glyphBounds.offset(*x, 0);
+    mBounds.join(glyphBounds);
+    mAdvances[i] += xAdvance;
+    *x += xAdvance;
+  }
+  mAdvances[runEnd - 1] += letterSpaceHalfRight;
+  *x += letterSpaceHalfRight;
+  return true;
+}
+
 void Layout::appendLayout(Layout* src, size_t start, float extraAdvance) {
   int fontMapStack[16];
   int* fontMap;
@@ -1197,6 +1274,7 @@ void Layout::purgeCaches() {
   LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
   layoutCache.clear();
   purgeHbFontCacheLocked();
+  purgeLatinGlyphCacheLocked();
 }
 
 }  // namespace minikin
@@ -45,6 +45,7 @@ struct LayoutGlyph {
 
 // Internal state used during layout operation
 struct LayoutContext;
+class LatinGlyphs;
 
 enum {
   kBidi_LTR = 0,
@@ -162,6 +163,21 @@ class Layout {
                    LayoutContext* ctx,
                    const std::shared_ptr<FontCollection>& collection);
 
+  // Lay out a script run of Latin-1 characters with glyphs that need no
+  // shaping. Returns false, leaving the layout unchanged, if the run has to be
+  // shaped.
+  bool doLatinLayoutRun(const uint16_t* buf,
+                        size_t runStart,
+                        size_t runEnd,
+                        int font_ix,
+                        hb_font_t* hbFont,
+                        LatinGlyphs* glyphs,
+                        LayoutContext* ctx,
+                        double letterSpace,
+                        double letterSpaceHalfLeft,
+                        double letterSpaceHalfRight,
+                        float* x);
+
   // Append another layout (for example, cached value) into this one
   void appendLayout(Layout* src, size_t start, float extraAdvance);
 
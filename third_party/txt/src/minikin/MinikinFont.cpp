@@ -16,6 +16,7 @@
 
 #include <minikin/MinikinFont.h>
 #include "HbFontCache.h"
+#include "LatinGlyphCache.h"
 #include "MinikinInternal.h"
 
 namespace minikin {
@@ -23,6 +24,7 @@ namespace minikin {
 MinikinFont::~MinikinFont() {
   std::scoped_lock _l(gMinikinLock);
   purgeHbFontLocked(this);
+  purgeLatinGlyphsLocked(this);
 }
 
 }  // namespace minikin
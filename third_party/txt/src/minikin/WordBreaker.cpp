@@ -26,26 +26,39 @@
 #include <unicode/uchar.h>
 #include <unicode/utf16.h>
 
+#include <algorithm>
+
 namespace minikin {
 
 const uint32_t CHAR_SOFT_HYPHEN = 0x00AD;
 const uint32_t CHAR_ZWJ = 0x200D;
 
-// libtxt extension: avoid the cost of initializing new ICU break iterators
-// by constructing a global iterator using the default locale and then
-// creating a clone for each WordBreaker instance.
-static std::once_flag gLibtxtBreakIteratorInitFlag;
-static icu::BreakIterator* gLibtxtDefaultBreakIterator = nullptr;
+// libtxt extension: text made of ASCII letters, digits and spaces only has
+// line break opportunities after runs of spaces (UAX #14 rules LB7, LB18, LB23,
+// LB25 and LB28), so it is broken without ICU. The checks avoid branches and
+// early exits within a block so that compilers can vectorize the loop.
+static bool isSimpleText(const uint16_t* data, size_t size) {
+  const size_t kBlockSize = 64;
+  for (size_t blockStart = 0; blockStart < size; blockStart += kBlockSize) {
+    const size_t blockEnd = std::min(size, blockStart + kBlockSize);
+    bool simple = true;
+    for (size_t i = blockStart; i < blockEnd; i++) {
+      const uint16_t c = data[i];
+      const bool isLetter = static_cast<uint16_t>((c | 0x20) - 'a') < 26;
+      const bool isDigit = static_cast<uint16_t>(c - '0') < 10;
+      simple &= isLetter | isDigit | (c == ' ');
+    }
+    if (!simple) {
+      return false;
+    }
+  }
+  return true;
+}
 
 void WordBreaker::setLocale() {
-  UErrorCode status = U_ZERO_ERROR;
-  std::call_once(gLibtxtBreakIteratorInitFlag, [&status] {
-    gLibtxtDefaultBreakIterator =
-        icu::BreakIterator::createLineInstance(icu::Locale(), status);
-  });
-  mBreakIterator.reset(gLibtxtDefaultBreakIterator->clone());
-  // TODO: handle failure status
-  if (mText != nullptr) {
+  // The iterator is taken from the pool when text that needs it is set.
+  if (mText != nullptr && !mSimpleText) {
+    UErrorCode status = U_ZERO_ERROR;
     mBreakIterator->setText(&mUText, status);
   }
   mIteratorWasReset = true;
@@ -59,6 +72,15 @@ void WordBreaker::setText(const uint16_t* data, size_t size) {
   mCurrent = 0;
   mScanOffset = 0;
   mInEmailOrUrl = false;
+  mSimpleText = isSimpleText(data, size);
+  if (mSimpleText) {
+    return;
+  }
+  if (!mBreakIterator) {
+    mBreakIterator = BreakIteratorPool::acquire(BreakIteratorPool::Type::kLine,
+                                                icu::Locale());
+  }
+  // TODO: handle failure status
   UErrorCode status = U_ZERO_ERROR;
   utext_openUChars(&mUText, reinterpret_cast<const UChar*>(data), size,
                    &status);
@@ -121,9 +143,26 @@ static bool isBreakValid(const uint16_t* buf, size_t bufEnd, size_t i) {
   return true;
 }
 
+// The break after mCurrent in simple text, which is the end of the next run of
+// spaces that is followed by more text, or the end of the text.
+int32_t WordBreaker::nextSimpleBreak() const {
+  if (mCurrent < 0 || static_cast<size_t>(mCurrent) >= mTextSize) {
+    return icu::BreakIterator::DONE;
+  }
+  size_t i = mCurrent + 1;
+  while (i < mTextSize && !(mText[i - 1] == ' ' && mText[i] != ' ')) {
+    i++;
+  }
+  return i;
+}
+
 // Customized iteratorNext that takes care of both resets and our modifications
 // to ICU's behavior.
 int32_t WordBreaker::iteratorNext() {
+  if (mSimpleText) {
+    mIteratorWasReset = false;
+    return nextSimpleBreak();
+  }
   int32_t result;
   do {
     if (mIteratorWasReset) {
@@ -286,6 +325,7 @@ int WordBreaker::breakBadness() const {
 
 void WordBreaker::finish() {
   mText = nullptr;
+  mBreakIterator.reset();
   // Note: calling utext_close multiply is safe
   utext_close(&mUText);
 }
@@ -24,6 +24,7 @@
 #define MINIKIN_WORD_BREAKER_H
 
 #include <memory>
+#include "minikin/BreakIteratorPool.h"
 #include "unicode/brkiter.h"
 #include "utils/WindowsUtils.h"
 
@@ -33,7 +34,7 @@ class WordBreaker {
  public:
   ~WordBreaker() { finish(); }
 
-  // libtxt extension: always use the default locale so that a cached instance
+  // libtxt extension: always use the default locale so that pooled instances
   // of the ICU break iterator can be reused.
   void setLocale();
 
@@ -54,17 +55,21 @@ class WordBreaker {
 
   int breakBadness() const;
 
+  // Also returns the ICU break iterator to the pool.
   void finish();
 
  private:
   int32_t iteratorNext();
+  int32_t nextSimpleBreak() const;
   void detectEmailOrUrl();
   ssize_t findNextBreakInEmailOrUrl();
 
-  std::unique_ptr<icu::BreakIterator> mBreakIterator;
+  BreakIteratorPool::Iterator mBreakIterator;
   UText mUText = UTEXT_INITIALIZER;
   const uint16_t* mText = nullptr;
   size_t mTextSize;
+  // libtxt extension: whether the text is broken without ICU.
+  bool mSimpleText = false;
   ssize_t mLast;
   ssize_t mCurrent;
   bool mIteratorWasReset;
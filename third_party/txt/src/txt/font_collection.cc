@@ -17,10 +17,13 @@
 #include "font_collection.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -333,6 +336,12 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
 const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  const std::shared_ptr<minikin::FontFamily>& hinted_family =
+      MatchHintedFallbackFont(ch, locale);
+  if (hinted_family) {
+    return hinted_family;
+  }
+
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
     std::vector<const char*> bcp47;
     if (!locale.empty())
@@ -351,11 +360,137 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
                   family_name) == fallback_fonts_for_locale_[locale].end())
       fallback_fonts_for_locale_[locale].push_back(family_name);
 
-    return GetFallbackFontFamily(manager, family_name);
+    const std::shared_ptr<minikin::FontFamily>& family =
+        GetFallbackFontFamily(manager, family_name);
+    if (family) {
+      AddFallbackFontHint(ch, locale, family_name);
+    }
+    return family;
   }
   return g_null_family;
 }
 
+const std::shared_ptr<minikin::FontFamily>&
+FontCollection::MatchHintedFallbackFont(uint32_t ch,
+                                        const std::string& locale) {
+  auto locale_hints = fallback_hints_.find(locale);
+  if (locale_hints == fallback_hints_.end()) {
+    return g_null_family;
+  }
+  auto hint = locale_hints->second.find(ch);
+  if (hint == locale_hints->second.end()) {
+    return g_null_family;
+  }
+  TRACE_EVENT0("flutter", "FontCollection::MatchHintedFallbackFont");
+  const std::string& family_name = fallback_hint_families_[hint->second];
+  for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    const std::shared_ptr<minikin::FontFamily>& family =
+        GetFallbackFontFamily(manager, family_name);
+    // The fonts may have changed since the hint was recorded, so the family
+    // is only used if it still covers the character.
+    if (family && family->getCoverage().get(ch)) {
+      std::vector<std::string>& locale_families =
+          fallback_fonts_for_locale_[locale];
+      if (std::find(locale_families.begin(), locale_families.end(),
+                    family_name) == locale_families.end()) {
+        locale_families.push_back(family_name);
+      }
+      return family;
+    }
+  }
+  locale_hints->second.erase(ch);
+  fallback_hints_changed_ = true;
+  return g_null_family;
+}
+
+void FontCollection::AddFallbackFontHint(uint32_t ch,
+                                         const std::string& locale,
+                                         const std::string& family_name) {
+  const uint32_t family_index = GetFallbackHintFamilyIndex(family_name);
+  auto [hint, added] = fallback_hints_[locale].emplace(ch, family_index);
+  if (added || hint->second != family_index) {
+    hint->second = family_index;
+    fallback_hints_changed_ = true;
+  }
+}
+
+uint32_t FontCollection::GetFallbackHintFamilyIndex(
+    const std::string& family_name) {
+  auto [it, added] = fallback_hint_family_indices_.emplace(
+      family_name, fallback_hint_families_.size());
+  if (added) {
+    fallback_hint_families_.push_back(family_name);
+  }
+  return it->second;
+}
+
+// The hints are stored as one line per locale and family, holding the
+// locale, the family name and the ranges of characters matched to the family
+// as hexadecimal "first-last" pairs, separated by tabs.
+void FontCollection::LoadFallbackFontHints(const std::string& hints) {
+  std::istringstream lines(hints);
+  std::string line;
+  while (std::getline(lines, line)) {
+    size_t locale_end = line.find('\t');
+    if (locale_end == std::string::npos) {
+      continue;
+    }
+    size_t family_end = line.find('\t', locale_end + 1);
+    if (family_end == std::string::npos) {
+      continue;
+    }
+    std::string locale = line.substr(0, locale_end);
+    std::string family_name =
+        line.substr(locale_end + 1, family_end - locale_end - 1);
+    const uint32_t family_index = GetFallbackHintFamilyIndex(family_name);
+    std::unordered_map<uint32_t, uint32_t>& locale_hints =
+        fallback_hints_[locale];
+    std::istringstream ranges(line.substr(family_end + 1));
+    std::string range;
+    while (std::getline(ranges, range, '\t')) {
+      char* end;
+      uint32_t first = std::strtoul(range.c_str(), &end, 16);
+      if (*end != '-') {
+        break;
+      }
+      uint32_t last = std::strtoul(end + 1, &end, 16);
+      if (*end != '\0' || last < first || last > 0x10FFFF ||
+          last - first > 0xFFFF) {
+        break;
+      }
+      for (uint32_t ch = first; ch <= last; ch++) {
+        locale_hints.emplace(ch, family_index);
+      }
+    }
+  }
+}
+
+std::string FontCollection::SerializeFallbackFontHints() {
+  fallback_hints_changed_ = false;
+  std::ostringstream stream;
+  stream << std::hex;
+  for (const auto& [locale, locale_hints] : fallback_hints_) {
+    std::map<std::string, std::vector<uint32_t>> chars_by_family;
+    for (const auto& [ch, family_index] : locale_hints) {
+      chars_by_family[fallback_hint_families_[family_index]].push_back(ch);
+    }
+    for (auto& [family_name, chars] : chars_by_family) {
+      std::sort(chars.begin(), chars.end());
+      stream << locale << '\t' << family_name;
+      for (size_t i = 0; i < chars.size();) {
+        size_t last = i;
+        while (last + 1 < chars.size() && chars[last + 1] == chars[last] + 1) {
+          last++;
+        }
+        stream << '\t' << chars[i] << '-' << chars[last];
+        i = last + 1;
+      }
+      stream << '\n';
+    }
+  }
+  return stream.str();
+}
+
 const std::shared_ptr<minikin::FontFamily>&
 FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
                                       const std::string& family_name) {
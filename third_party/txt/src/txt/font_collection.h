@@ -68,6 +68,19 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Loads fallback font families matched to characters by an earlier run,
+  // as returned by SerializeFallbackFontHints. For a character in the hints,
+  // MatchFallbackFont creates the hinted family by name instead of asking the
+  // font managers to search their fonts for the character.
+  void LoadFallbackFontHints(const std::string& hints);
+
+  // Returns the fallback font families matched to characters so far for each
+  // locale, including the loaded hints.
+  std::string SerializeFallbackFontHints();
+
+  // Whether fallback fonts were matched since the hints were last serialized.
+  bool HasNewFallbackFontHints() const { return fallback_hints_changed_; }
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
@@ -106,6 +119,14 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       fallback_fonts_;
   std::unordered_map<std::string, std::vector<std::string>>
       fallback_fonts_for_locale_;
+  // The fallback font family matched to each character, for each locale, as
+  // an index into fallback_hint_families_.
+  std::unordered_map<std::string, std::unordered_map<uint32_t, uint32_t>>
+      fallback_hints_;
+  // The names of the font families in fallback_hints_, and their indices.
+  std::vector<std::string> fallback_hint_families_;
+  std::unordered_map<std::string, uint32_t> fallback_hint_family_indices_;
+  bool fallback_hints_changed_ = false;
   bool enable_font_fallback_;
 
 #if FLUTTER_ENABLE_SKSHAPER
@@ -137,6 +158,20 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       const sk_sp<SkFontMgr>& manager,
       const std::string& family_name);
 
+  // Creates the family hinted for ch, if it is still available and covers ch.
+  const std::shared_ptr<minikin::FontFamily>& MatchHintedFallbackFont(
+      uint32_t ch,
+      const std::string& locale);
+
+  // Returns the index of family_name in fallback_hint_families_, adding it if
+  // needed.
+  uint32_t GetFallbackHintFamilyIndex(const std::string& family_name);
+
+  // Records that family_name was chosen as the fallback for ch.
+  void AddFallbackFontHint(uint32_t ch,
+                           const std::string& locale,
+                           const std::string& family_name);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
 
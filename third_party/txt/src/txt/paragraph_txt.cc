@@ -30,6 +30,7 @@
 #include "flutter/fml/logging.h"
 #include "font_collection.h"
 #include "font_skia.h"
+#include "minikin/BreakIteratorPool.h"
 #include "minikin/FontLanguageListCache.h"
 #include "minikin/GraphemeBreak.h"
 #include "minikin/HbFontCache.h"
@@ -1984,18 +1985,16 @@ Paragraph::Range<size_t> ParagraphTxt::GetWordBoundary(size_t offset) {
   if (text_.size() == 0)
     return Range<size_t>(0, 0);
 
-  if (!word_breaker_) {
-    UErrorCode status = U_ZERO_ERROR;
-    word_breaker_.reset(
-        icu::BreakIterator::createWordInstance(icu::Locale(), status));
-    if (!U_SUCCESS(status))
-      return Range<size_t>(0, 0);
-  }
+  minikin::BreakIteratorPool::Iterator word_breaker =
+      minikin::BreakIteratorPool::acquire(
+          minikin::BreakIteratorPool::Type::kWord, icu::Locale());
+  if (!word_breaker)
+    return Range<size_t>(0, 0);
 
-  word_breaker_->setText(icu::UnicodeString(false, text_.data(), text_.size()));
+  word_breaker->setText(icu::UnicodeString(false, text_.data(), text_.size()));
 
-  int32_t prev_boundary = word_breaker_->preceding(offset + 1);
-  int32_t next_boundary = word_breaker_->next();
+  int32_t prev_boundary = word_breaker->preceding(offset + 1);
+  int32_t next_boundary = word_breaker->next();
   if (prev_boundary == icu::BreakIterator::DONE)
     prev_boundary = offset;
   if (next_boundary == icu::BreakIterator::DONE)
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <minikin/BreakIteratorPool.h>
+#include <minikin/WordBreaker.h>
+
+namespace minikin {
+
+namespace {
+
+std::vector<ssize_t> getWordBreakerBreaks(const std::u16string& text) {
+  WordBreaker breaker;
+  breaker.setLocale();
+  breaker.setText(reinterpret_cast<const uint16_t*>(text.data()),
+                  text.size());
+  std::vector<ssize_t> breaks;
+  for (ssize_t offset = breaker.next(); offset != icu::BreakIterator::DONE;
+       offset = breaker.next()) {
+    breaks.push_back(offset);
+  }
+  breaker.finish();
+  return breaks;
+}
+
+std::vector<ssize_t> getIcuBreaks(const std::u16string& text) {
+  UErrorCode status = U_ZERO_ERROR;
+  std::unique_ptr<icu::BreakIterator> iterator(
+      icu::BreakIterator::createLineInstance(icu::Locale(), status));
+  EXPECT_TRUE(U_SUCCESS(status));
+  icu::UnicodeString string(false, text.data(), text.size());
+  iterator->setText(string);
+  std::vector<ssize_t> breaks;
+  iterator->first();
+  for (int32_t offset = iterator->next(); offset != icu::BreakIterator::DONE;
+       offset = iterator->next()) {
+    breaks.push_back(offset);
+  }
+  return breaks;
+}
+
+}  // namespace
+
+TEST(BreakIteratorPool, reusesReleasedIterators) {
+  const size_t pooled = BreakIteratorPool::getPooledCount();
+  BreakIteratorPool::Iterator line = BreakIteratorPool::acquire(
+      BreakIteratorPool::Type::kLine, icu::Locale::getUS());
+  ASSERT_TRUE(line);
+  icu::BreakIterator* released = line.get();
+  line.reset();
+  EXPECT_EQ(pooled + 1, BreakIteratorPool::getPooledCount());
+
+  // Iterators of another type or locale are not reused.
+  BreakIteratorPool::Iterator word = BreakIteratorPool::acquire(
+      BreakIteratorPool::Type::kWord, icu::Locale::getUS());
+  ASSERT_TRUE(word);
+  EXPECT_NE(released, word.get());
+  BreakIteratorPool::Iterator french = BreakIteratorPool::acquire(
+      BreakIteratorPool::Type::kLine, icu::Locale::getFrench());
+  ASSERT_TRUE(french);
+  EXPECT_NE(released, french.get());
+
+  line = BreakIteratorPool::acquire(BreakIteratorPool::Type::kLine,
+                                    icu::Locale::getUS());
+  EXPECT_EQ(released, line.get());
+}
+
+TEST(BreakIteratorPool, limitsPooledIterators) {
+  std::vector<BreakIteratorPool::Iterator> iterators;
+  for (size_t i = 0; i < BreakIteratorPool::kMaxPooledPerKey + 2; i++) {
+    iterators.push_back(BreakIteratorPool::acquire(
+        BreakIteratorPool::Type::kWord, icu::Locale::getGerman()));
+    ASSERT_TRUE(iterators.back());
+  }
+  const size_t pooled = BreakIteratorPool::getPooledCount();
+  iterators.clear();
+  EXPECT_EQ(pooled + BreakIteratorPool::kMaxPooledPerKey,
+            BreakIteratorPool::getPooledCount());
+}
+
+TEST(BreakIteratorPool, wordBreakerReleasesIterator) {
+  const std::u16string text = u"hello, world";
+  WordBreaker breaker;
+  breaker.setLocale();
+  breaker.setText(reinterpret_cast<const uint16_t*>(text.data()),
+                  text.size());
+  const size_t pooled = BreakIteratorPool::getPooledCount();
+  breaker.finish();
+  EXPECT_EQ(pooled + 1, BreakIteratorPool::getPooledCount());
+}
+
+TEST(BreakIteratorPool, simpleTextBreaksMatchIcu) {
+  const std::u16string texts[] = {
+      u"",           u"a",           u"hello world", u"  leading",
+      u"trailing  ", u"a  b 12 c3 ", u"  ",          u"x y z",
+      // These are broken by ICU.
+      u"hello, world", u"sugar-free",
+  };
+  for (const std::u16string& text : texts) {
+    EXPECT_EQ(getIcuBreaks(text), getWordBreakerBreaks(text))
+        << std::string(text.begin(), text.end());
+  }
+}
+
+}  // namespace minikin
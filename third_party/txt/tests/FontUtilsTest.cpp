@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <minikin/FontUtils.h>
+
+namespace minikin {
+
+namespace {
+
+void appendU16(std::vector<uint8_t>* out, uint16_t x) {
+  out->push_back(x >> 8);
+  out->push_back(x);
+}
+
+void setU16(std::vector<uint8_t>* out, size_t offset, uint16_t x) {
+  (*out)[offset] = x >> 8;
+  (*out)[offset + 1] = x;
+}
+
+// Returns a GPOS table with only a LookupList, holding lookups of the given
+// types with one empty subtable each. Lookups of type 9 wrap a lookup of type
+// extensionType.
+std::vector<uint8_t> buildGposTable(const std::vector<uint16_t>& types,
+                                    uint16_t extensionType) {
+  const size_t kLookupListOffset = 10;
+  std::vector<uint8_t> out;
+  appendU16(&out, 1);  // majorVersion
+  appendU16(&out, 0);  // minorVersion
+  appendU16(&out, 0);  // scriptListOffset
+  appendU16(&out, 0);  // featureListOffset
+  appendU16(&out, kLookupListOffset);
+
+  appendU16(&out, types.size());  // lookupCount
+  const size_t lookupOffsets = out.size();
+  out.resize(out.size() + types.size() * 2);
+  for (size_t i = 0; i < types.size(); ++i) {
+    const size_t lookupOffset = out.size();
+    setU16(&out, lookupOffsets + i * 2, lookupOffset - kLookupListOffset);
+    appendU16(&out, types[i]);  // lookupType
+    appendU16(&out, 0);         // lookupFlag
+    appendU16(&out, 1);         // subTableCount
+    appendU16(&out, 8);         // subtableOffsets[0]
+    if (types[i] == 9) {
+      appendU16(&out, 1);              // posFormat
+      appendU16(&out, extensionType);  // extensionLookupType
+      appendU16(&out, 0);              // extensionOffset
+      appendU16(&out, 0);
+    } else {
+      appendU16(&out, 1);  // posFormat
+      appendU16(&out, 0);
+      appendU16(&out, 0);
+      appendU16(&out, 0);
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(FontUtilsTest, analyzeGposLookupTypes) {
+  std::vector<uint16_t> types;
+  std::vector<uint8_t> gpos = buildGposTable({2, 4, 9}, 2);
+  analyzeGposLookupTypes(gpos.data(), gpos.size(), &types);
+  EXPECT_EQ((std::vector<uint16_t>{2, 4, 2}), types);
+
+  gpos = buildGposTable({9, 1}, 8);
+  analyzeGposLookupTypes(gpos.data(), gpos.size(), &types);
+  EXPECT_EQ((std::vector<uint16_t>{8, 1}), types);
+}
+
+TEST(FontUtilsTest, analyzeGposLookupTypes_invalidTables) {
+  std::vector<uint16_t> types = {1};
+  analyzeGposLookupTypes(nullptr, 0, &types);
+  EXPECT_TRUE(types.empty());
+
+  // The last lookup is cut off.
+  std::vector<uint8_t> gpos = buildGposTable({2, 3}, 0);
+  gpos.resize(gpos.size() - 10);
+  analyzeGposLookupTypes(gpos.data(), gpos.size(), &types);
+  EXPECT_EQ((std::vector<uint16_t>{2, 0}), types);
+
+  // The lookup count runs past the end of the table.
+  gpos = buildGposTable({2}, 0);
+  setU16(&gpos, 10, 100);
+  analyzeGposLookupTypes(gpos.data(), gpos.size(), &types);
+  EXPECT_TRUE(types.empty());
+}
+
+}  // namespace minikin
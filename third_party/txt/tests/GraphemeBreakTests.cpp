@@ -372,4 +372,15 @@ TEST(GraphemeBreak, offsets) {
   EXPECT_TRUE(GraphemeBreak::isGraphemeBreak(nullptr, string, 2, 3, 5));
 }
 
+TEST(GraphemeBreak, ascii) {
+  EXPECT_TRUE(IsBreak("'a' | 'b'"));
+  EXPECT_TRUE(IsBreak("' ' | '~'"));
+  EXPECT_TRUE(IsBreak("U+0009 | 'a'"));     // tab
+  EXPECT_FALSE(IsBreak("U+000D | U+000A"));  // CR x LF
+  EXPECT_TRUE(IsBreak("U+000A | U+000D"));
+  // The characters after an ASCII character still decide.
+  EXPECT_FALSE(IsBreak("'e' | U+0301"));  // combining acute accent
+  EXPECT_FALSE(IsBreak("'a' | U+200D"));  // ZWJ
+}
+
 }  // namespace minikin
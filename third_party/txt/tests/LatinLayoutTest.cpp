@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "minikin/HbFontCache.h"
+#include "minikin/LatinGlyphCache.h"
+#include "minikin/Layout.h"
+#include "minikin/MinikinInternal.h"
+#include "txt_test_utils.h"
+
+namespace minikin {
+
+namespace {
+
+std::shared_ptr<FontCollection> getRobotoCollection() {
+  return txt::GetTestFontCollection()->GetMinikinFontCollectionForFamilies(
+      {"Roboto"}, "en-US");
+}
+
+// Lays text out through the Latin-1 fast path if shaped is false. Otherwise a
+// feature setting that changes nothing is added, which sends every run to
+// HarfBuzz.
+void doLayout(const std::u16string& text,
+              MinikinPaint paint,
+              bool shaped,
+              Layout* layout) {
+  if (shaped) {
+    paint.fontFeatureSettings = "kern";
+  }
+  layout->doLayout(reinterpret_cast<const uint16_t*>(text.data()), 0,
+                   text.size(), text.size(), false, FontStyle(), paint,
+                   getRobotoCollection());
+}
+
+void expectSameLayout(const std::u16string& text, const MinikinPaint& paint) {
+  SCOPED_TRACE(std::string(text.begin(), text.end()));
+  Layout fast;
+  doLayout(text, paint, false, &fast);
+  Layout shaped;
+  doLayout(text, paint, true, &shaped);
+
+  ASSERT_EQ(shaped.nGlyphs(), fast.nGlyphs());
+  for (size_t i = 0; i < fast.nGlyphs(); i++) {
+    EXPECT_EQ(shaped.getFont(i), fast.getFont(i));
+    EXPECT_EQ(shaped.getGlyphId(i), fast.getGlyphId(i));
+    EXPECT_FLOAT_EQ(shaped.getX(i), fast.getX(i));
+    EXPECT_FLOAT_EQ(shaped.getY(i), fast.getY(i));
+  }
+
+  std::vector<float> fastAdvances(text.size());
+  fast.getAdvances(fastAdvances.data());
+  std::vector<float> shapedAdvances(text.size());
+  shaped.getAdvances(shapedAdvances.data());
+  for (size_t i = 0; i < text.size(); i++) {
+    EXPECT_FLOAT_EQ(shapedAdvances[i], fastAdvances[i]);
+  }
+  EXPECT_FLOAT_EQ(shaped.getAdvance(), fast.getAdvance());
+
+  MinikinRect fastBounds;
+  fast.getBounds(&fastBounds);
+  MinikinRect shapedBounds;
+  shaped.getBounds(&shapedBounds);
+  EXPECT_FLOAT_EQ(shapedBounds.mLeft, fastBounds.mLeft);
+  EXPECT_FLOAT_EQ(shapedBounds.mTop, fastBounds.mTop);
+  EXPECT_FLOAT_EQ(shapedBounds.mRight, fastBounds.mRight);
+  EXPECT_FLOAT_EQ(shapedBounds.mBottom, fastBounds.mBottom);
+}
+
+const std::u16string kTexts[] = {
+    u"Hello, World!",
+    u"AVATAR Wave To Yesterday",
+    u"The quick brown fox jumps over the lazy dog.",
+    u"0123 456.78 (9) [10] {11} $12 #13",
+    u"café naïve Ångström Øre groß",
+    // Ligatures in these send part of the text to HarfBuzz anyway.
+    u"office afflict fjord",
+    u"  leading and trailing spaces  ",
+};
+
+}  // namespace
+
+// The comparisons below only mean something if the fast path is taken.
+TEST(LatinLayoutTest, robotoTakesFastPath) {
+  MinikinPaint paint;
+  paint.size = 14;
+  paint.scaleX = 1;
+  Layout layout;
+  doLayout(u"a", paint, false, &layout);
+  ASSERT_EQ(1u, layout.nGlyphs());
+
+  paint.font = layout.getFont(0);
+  std::scoped_lock _l(gMinikinLock);
+  hb_font_t* hbFont = getHbFontLocked(paint.font);
+  LatinGlyphs* glyphs =
+      getLatinGlyphsLocked(hbFont, paint, HB_SCRIPT_LATIN, HB_LANGUAGE_INVALID);
+  hb_font_destroy(hbFont);
+  ASSERT_NE(nullptr, glyphs);
+  EXPECT_EQ(layout.getGlyphId(0), glyphs->getGlyph('a'));
+}
+
+TEST(LatinLayoutTest, matchesShapedLayout) {
+  for (float size : {10.0f, 14.0f, 17.5f, 48.0f}) {
+    MinikinPaint paint;
+    paint.size = size;
+    paint.scaleX = 1;
+    for (const std::u16string& text : kTexts) {
+      expectSameLayout(text, paint);
+    }
+  }
+}
+
+TEST(LatinLayoutTest, matchesShapedLayoutWithLinearText) {
+  MinikinPaint paint;
+  paint.size = 17.5;
+  paint.scaleX = 1;
+  paint.paintFlags = LinearTextFlag;
+  for (const std::u16string& text : kTexts) {
+    expectSameLayout(text, paint);
+  }
+}
+
+TEST(LatinLayoutTest, matchesShapedLayoutWithLetterSpacing) {
+  for (uint32_t flags : {0u, static_cast<uint32_t>(LinearTextFlag)}) {
+    for (float letterSpacing : {0.05f, 0.13f, -0.02f}) {
+      MinikinPaint paint;
+      paint.size = 15;
+      paint.scaleX = 1;
+      paint.paintFlags = flags;
+      paint.letterSpacing = letterSpacing;
+      for (const std::u16string& text : kTexts) {
+        expectSameLayout(text, paint);
+      }
+    }
+  }
+}
+
+TEST(LatinLayoutTest, matchesShapedLayoutWithScaleAndSkew) {
+  MinikinPaint paint;
+  paint.size = 16;
+  paint.scaleX = 1.25;
+  paint.skewX = -0.25;
+  for (const std::u16string& text : kTexts) {
+    expectSameLayout(text, paint);
+  }
+}
+
+}  // namespace minikin
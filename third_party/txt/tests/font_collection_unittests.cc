@@ -138,6 +138,37 @@ TEST(FontCollectionTest, CheckSkTypefacesSorting) {
             SkFontStyle::kExpanded_Width);
 }
 
+TEST(FontCollectionTest, RoundTripsFallbackFontHints) {
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  const std::string hints = "ja\tNoto Sans JP\t4e00-4e02\t4e05-4e05\n";
+  font_collection->LoadFallbackFontHints(hints);
+  ASSERT_FALSE(font_collection->HasNewFallbackFontHints());
+  ASSERT_EQ(font_collection->SerializeFallbackFontHints(), hints);
+}
+
+TEST(FontCollectionTest, IgnoresMalformedFallbackFontHints) {
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  font_collection->LoadFallbackFontHints(
+      "ja\n"
+      "ja\tNoto Sans JP\tnot a range\n"
+      "ja\tNoto Sans JP\t4e02-4e00\n"
+      "ja\tNoto Sans JP\t0-10ffff\n"
+      "ko\tNoto Sans KR\tac00-ac00\n");
+  ASSERT_EQ(font_collection->SerializeFallbackFontHints(),
+            "ko\tNoto Sans KR\tac00-ac00\n");
+}
+
+TEST(FontCollectionTest, DropsHintsForMissingFallbackFonts) {
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  font_collection->LoadFallbackFontHints("ja\tNoto Sans JP\t4e00-4e01\n");
+  // No font manager provides the hinted family.
+  ASSERT_FALSE(font_collection->MatchFallbackFont(0x4e00, "ja"));
+  ASSERT_TRUE(font_collection->HasNewFallbackFontHints());
+  ASSERT_EQ(font_collection->SerializeFallbackFontHints(),
+            "ja\tNoto Sans JP\t4e01-4e01\n");
+  ASSERT_FALSE(font_collection->HasNewFallbackFontHints());
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {